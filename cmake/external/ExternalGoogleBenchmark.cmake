@@ -0,0 +1,25 @@
+include(FetchContent)
+
+# only the benchmark library itself is needed
+set(BENCHMARK_ENABLE_TESTING OFF)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF)
+set(BENCHMARK_ENABLE_INSTALL OFF)
+set(BENCHMARK_INSTALL_DOCS OFF)
+
+FetchContent_Declare(
+        benchmark
+        SYSTEM
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        GIT_TAG v1.9.1
+)
+
+FetchContent_MakeAvailable(benchmark)
+
+set_property(DIRECTORY ${benchmark_SOURCE_DIR} PROPERTY EXCLUDE_FROM_ALL ON)
+
+mark_as_advanced(
+        BENCHMARK_ENABLE_TESTING
+        BENCHMARK_ENABLE_GTEST_TESTS
+        BENCHMARK_ENABLE_INSTALL
+        BENCHMARK_INSTALL_DOCS
+)
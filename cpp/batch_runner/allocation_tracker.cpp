@@ -0,0 +1,59 @@
+#include "allocation_tracker.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+using namespace knowledge_extraction::batch_runner;
+
+namespace {
+// Every block starts with its size, the header keeps the returned pointer aligned for all fundamental types
+constexpr size_t header_size = alignof(std::max_align_t);
+
+// Constant initialized, so that it can be used while threads are started or destroyed
+struct ThreadCounters {
+    bool active;
+    int64_t num_allocations;
+    int64_t current_bytes;
+    int64_t peak_bytes;
+};
+
+constinit thread_local ThreadCounters counters{false, 0, 0, 0};
+} // namespace
+
+void knowledge_extraction::batch_runner::start_allocation_tracking() { counters = {true, 0, 0, 0}; }
+
+AllocationStatistics knowledge_extraction::batch_runner::stop_allocation_tracking() {
+    counters.active = false;
+    return {counters.num_allocations, counters.peak_bytes};
+}
+
+// The array, sized and nothrow versions forward to these by default
+void *operator new(size_t size) {
+    auto *block = static_cast<std::byte *>(std::malloc(size + header_size));
+    if (block == nullptr) {
+        throw std::bad_alloc{};
+    }
+    *reinterpret_cast<size_t *>(block) = size;
+    if (counters.active) {
+        ++counters.num_allocations;
+        counters.current_bytes += static_cast<int64_t>(size);
+        if (counters.current_bytes > counters.peak_bytes) {
+            counters.peak_bytes = counters.current_bytes;
+        }
+    }
+    return block + header_size;
+}
+
+void operator delete(void *ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    auto *block = static_cast<std::byte *>(ptr) - header_size;
+    if (counters.active) {
+        counters.current_bytes -= static_cast<int64_t>(*reinterpret_cast<size_t *>(block));
+    }
+    std::free(block);
+}
+
+void operator delete(void *ptr, size_t /*size*/) noexcept { operator delete(ptr); }
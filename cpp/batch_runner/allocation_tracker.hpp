@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace knowledge_extraction::batch_runner {
+/**
+ * Heap usage of the current thread between start_allocation_tracking() and stop_allocation_tracking().
+ */
+struct AllocationStatistics {
+    int64_t num_allocations{0};
+    // Peak of the bytes that were allocated and not yet freed, relative to the start
+    int64_t peak_bytes{0};
+};
+
+/**
+ * Start counting the heap allocations of the current thread via the global operator new.
+ *
+ * Each scenario is processed on a single thread, so the counters of that thread cover exactly one scenario. Memory
+ * freed on another thread is not subtracted, which can only overestimate the peak.
+ */
+void start_allocation_tracking();
+
+/**
+ * Stop counting the heap allocations of the current thread.
+ *
+ * @return The heap usage since the last call to start_allocation_tracking() on this thread.
+ */
+AllocationStatistics stop_allocation_tracking();
+} // namespace knowledge_extraction::batch_runner
@@ -0,0 +1,285 @@
+#include "batch_runner.hpp"
+
+#include "allocation_tracker.hpp"
+
+#include "cr_knowledge_extraction/env_model/cache_file.hpp"
+#include "cr_knowledge_extraction/extraction_interface.hpp"
+#include "cr_knowledge_extraction/parallel/work_stealing_pool.hpp"
+#include "cr_knowledge_extraction/relevant_propositions.hpp"
+
+#include <commonroad_cpp/interfaces/commonroad/input_utils.h>
+#include <commonroad_cpp/obstacle/obstacle.h>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+using namespace knowledge_extraction::batch_runner;
+using knowledge_extraction::ExtractionInterface;
+using knowledge_extraction::Proposition;
+using knowledge_extraction::ego_behavior::EgoParameters;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Half length of the straight reference path through the initial position of the ego vehicle
+constexpr double reference_path_half_length = 250;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>{Clock::now() - start}.count();
+}
+
+/**
+ * Read the initial state of the first planning problem.
+ *
+ * Only the planning problem is parsed, the rest of the scenario is read by the CommonRoad reader.
+ */
+State read_initial_state(const std::filesystem::path &path) {
+    std::ifstream file{path};
+    std::string content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    constexpr std::string_view end_tag = "</planningProblem>";
+    auto begin = content.find("<planningProblem");
+    auto end = content.find(end_tag, begin);
+    if (begin == std::string::npos || end == std::string::npos) {
+        throw std::runtime_error("The scenario has no planning problem");
+    }
+    std::istringstream problem{content.substr(begin, end + end_tag.size() - begin)};
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_xml(problem, tree);
+
+    const auto &initial_state = tree.get_child("planningProblem.initialState");
+    return State{initial_state.get<time_step_t>("time.exact"),
+                 initial_state.get<double>("position.point.x"),
+                 initial_state.get<double>("position.point.y"),
+                 initial_state.get<double>("velocity.exact"),
+                 initial_state.get<double>("acceleration.exact", 0.0),
+                 initial_state.get<double>("orientation.exact")};
+}
+
+// Cache files are named by the content hash, so renamed copies of a scenario share their cache
+std::filesystem::path get_cache_path(const std::filesystem::path &cache_dir, uint64_t scenario_hash) {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << scenario_hash << ".bin";
+    return cache_dir / name.str();
+}
+
+// Quote fields that contain separators, quotes or line breaks
+std::string csv_field(const std::string &str) {
+    if (str.find_first_of(",\"\n\r") == std::string::npos) {
+        return str;
+    }
+    std::string quoted = "\"";
+    for (auto c : str) {
+        quoted += c;
+        if (c == '"') {
+            quoted += '"';
+        }
+    }
+    return quoted + '"';
+}
+
+void write_escaped(std::ostream &out, const std::string &str) {
+    out << '"';
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (c == '\n') {
+            out << "\\n";
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+} // namespace
+
+std::vector<Proposition> knowledge_extraction::batch_runner::get_default_propositions() {
+    return {
+        Proposition::ON_MAIN_CARRIAGEWAY,
+        Proposition::IN_INTERSECTION,
+        Proposition::ON_MAIN_CARRIAGEWAY_RIGHT_LANE,
+        Proposition::ON_MAIN_CARRIAGEWAY_LEFT_LANE,
+        Proposition::IN_FRONT_OF,
+        Proposition::IN_SAME_LANE,
+        Proposition::CUT_IN,
+        Proposition::KEEPS_SAFE_DISTANCE_PREC,
+        Proposition::OTHER_ON_ACCESS_RAMP,
+        Proposition::OTHER_ON_MAIN_CARRIAGEWAY,
+        Proposition::RELEVANT_TRAFFIC_LIGHT,
+        Proposition::AT_STOP_SIGN,
+        Proposition::ON_INCOMING_LEFT_OF,
+        Proposition::IN_INTERSECTION_CONFLICT_AREA,
+        Proposition::OTHER_TURNING_LEFT,
+        Proposition::OTHER_GOING_STRAIGHT,
+        Proposition::OTHER_TURNING_RIGHT,
+        Proposition::SAME_LEFT_LEFT_PRIORITY,
+        Proposition::SAME_LEFT_STRAIGHT_PRIORITY,
+        Proposition::SAME_LEFT_RIGHT_PRIORITY,
+        Proposition::SAME_STRAIGHT_LEFT_PRIORITY,
+        Proposition::SAME_STRAIGHT_STRAIGHT_PRIORITY,
+        Proposition::SAME_STRAIGHT_RIGHT_PRIORITY,
+        Proposition::SAME_RIGHT_LEFT_PRIORITY,
+        Proposition::SAME_RIGHT_STRAIGHT_PRIORITY,
+        Proposition::SAME_RIGHT_RIGHT_PRIORITY,
+        Proposition::HAS_LEFT_LEFT_PRIORITY,
+        Proposition::HAS_LEFT_STRAIGHT_PRIORITY,
+        Proposition::HAS_LEFT_RIGHT_PRIORITY,
+        Proposition::HAS_STRAIGHT_LEFT_PRIORITY,
+        Proposition::HAS_STRAIGHT_STRAIGHT_PRIORITY,
+        Proposition::HAS_STRAIGHT_RIGHT_PRIORITY,
+        Proposition::HAS_RIGHT_LEFT_PRIORITY,
+        Proposition::HAS_RIGHT_STRAIGHT_PRIORITY,
+        Proposition::HAS_RIGHT_RIGHT_PRIORITY,
+        Proposition::OTHER_HAS_LEFT_LEFT_PRIORITY,
+        Proposition::OTHER_HAS_LEFT_STRAIGHT_PRIORITY,
+        Proposition::OTHER_HAS_LEFT_RIGHT_PRIORITY,
+        Proposition::OTHER_HAS_STRAIGHT_LEFT_PRIORITY,
+        Proposition::OTHER_HAS_STRAIGHT_STRAIGHT_PRIORITY,
+        Proposition::OTHER_HAS_STRAIGHT_RIGHT_PRIORITY,
+        Proposition::OTHER_HAS_RIGHT_LEFT_PRIORITY,
+        Proposition::OTHER_HAS_RIGHT_STRAIGHT_PRIORITY,
+        Proposition::OTHER_HAS_RIGHT_RIGHT_PRIORITY,
+    };
+}
+
+std::vector<std::filesystem::path>
+knowledge_extraction::batch_runner::collect_scenarios(const std::vector<std::string> &inputs) {
+    std::vector<std::filesystem::path> paths;
+    for (const auto &input : inputs) {
+        if (std::filesystem::is_directory(input)) {
+            for (const auto &entry : std::filesystem::recursive_directory_iterator{input}) {
+                if (entry.is_regular_file() && entry.path().extension() == ".xml") {
+                    paths.push_back(entry.path());
+                }
+            }
+        } else if (std::filesystem::is_regular_file(input)) {
+            paths.emplace_back(input);
+        } else {
+            throw std::invalid_argument("Scenario file or directory does not exist: " + input);
+        }
+    }
+    std::ranges::sort(paths);
+    return paths;
+}
+
+ScenarioReport knowledge_extraction::batch_runner::run_scenario(const std::filesystem::path &path,
+                                                                const BatchOptions &options) {
+    ScenarioReport report;
+    report.path = path.string();
+    start_allocation_tracking();
+    try {
+        auto start = Clock::now();
+        auto scenario = InputUtils::getDataFromCommonRoad(path.string());
+        auto world =
+            std::make_shared<World>(path.stem().string(), 0, scenario.roadNetwork,
+                                    std::vector<std::shared_ptr<Obstacle>>{}, scenario.obstacles, scenario.timeStepSize);
+        EgoParameters ego_params;
+        ego_params.initial_state = read_initial_state(path);
+        report.load_time = seconds_since(start);
+        report.num_obstacles = world->getObstacles().size();
+        report.num_lanelets = world->getRoadNetwork()->getLaneletNetwork().size();
+
+        start = Clock::now();
+        const auto &initial_state = ego_params.initial_state;
+        Eigen::Vector2d position{initial_state.getXPosition(), initial_state.getYPosition()};
+        Eigen::Vector2d direction{std::cos(initial_state.getGlobalOrientation()),
+                                  std::sin(initial_state.getGlobalOrientation())};
+        geometry::EigenPolyline reference_path{position - (reference_path_half_length * direction), position,
+                                               position + (reference_path_half_length * direction)};
+        auto ccs = std::make_shared<geometry::CurvilinearCoordinateSystem>(reference_path, 100);
+        ExtractionInterface extraction_interface{world, ccs, ego_params};
+        const auto &world_cache = extraction_interface.get_env_model()->get_world_cache();
+        std::optional<std::pair<std::filesystem::path, uint64_t>> cache_file;
+        if (options.cache_dir.has_value()) {
+            auto scenario_hash = knowledge_extraction::env_model::hash_file(path);
+            cache_file.emplace(get_cache_path(options.cache_dir.value(), scenario_hash), scenario_hash);
+            report.world_cache_loaded = world_cache->load(cache_file->first, scenario_hash);
+        }
+        report.setup_time = seconds_since(start);
+
+        auto relevant_propositions = knowledge_extraction::make_relevant_propositions(
+            *world, options.propositions, initial_state.getTimeStep(), options.horizon);
+        for (const auto &[time_step, propositions] : relevant_propositions) {
+            report.num_relevant_propositions += propositions.size();
+        }
+
+        start = Clock::now();
+        auto result = extraction_interface.extract_all(relevant_propositions);
+        report.extraction_time = seconds_since(start);
+        for (const auto &[time_step, time_step_result] : result) {
+            report.num_atoms += time_step_result.positive_propositions.size() +
+                                time_step_result.negative_propositions.size() +
+                                time_step_result.implications.size() + time_step_result.equivalences.size();
+        }
+        if (cache_file.has_value()) {
+            world_cache->save(cache_file->first, cache_file->second);
+        }
+        report.success = true;
+    } catch (const std::exception &e) {
+        report.error = e.what();
+    }
+    auto allocations = stop_allocation_tracking();
+    report.num_allocations = allocations.num_allocations;
+    report.peak_heap_bytes = allocations.peak_bytes;
+    return report;
+}
+
+std::vector<ScenarioReport> knowledge_extraction::batch_runner::run_batch(const std::vector<std::filesystem::path> &paths,
+                                                                          const BatchOptions &options) {
+    std::vector<ScenarioReport> reports(paths.size());
+    std::vector<parallel::WorkStealingPool::Task> tasks;
+    tasks.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        tasks.emplace_back([&reports, &paths, &options, i]() { reports[i] = run_scenario(paths[i], options); });
+    }
+    // Scenarios are independent, so they are distributed over the threads instead of parallelizing each extraction
+    auto num_threads = options.num_threads;
+    if (num_threads == 0) {
+        num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    parallel::WorkStealingPool pool{std::clamp<size_t>(paths.size(), 1, num_threads)};
+    pool.run(std::move(tasks));
+    return reports;
+}
+
+void knowledge_extraction::batch_runner::write_csv(const std::vector<ScenarioReport> &reports, std::ostream &out) {
+    out << "path,success,error,num_obstacles,num_lanelets,num_relevant_propositions,num_atoms,world_cache_loaded,"
+           "load_time,setup_time,extraction_time,num_allocations,peak_heap_bytes\n";
+    for (const auto &report : reports) {
+        out << csv_field(report.path) << ',' << (report.success ? "true" : "false") << ',' << csv_field(report.error)
+            << ',' << report.num_obstacles << ',' << report.num_lanelets << ',' << report.num_relevant_propositions
+            << ',' << report.num_atoms << ',' << (report.world_cache_loaded ? "true" : "false") << ','
+            << report.load_time << ',' << report.setup_time << ',' << report.extraction_time << ','
+            << report.num_allocations << ',' << report.peak_heap_bytes << '\n';
+    }
+}
+
+void knowledge_extraction::batch_runner::write_json(const std::vector<ScenarioReport> &reports, std::ostream &out) {
+    out << "[";
+    for (size_t i = 0; i < reports.size(); ++i) {
+        const auto &report = reports[i];
+        out << (i == 0 ? "\n" : ",\n") << R"(  {"path":)";
+        write_escaped(out, report.path);
+        out << R"(,"success":)" << (report.success ? "true" : "false") << R"(,"error":)";
+        write_escaped(out, report.error);
+        out << R"(,"num_obstacles":)" << report.num_obstacles << R"(,"num_lanelets":)" << report.num_lanelets
+            << R"(,"num_relevant_propositions":)" << report.num_relevant_propositions << R"(,"num_atoms":)"
+            << report.num_atoms << R"(,"world_cache_loaded":)" << (report.world_cache_loaded ? "true" : "false")
+            << R"(,"load_time":)" << report.load_time << R"(,"setup_time":)" << report.setup_time
+            << R"(,"extraction_time":)" << report.extraction_time << R"(,"num_allocations":)"
+            << report.num_allocations << R"(,"peak_heap_bytes":)" << report.peak_heap_bytes << '}';
+    }
+    out << "\n]\n";
+}
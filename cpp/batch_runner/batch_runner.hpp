@@ -0,0 +1,108 @@
+#pragma once
+
+#include "cr_knowledge_extraction/proposition.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace knowledge_extraction::batch_runner {
+struct BatchOptions {
+    // The propositions that are instantiated for the ego vehicle and every obstacle at every time step
+    std::vector<Proposition> propositions;
+    // Number of time steps starting at the initial time step of the planning problem
+    time_step_t horizon{20};
+    // Number of scenarios processed in parallel, with 0, one per hardware core
+    size_t num_threads{0};
+    // Directory of the world cache files, which keep ego-independent results across runs, without caching if empty
+    std::optional<std::filesystem::path> cache_dir;
+};
+
+/**
+ * The outcome of extracting knowledge for a single scenario, all durations in s.
+ */
+struct ScenarioReport {
+    std::string path;
+    bool success{false};
+    // Reason of the failure, empty on success
+    std::string error;
+
+    size_t num_obstacles{0};
+    size_t num_lanelets{0};
+    size_t num_relevant_propositions{0};
+    // Number of extracted atoms, i.e., positive and negative propositions, implications and equivalences
+    size_t num_atoms{0};
+    // Whether ego-independent results were loaded from the world cache file of an earlier run
+    bool world_cache_loaded{false};
+
+    double load_time{0};
+    // Creating the extraction interface, which projects the road network and obstacles into the CCS
+    double setup_time{0};
+    double extraction_time{0};
+
+    int64_t num_allocations{0};
+    int64_t peak_heap_bytes{0};
+};
+
+/**
+ * Get all propositions for which the extraction interface creates an extractor.
+ *
+ * @return The propositions.
+ */
+std::vector<Proposition> get_default_propositions();
+
+/**
+ * Collect the scenario files from files and directories.
+ *
+ * Directories are searched recursively for XML files, the result is sorted so that reports are comparable between
+ * runs.
+ *
+ * @param inputs Paths to scenario files or directories.
+ * @return The paths of all scenario files.
+ * @throws std::invalid_argument If an input does not exist.
+ */
+std::vector<std::filesystem::path> collect_scenarios(const std::vector<std::string> &inputs);
+
+/**
+ * Load a scenario and extract all knowledge for the ego vehicle of its first planning problem.
+ *
+ * The CCS is a straight reference path along the initial orientation of the ego vehicle. Errors are reported in the
+ * result instead of being thrown, so that a single broken scenario does not abort a batch. With a cache directory, the
+ * world cache file of the scenario is loaded before and saved after the extraction.
+ *
+ * @param path The path of the CommonRoad XML file.
+ * @param options The propositions, horizon and cache directory.
+ * @return The report of the scenario.
+ */
+ScenarioReport run_scenario(const std::filesystem::path &path, const BatchOptions &options);
+
+/**
+ * Process scenarios in parallel, each scenario is processed on a single thread.
+ *
+ * @param paths The paths of the CommonRoad XML files.
+ * @param options The propositions, horizon and number of threads.
+ * @return The reports in the same order as the paths.
+ */
+std::vector<ScenarioReport> run_batch(const std::vector<std::filesystem::path> &paths, const BatchOptions &options);
+
+/**
+ * Write reports as CSV with a header line.
+ *
+ * @param reports The reports.
+ * @param out The output stream.
+ */
+void write_csv(const std::vector<ScenarioReport> &reports, std::ostream &out);
+
+/**
+ * Write reports as a JSON array of objects.
+ *
+ * @param reports The reports.
+ * @param out The output stream.
+ */
+void write_json(const std::vector<ScenarioReport> &reports, std::ostream &out);
+} // namespace knowledge_extraction::batch_runner
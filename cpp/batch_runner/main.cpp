@@ -0,0 +1,134 @@
+#include "batch_runner.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace knowledge_extraction::batch_runner;
+
+namespace {
+constexpr auto usage = R"(Usage: cr_knowledge_extraction_batch [options] <scenario file or directory>...
+
+Extracts knowledge for the first planning problem of every CommonRoad scenario and reports timings, heap usage and
+the number of extracted atoms per scenario.
+
+Options:
+  --propositions <names>  Comma separated propositions without parameter, e.g. InFrontOf,OnMainCarriageway
+                          (default: all propositions with an extractor)
+  --horizon <steps>       Number of time steps starting at the initial time step (default: 20)
+  --threads <count>       Number of scenarios processed in parallel, 0 for one per core (default: 0)
+  --cache-dir <dir>       Load and save ego-independent results of each scenario in this directory, so that later
+                          runs on the same scenarios skip their computation
+  --csv <file>            Write the reports as CSV
+  --json <file>           Write the reports as JSON
+  --help                  Show this message
+)";
+
+size_t parse_count(const std::string &option, const std::string &value) {
+    size_t count = 0;
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+    if (error != std::errc{} || end != value.data() + value.size()) {
+        throw std::invalid_argument("Invalid value for " + option + ": " + value);
+    }
+    return count;
+}
+
+std::vector<knowledge_extraction::Proposition> parse_propositions(const std::string &value) {
+    std::vector<knowledge_extraction::Proposition> propositions;
+    std::istringstream names{value};
+    for (std::string name; std::getline(names, name, ',');) {
+        auto prop = knowledge_extraction::proposition::string_to_proposition.find(name);
+        if (prop == knowledge_extraction::proposition::string_to_proposition.end()) {
+            throw std::invalid_argument("Unknown proposition: " + name);
+        }
+        propositions.push_back(prop->second);
+    }
+    return propositions;
+}
+
+template <typename Write>
+void write_file(const std::string &path, const std::vector<ScenarioReport> &reports, Write write) {
+    std::ofstream out{path};
+    write(reports, out);
+    if (!out) {
+        throw std::runtime_error("Cannot write reports to " + path);
+    }
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    try {
+        BatchOptions options;
+        options.propositions = get_default_propositions();
+        std::optional<std::string> csv_path;
+        std::optional<std::string> json_path;
+        std::vector<std::string> inputs;
+
+        std::vector<std::string> args(argv + 1, argv + argc);
+        for (size_t i = 0; i < args.size(); ++i) {
+            const auto &arg = args[i];
+            if (arg == "--help") {
+                std::cout << usage;
+                return 0;
+            }
+            if (!arg.starts_with("--")) {
+                inputs.push_back(arg);
+                continue;
+            }
+            if (i + 1 >= args.size()) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            const auto &value = args[++i];
+            if (arg == "--propositions") {
+                options.propositions = parse_propositions(value);
+            } else if (arg == "--horizon") {
+                options.horizon = parse_count(arg, value);
+            } else if (arg == "--threads") {
+                options.num_threads = parse_count(arg, value);
+            } else if (arg == "--cache-dir") {
+                std::filesystem::create_directories(value);
+                options.cache_dir = value;
+            } else if (arg == "--csv") {
+                csv_path = value;
+            } else if (arg == "--json") {
+                json_path = value;
+            } else {
+                throw std::invalid_argument("Unknown option: " + arg);
+            }
+        }
+        if (inputs.empty()) {
+            throw std::invalid_argument("No scenarios given");
+        }
+
+        auto reports = run_batch(collect_scenarios(inputs), options);
+
+        if (csv_path.has_value()) {
+            write_file(csv_path.value(), reports, write_csv);
+        }
+        if (json_path.has_value()) {
+            write_file(json_path.value(), reports, write_json);
+        }
+        if (!csv_path.has_value() && !json_path.has_value()) {
+            write_csv(reports, std::cout);
+        }
+
+        auto num_failed = std::ranges::count(reports, false, &ScenarioReport::success);
+        double extraction_time = 0;
+        for (const auto &report : reports) {
+            extraction_time += report.extraction_time;
+        }
+        std::cerr << "Processed " << reports.size() << " scenarios, " << num_failed << " failed, "
+                  << extraction_time << " s of extraction\n";
+        return num_failed == 0 ? 0 : 1;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n\n" << usage;
+        return 2;
+    }
+}
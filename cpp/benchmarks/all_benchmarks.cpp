@@ -0,0 +1,16 @@
+#include "memory_manager.hpp"
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char **argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    AllocationCounter allocation_counter;
+    benchmark::RegisterMemoryManager(&allocation_counter);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::RegisterMemoryManager(nullptr);
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "cr_knowledge_extraction/ego_behavior/sets/box.hpp"
+
+#include <benchmark/benchmark.h>
+
+using knowledge_extraction::ego_behavior::sets::Box;
+
+namespace {
+template <int N> Box<N> make_box(double offset) {
+    return Box<N>{Eigen::Vector<double, N>::Constant(10 + offset), Eigen::Vector<double, N>::Constant(2)};
+}
+
+template <int N> void BM_BoxFromBounds(benchmark::State &state) {
+    Eigen::Vector<double, N> min = Eigen::Vector<double, N>::Constant(8);
+    Eigen::Vector<double, N> max = Eigen::Vector<double, N>::Constant(12);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(min);
+        benchmark::DoNotOptimize(Box<N>::from_bounds(min, max));
+    }
+}
+
+template <int N> void BM_BoxBounds(benchmark::State &state) {
+    auto box = make_box<N>(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(box.bounds());
+    }
+}
+
+template <int N> void BM_BoxIntersect(benchmark::State &state) {
+    auto box = make_box<N>(0);
+    auto other = make_box<N>(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(box.intersect(other));
+    }
+}
+
+template <int N> void BM_BoxSum(benchmark::State &state) {
+    auto box = make_box<N>(0);
+    auto other = make_box<N>(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(box.sum(other));
+    }
+}
+
+template <int N> void BM_BoxShrink(benchmark::State &state) {
+    auto box = make_box<N>(0);
+    double delta = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(delta);
+        benchmark::DoNotOptimize(box.shrink(delta));
+    }
+}
+
+void BM_Box2DLinearMapPositive(benchmark::State &state) {
+    auto box = make_box<2>(0);
+    // Maps the input accelerations to the state update within one time step, as done for the ego approximations
+    double dt = 0.1;
+    Eigen::Matrix<double, 4, 2> matrix{{dt * dt / 2, 0}, {dt, 0}, {0, dt * dt / 2}, {0, dt}};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(box.linear_map_positive(matrix));
+    }
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_BoxFromBounds, 2);
+BENCHMARK_TEMPLATE(BM_BoxFromBounds, 4);
+BENCHMARK_TEMPLATE(BM_BoxBounds, 2);
+BENCHMARK_TEMPLATE(BM_BoxBounds, 4);
+BENCHMARK_TEMPLATE(BM_BoxIntersect, 2);
+BENCHMARK_TEMPLATE(BM_BoxIntersect, 4);
+BENCHMARK_TEMPLATE(BM_BoxSum, 2);
+BENCHMARK_TEMPLATE(BM_BoxSum, 4);
+BENCHMARK_TEMPLATE(BM_BoxShrink, 2);
+BENCHMARK_TEMPLATE(BM_BoxShrink, 4);
+BENCHMARK(BM_Box2DLinearMapPositive);
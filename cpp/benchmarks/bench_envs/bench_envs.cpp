@@ -0,0 +1,134 @@
+#include "bench_envs.hpp"
+
+#include "cr_knowledge_extraction/relevant_propositions.hpp"
+
+#include <commonroad_cpp/interfaces/commonroad/input_utils.h>
+#include <commonroad_cpp/obstacle/obstacle.h>
+
+#include <cmath>
+
+using knowledge_extraction::Proposition;
+using knowledge_extraction::ego_behavior::EgoParameters;
+
+std::vector<std::string> BenchmarkEnvironments::get_scenario_names() {
+    return {"interstate_simple", "two_lanes", "DEU_MerzenichRather"};
+}
+
+std::vector<Proposition> BenchmarkEnvironments::get_kleene_propositions() {
+    return {
+        Proposition::ON_MAIN_CARRIAGEWAY,
+        Proposition::IN_INTERSECTION,
+        Proposition::ON_MAIN_CARRIAGEWAY_RIGHT_LANE,
+        Proposition::ON_MAIN_CARRIAGEWAY_LEFT_LANE,
+        Proposition::IN_FRONT_OF,
+        Proposition::IN_SAME_LANE,
+        Proposition::CUT_IN,
+        Proposition::KEEPS_SAFE_DISTANCE_PREC,
+        Proposition::OTHER_ON_ACCESS_RAMP,
+        Proposition::OTHER_ON_MAIN_CARRIAGEWAY,
+        Proposition::RELEVANT_TRAFFIC_LIGHT,
+        Proposition::AT_STOP_SIGN,
+        Proposition::ON_INCOMING_LEFT_OF,
+        Proposition::OTHER_TURNING_LEFT,
+        Proposition::OTHER_GOING_STRAIGHT,
+        Proposition::OTHER_TURNING_RIGHT,
+        Proposition::SAME_LEFT_LEFT_PRIORITY,
+        Proposition::SAME_LEFT_STRAIGHT_PRIORITY,
+        Proposition::SAME_LEFT_RIGHT_PRIORITY,
+        Proposition::SAME_STRAIGHT_LEFT_PRIORITY,
+        Proposition::SAME_STRAIGHT_STRAIGHT_PRIORITY,
+        Proposition::SAME_STRAIGHT_RIGHT_PRIORITY,
+        Proposition::SAME_RIGHT_LEFT_PRIORITY,
+        Proposition::SAME_RIGHT_STRAIGHT_PRIORITY,
+        Proposition::SAME_RIGHT_RIGHT_PRIORITY,
+        Proposition::HAS_LEFT_LEFT_PRIORITY,
+        Proposition::HAS_LEFT_STRAIGHT_PRIORITY,
+        Proposition::HAS_LEFT_RIGHT_PRIORITY,
+        Proposition::HAS_STRAIGHT_LEFT_PRIORITY,
+        Proposition::HAS_STRAIGHT_STRAIGHT_PRIORITY,
+        Proposition::HAS_STRAIGHT_RIGHT_PRIORITY,
+        Proposition::HAS_RIGHT_LEFT_PRIORITY,
+        Proposition::HAS_RIGHT_STRAIGHT_PRIORITY,
+        Proposition::HAS_RIGHT_RIGHT_PRIORITY,
+        Proposition::OTHER_HAS_LEFT_LEFT_PRIORITY,
+        Proposition::OTHER_HAS_LEFT_STRAIGHT_PRIORITY,
+        Proposition::OTHER_HAS_LEFT_RIGHT_PRIORITY,
+        Proposition::OTHER_HAS_STRAIGHT_LEFT_PRIORITY,
+        Proposition::OTHER_HAS_STRAIGHT_STRAIGHT_PRIORITY,
+        Proposition::OTHER_HAS_STRAIGHT_RIGHT_PRIORITY,
+        Proposition::OTHER_HAS_RIGHT_LEFT_PRIORITY,
+        Proposition::OTHER_HAS_RIGHT_STRAIGHT_PRIORITY,
+        Proposition::OTHER_HAS_RIGHT_RIGHT_PRIORITY,
+    };
+}
+
+std::vector<Proposition> BenchmarkEnvironments::get_relationship_propositions() {
+    return {
+        Proposition::IN_SAME_LANE,
+        Proposition::IN_INTERSECTION_CONFLICT_AREA,
+        Proposition::IN_FRONT_OF,
+        Proposition::KEEPS_SAFE_DISTANCE_PREC,
+    };
+}
+
+const std::vector<BenchmarkScenario> &BenchmarkEnvironments::get_scenarios() {
+    static const std::vector<BenchmarkScenario> scenarios{setup_interstate_simple(), setup_two_lanes(),
+                                                          setup_merzenich_rather()};
+    return scenarios;
+}
+
+std::unordered_map<time_step_t, std::vector<std::string>>
+BenchmarkEnvironments::make_relevant_propositions(const BenchmarkScenario &scenario,
+                                                  const std::vector<Proposition> &propositions, time_step_t horizon) {
+    return knowledge_extraction::make_relevant_propositions(
+        *scenario.world, propositions, scenario.ego_params.initial_state.getTimeStep(), horizon);
+}
+
+BenchmarkScenario BenchmarkEnvironments::setup_interstate_simple() {
+    auto scenario = InputUtils::getDataFromCommonRoad(std::string{CR_KNOWLEDGE_EXTRACTION_BENCH_TEST_SCENARIO_DIR} +
+                                                      "interstate_simple.xml");
+    auto world =
+        std::make_shared<World>("interstate_simple", 0, scenario.roadNetwork, std::vector<std::shared_ptr<Obstacle>>{},
+                                scenario.obstacles, scenario.timeStepSize);
+
+    // reference path aligned with cartesian axes so that CCS coordinates are equal to cartesian coordinates
+    geometry::EigenPolyline reference_path{{-250, 0}, {0, 0}, {250, 0}};
+    auto ccs = std::make_shared<geometry::CurvilinearCoordinateSystem>(reference_path, 100);
+
+    return {"interstate_simple", world, ccs, EgoParameters{}};
+}
+
+BenchmarkScenario BenchmarkEnvironments::setup_two_lanes() {
+    auto scenario = InputUtils::getDataFromCommonRoad(std::string{CR_KNOWLEDGE_EXTRACTION_BENCH_TEST_SCENARIO_DIR} +
+                                                      "two_lanes.xml");
+    auto world = std::make_shared<World>("two_lanes", 0, scenario.roadNetwork, std::vector<std::shared_ptr<Obstacle>>{},
+                                         scenario.obstacles, scenario.timeStepSize);
+
+    // reference path aligned with cartesian axes so that CCS coordinates are equal to cartesian coordinates
+    geometry::EigenPolyline reference_path{{-250, 0}, {0, 0}, {250, 0}};
+    auto ccs = std::make_shared<geometry::CurvilinearCoordinateSystem>(reference_path, 100);
+
+    return {"two_lanes", world, ccs, EgoParameters{}};
+}
+
+BenchmarkScenario BenchmarkEnvironments::setup_merzenich_rather() {
+    auto scenario = InputUtils::getDataFromCommonRoad(std::string{CR_KNOWLEDGE_EXTRACTION_BENCH_SCENARIO_DIR} +
+                                                      "DEU_MerzenichRather-2_8814400_T-14549.xml");
+    auto world = std::make_shared<World>("DEU_MerzenichRather", 0, scenario.roadNetwork,
+                                         std::vector<std::shared_ptr<Obstacle>>{}, scenario.obstacles,
+                                         scenario.timeStepSize);
+
+    // Initial state of the planning problem in the scenario file
+    EgoParameters ego_params;
+    ego_params.initial_state = State{0, 177.5603, -174.4141, 36.3705, 0.0008, -0.2649};
+
+    // Without a route planner in C++, the reference path is a straight line through the initial position in driving
+    // direction, which covers the carriageway of the ego vehicle for the benchmarked horizons
+    Eigen::Vector2d position{ego_params.initial_state.getXPosition(), ego_params.initial_state.getYPosition()};
+    Eigen::Vector2d direction{std::cos(ego_params.initial_state.getGlobalOrientation()),
+                              std::sin(ego_params.initial_state.getGlobalOrientation())};
+    geometry::EigenPolyline reference_path{position - 250 * direction, position, position + 250 * direction};
+    auto ccs = std::make_shared<geometry::CurvilinearCoordinateSystem>(reference_path, 100);
+
+    return {"DEU_MerzenichRather", world, ccs, ego_params};
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "cr_knowledge_extraction/ego_behavior/ego_params.hpp"
+#include "cr_knowledge_extraction/proposition.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+#include <commonroad_cpp/world.h>
+#include <geometry/curvilinear_coordinate_system.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A scenario together with everything that is needed to create an extraction interface on it.
+ */
+struct BenchmarkScenario {
+    std::string name;
+    std::shared_ptr<World> world;
+    std::shared_ptr<geometry::CurvilinearCoordinateSystem> ego_ccs;
+    knowledge_extraction::ego_behavior::EgoParameters ego_params;
+};
+
+struct BenchmarkEnvironments {
+    /**
+     * Get the names of all benchmark scenarios without loading them, e.g. to register benchmarks.
+     *
+     * @return The names in the same order as the scenarios.
+     */
+    static std::vector<std::string> get_scenario_names();
+
+    /**
+     * Get all benchmark scenarios, which are loaded on first use and shared by all benchmarks.
+     *
+     * The index of a scenario in this vector is used as benchmark argument.
+     *
+     * @return The scenarios.
+     */
+    static const std::vector<BenchmarkScenario> &get_scenarios();
+
+    /**
+     * Get all propositions for which the extraction interface creates a Kleene extractor.
+     *
+     * @return The propositions.
+     */
+    static std::vector<knowledge_extraction::Proposition> get_kleene_propositions();
+
+    /**
+     * Get all propositions for which the extraction interface creates a relationship extractor.
+     *
+     * @return The propositions.
+     */
+    static std::vector<knowledge_extraction::Proposition> get_relationship_propositions();
+
+    /**
+     * Instantiate propositions for all time steps of a horizon starting at the initial time step of the ego vehicle.
+     *
+     * See knowledge_extraction::make_relevant_propositions.
+     *
+     * @param scenario The scenario.
+     * @param propositions The propositions to instantiate.
+     * @param horizon The number of time steps.
+     * @return The relevant propositions keyed by formula time steps, as expected by the extraction interface.
+     */
+    static std::unordered_map<time_step_t, std::vector<std::string>>
+    make_relevant_propositions(const BenchmarkScenario &scenario,
+                               const std::vector<knowledge_extraction::Proposition> &propositions, time_step_t horizon);
+
+    static BenchmarkScenario setup_interstate_simple();
+    static BenchmarkScenario setup_two_lanes();
+    static BenchmarkScenario setup_merzenich_rather();
+};
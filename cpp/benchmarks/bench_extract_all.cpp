@@ -0,0 +1,79 @@
+#include "bench_envs/bench_envs.hpp"
+
+#include "cr_knowledge_extraction/extraction_interface.hpp"
+#include "cr_knowledge_extraction/extraction_session.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <optional>
+
+using knowledge_extraction::ExtractionInterface;
+using knowledge_extraction::ExtractionSession;
+using knowledge_extraction::Proposition;
+
+namespace {
+// All propositions that are handled by at least one extractor
+std::vector<Proposition> get_all_propositions() {
+    auto propositions = BenchmarkEnvironments::get_kleene_propositions();
+    for (auto prop : BenchmarkEnvironments::get_relationship_propositions()) {
+        if (std::ranges::find(propositions, prop) == propositions.end()) {
+            propositions.push_back(prop);
+        }
+    }
+    return propositions;
+}
+
+/**
+ * Extract all knowledge on a fresh extraction interface for the given scenario and horizon.
+ *
+ * Creating the interface is not measured, so that this covers a single planning cycle with empty caches.
+ */
+void BM_ExtractAll(benchmark::State &state) {
+    const auto &scenario = BenchmarkEnvironments::get_scenarios().at(static_cast<size_t>(state.range(0)));
+    state.SetLabel(scenario.name);
+    auto relevant_propositions = BenchmarkEnvironments::make_relevant_propositions(
+        scenario, get_all_propositions(), static_cast<time_step_t>(state.range(1)));
+
+    size_t num_decided = 0;
+    std::optional<ExtractionInterface> extraction_interface;
+    for (auto _ : state) {
+        state.PauseTiming();
+        extraction_interface.emplace(scenario.world, scenario.ego_ccs, scenario.ego_params);
+        state.ResumeTiming();
+
+        auto result = extraction_interface->extract_all_compact(relevant_propositions);
+        num_decided = result.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["decided"] = static_cast<double>(num_decided);
+}
+
+/**
+ * Extract all knowledge repeatedly with the same session, so that all caches and parsed propositions are reused.
+ */
+void BM_ExtractAllWarm(benchmark::State &state) {
+    const auto &scenario = BenchmarkEnvironments::get_scenarios().at(static_cast<size_t>(state.range(0)));
+    state.SetLabel(scenario.name);
+    auto relevant_propositions = BenchmarkEnvironments::make_relevant_propositions(
+        scenario, get_all_propositions(), static_cast<time_step_t>(state.range(1)));
+
+    ExtractionInterface extraction_interface{scenario.world, scenario.ego_ccs, scenario.ego_params};
+    ExtractionSession session{extraction_interface, relevant_propositions};
+    session.extract_all();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(session.extract_all());
+    }
+}
+} // namespace
+
+// Horizons in time steps, the scenarios use time step sizes of 0.1 s and 0.04 s
+BENCHMARK(BM_ExtractAll)
+    ->ArgsProduct({{0, 1, 2}, {1, 10, 20, 40}})
+    ->ArgNames({"scenario", "horizon"})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ExtractAllWarm)
+    ->ArgsProduct({{0, 1, 2}, {1, 10, 20, 40}})
+    ->ArgNames({"scenario", "horizon"})
+    ->Unit(benchmark::kMillisecond);
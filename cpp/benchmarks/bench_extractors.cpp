@@ -0,0 +1,68 @@
+#include "bench_envs/bench_envs.hpp"
+
+#include "cr_knowledge_extraction/extraction_interface.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <optional>
+
+using knowledge_extraction::ExtractionInterface;
+using knowledge_extraction::Proposition;
+
+namespace {
+// Number of time steps for which each extractor is benchmarked
+constexpr time_step_t extractor_horizon = 20;
+
+/**
+ * Benchmark a single extractor on a fresh extraction interface, so that every iteration starts with empty caches.
+ *
+ * Creating the interface, which projects the road network into the CCS, is not measured.
+ */
+template <typename Extract>
+void run_extractor_benchmark(benchmark::State &state, size_t scenario_index, Proposition prop, Extract extract) {
+    const auto &scenario = BenchmarkEnvironments::get_scenarios().at(scenario_index);
+    auto relevant_propositions = BenchmarkEnvironments::make_relevant_propositions(scenario, {prop}, extractor_horizon);
+
+    size_t num_decided = 0;
+    std::optional<ExtractionInterface> extraction_interface;
+    for (auto _ : state) {
+        state.PauseTiming();
+        extraction_interface.emplace(scenario.world, scenario.ego_ccs, scenario.ego_params);
+        state.ResumeTiming();
+
+        auto result = extract(extraction_interface.value(), relevant_propositions);
+        num_decided = result.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["decided"] = static_cast<double>(num_decided);
+}
+
+// Benchmarks are registered per extractor and scenario, so that their names stay comparable between commits
+[[maybe_unused]] const bool registered = []() {
+    auto scenario_names = BenchmarkEnvironments::get_scenario_names();
+    for (size_t scenario_index = 0; scenario_index < scenario_names.size(); ++scenario_index) {
+        const auto &scenario_name = scenario_names[scenario_index];
+        for (auto prop : BenchmarkEnvironments::get_kleene_propositions()) {
+            auto name = "BM_KleeneExtractor/" + knowledge_extraction::proposition::to_string(prop, std::nullopt) +
+                        "/" + scenario_name;
+            benchmark::RegisterBenchmark(name, [scenario_index, prop](benchmark::State &state) {
+                run_extractor_benchmark(state, scenario_index, prop,
+                                        [](auto &extraction_interface, const auto &propositions) {
+                                            return extraction_interface.extract_kleene_compact(propositions);
+                                        });
+            })->Unit(benchmark::kMillisecond);
+        }
+        for (auto prop : BenchmarkEnvironments::get_relationship_propositions()) {
+            auto name = "BM_RelationshipExtractor/" +
+                        knowledge_extraction::proposition::to_string(prop, std::nullopt) + "/" + scenario_name;
+            benchmark::RegisterBenchmark(name, [scenario_index, prop](benchmark::State &state) {
+                run_extractor_benchmark(state, scenario_index, prop,
+                                        [](auto &extraction_interface, const auto &propositions) {
+                                            return extraction_interface.extract_relationships_compact(propositions);
+                                        });
+            })->Unit(benchmark::kMillisecond);
+        }
+    }
+    return true;
+}();
+} // namespace
@@ -0,0 +1,39 @@
+#include "cr_knowledge_extraction/proposition.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using knowledge_extraction::Proposition;
+
+namespace {
+void BM_PropositionFromString(benchmark::State &state) {
+    // Propositions as they are generated by the rule instantiation, with and without obstacle parameter
+    const std::vector<std::string> propositions{"InFrontOf(100)", "OnMainCarriageway", "KeepsSafeDistancePrec(31415)",
+                                                "OtherHasStraightStraightPriority(7)", "InIntersection"};
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(knowledge_extraction::proposition::from_string(propositions[i]));
+        i = (i + 1) % propositions.size();
+    }
+}
+
+void BM_PropositionToString(benchmark::State &state) {
+    const std::vector<std::pair<Proposition, std::optional<size_t>>> propositions{
+        {Proposition::IN_FRONT_OF, 100},
+        {Proposition::ON_MAIN_CARRIAGEWAY, std::nullopt},
+        {Proposition::KEEPS_SAFE_DISTANCE_PREC, 31415},
+        {Proposition::OTHER_HAS_STRAIGHT_STRAIGHT_PRIORITY, 7},
+        {Proposition::IN_INTERSECTION, std::nullopt}};
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto &[prop, parameter] = propositions[i];
+        benchmark::DoNotOptimize(knowledge_extraction::proposition::to_string(prop, parameter));
+        i = (i + 1) % propositions.size();
+    }
+}
+} // namespace
+
+BENCHMARK(BM_PropositionFromString);
+BENCHMARK(BM_PropositionToString);
@@ -0,0 +1,44 @@
+#include "bench_envs/bench_envs.hpp"
+
+#include "cr_knowledge_extraction/road_network/curvilinear_road_network.hpp"
+
+#include <benchmark/benchmark.h>
+
+using knowledge_extraction::ego_behavior::sets::Box2D;
+using knowledge_extraction::road_network::CurvilinearRoadNetwork;
+
+namespace {
+void BM_CurvilinearRoadNetworkConstruction(benchmark::State &state) {
+    const auto &scenario = BenchmarkEnvironments::get_scenarios().at(static_cast<size_t>(state.range(0)));
+    state.SetLabel(scenario.name);
+    for (auto _ : state) {
+        CurvilinearRoadNetwork road_network{scenario.world->getRoadNetwork(), scenario.ego_ccs};
+        benchmark::DoNotOptimize(road_network);
+    }
+}
+
+void BM_GetOverlappingLanelets(benchmark::State &state) {
+    const auto &scenario = BenchmarkEnvironments::get_scenarios().at(static_cast<size_t>(state.range(0)));
+    state.SetLabel(scenario.name);
+    CurvilinearRoadNetwork road_network{scenario.world->getRoadNetwork(), scenario.ego_ccs};
+
+    // Boxes of the given longitudinal extent along the 500 m reference path, at the reference path and next to it
+    auto length = static_cast<double>(state.range(1));
+    std::vector<Box2D> queries;
+    for (double s = 10; s <= 490; s += 10) {
+        for (double d : {-5.0, 0.0, 5.0}) {
+            queries.emplace_back(Eigen::Vector2d{s, d}, Eigen::Vector2d{length / 2, 1});
+        }
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(road_network.get_overlapping_lanelets(queries[i]));
+        i = (i + 1) % queries.size();
+    }
+}
+} // namespace
+
+BENCHMARK(BM_CurvilinearRoadNetworkConstruction)->DenseRange(0, 2)->ArgName("scenario")->Unit(benchmark::kMillisecond);
+// Query lengths of a single vehicle and of the reachable positions a few seconds ahead
+BENCHMARK(BM_GetOverlappingLanelets)->ArgsProduct({{0, 1, 2}, {5, 50}})->ArgNames({"scenario", "length"});
@@ -0,0 +1,129 @@
+#include "bench_envs/bench_envs.hpp"
+
+#include "cr_knowledge_extraction/extraction_interface.hpp"
+
+#include "scenario_generator.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
+using knowledge_extraction::ExtractionInterface;
+using knowledge_extraction::Proposition;
+using knowledge_extraction::scenario_generator::generate_scenario;
+using knowledge_extraction::scenario_generator::RoadLayout;
+using knowledge_extraction::scenario_generator::ScenarioParameters;
+
+namespace {
+const std::vector<std::string> layout_names{"highway", "on_ramp", "intersections"};
+
+/**
+ * Get a synthetic scenario, which is generated on first use and shared by all benchmarks with the same arguments.
+ *
+ * The obstacles are predicted for exactly the horizon, so that the horizon also determines the size of the scenario.
+ */
+const BenchmarkScenario &get_synthetic_scenario(size_t layout, size_t num_obstacles, time_step_t horizon,
+                                                size_t num_segments) {
+    static std::mutex mutex;
+    static std::map<std::tuple<size_t, size_t, time_step_t, size_t>, BenchmarkScenario> scenarios;
+    std::scoped_lock lock{mutex};
+    auto key = std::make_tuple(layout, num_obstacles, horizon, num_segments);
+    if (auto it = scenarios.find(key); it != scenarios.end()) {
+        return it->second;
+    }
+    ScenarioParameters params;
+    params.layout = static_cast<RoadLayout>(layout);
+    params.num_obstacles = num_obstacles;
+    params.num_time_steps = static_cast<size_t>(horizon);
+    params.num_segments = num_segments;
+    auto generated = generate_scenario(params);
+    return scenarios
+        .emplace(key, BenchmarkScenario{layout_names.at(layout), generated.world, generated.ego_ccs,
+                                        generated.ego_params})
+        .first->second;
+}
+
+std::vector<Proposition> get_all_propositions() {
+    auto propositions = BenchmarkEnvironments::get_kleene_propositions();
+    for (auto prop : BenchmarkEnvironments::get_relationship_propositions()) {
+        if (std::ranges::find(propositions, prop) == propositions.end()) {
+            propositions.push_back(prop);
+        }
+    }
+    return propositions;
+}
+
+/**
+ * Extract the given propositions on a fresh extraction interface, creating the interface is not measured.
+ */
+template <typename Extract>
+void run_synthetic_benchmark(benchmark::State &state, const std::vector<Proposition> &propositions, Extract extract) {
+    auto horizon = static_cast<time_step_t>(state.range(2));
+    const auto &scenario = get_synthetic_scenario(static_cast<size_t>(state.range(0)),
+                                                  static_cast<size_t>(state.range(1)), horizon,
+                                                  static_cast<size_t>(state.range(3)));
+    state.SetLabel(scenario.name);
+    auto relevant_propositions = BenchmarkEnvironments::make_relevant_propositions(scenario, propositions, horizon);
+
+    size_t num_decided = 0;
+    std::optional<ExtractionInterface> extraction_interface;
+    for (auto _ : state) {
+        state.PauseTiming();
+        extraction_interface.emplace(scenario.world, scenario.ego_ccs, scenario.ego_params);
+        state.ResumeTiming();
+
+        auto result = extract(extraction_interface.value(), relevant_propositions);
+        num_decided = result.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["decided"] = static_cast<double>(num_decided);
+    state.counters["obstacles"] = static_cast<double>(scenario.world->getObstacles().size());
+}
+
+// Each sweep varies one dimension and keeps the others at their defaults: 16 obstacles, 20 time steps, 4 segments
+void apply_sweeps(benchmark::internal::Benchmark *benchmark) {
+    benchmark->ArgNames({"layout", "obstacles", "horizon", "segments"})
+        ->ArgsProduct({{0, 1, 2}, {4, 8, 16, 32, 64, 128}, {20}, {4}})
+        ->ArgsProduct({{0, 1, 2}, {16}, {5, 10, 40, 80}, {4}})
+        ->ArgsProduct({{0, 1, 2}, {16}, {20}, {1, 2, 8, 16, 32}})
+        ->Unit(benchmark::kMillisecond);
+}
+
+[[maybe_unused]] const bool registered = []() {
+    apply_sweeps(benchmark::RegisterBenchmark("BM_SyntheticExtractAll", [](benchmark::State &state) {
+        run_synthetic_benchmark(state, get_all_propositions(),
+                                [](auto &extraction_interface, const auto &propositions) {
+                                    return extraction_interface.extract_all_compact(propositions);
+                                });
+    }));
+    // Single extractors are only swept over the number of obstacles, which dominates their runtime
+    for (auto prop : BenchmarkEnvironments::get_kleene_propositions()) {
+        auto name = "BM_SyntheticKleeneExtractor/" + knowledge_extraction::proposition::to_string(prop, std::nullopt);
+        benchmark::RegisterBenchmark(name, [prop](benchmark::State &state) {
+            run_synthetic_benchmark(state, {prop}, [](auto &extraction_interface, const auto &propositions) {
+                return extraction_interface.extract_kleene_compact(propositions);
+            });
+        })
+            ->ArgNames({"layout", "obstacles", "horizon", "segments"})
+            ->ArgsProduct({{0, 1, 2}, {4, 16, 64}, {20}, {4}})
+            ->Unit(benchmark::kMillisecond);
+    }
+    for (auto prop : BenchmarkEnvironments::get_relationship_propositions()) {
+        auto name =
+            "BM_SyntheticRelationshipExtractor/" + knowledge_extraction::proposition::to_string(prop, std::nullopt);
+        benchmark::RegisterBenchmark(name, [prop](benchmark::State &state) {
+            run_synthetic_benchmark(state, {prop}, [](auto &extraction_interface, const auto &propositions) {
+                return extraction_interface.extract_relationships_compact(propositions);
+            });
+        })
+            ->ArgNames({"layout", "obstacles", "horizon", "segments"})
+            ->ArgsProduct({{0, 1, 2}, {4, 16, 64}, {20}, {4}})
+            ->Unit(benchmark::kMillisecond);
+    }
+    return true;
+}();
+} // namespace
@@ -0,0 +1,71 @@
+#include "memory_manager.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+// Every block starts with its size, the header keeps the returned pointer aligned for all fundamental types
+constexpr size_t header_size = alignof(std::max_align_t);
+
+std::atomic<bool> counting{false};
+std::atomic<int64_t> num_allocs{0};
+std::atomic<int64_t> current_bytes{0};
+std::atomic<int64_t> max_bytes{0};
+std::atomic<int64_t> total_bytes{0};
+
+void record_allocation(size_t size) {
+    num_allocs.fetch_add(1, std::memory_order_relaxed);
+    total_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+    auto current = current_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) +
+                   static_cast<int64_t>(size);
+    auto max = max_bytes.load(std::memory_order_relaxed);
+    while (current > max && !max_bytes.compare_exchange_weak(max, current, std::memory_order_relaxed)) {
+    }
+}
+} // namespace
+
+void AllocationCounter::Start() {
+    num_allocs.store(0, std::memory_order_relaxed);
+    current_bytes.store(0, std::memory_order_relaxed);
+    max_bytes.store(0, std::memory_order_relaxed);
+    total_bytes.store(0, std::memory_order_relaxed);
+    counting.store(true, std::memory_order_release);
+}
+
+void AllocationCounter::Stop(Result &result) {
+    counting.store(false, std::memory_order_release);
+    result.num_allocs = num_allocs.load(std::memory_order_relaxed);
+    result.max_bytes_used = max_bytes.load(std::memory_order_relaxed);
+    result.total_allocated_bytes = total_bytes.load(std::memory_order_relaxed);
+    // Memory that was allocated before the start and freed while counting results in a negative growth
+    result.net_heap_growth = current_bytes.load(std::memory_order_relaxed);
+}
+
+// The array, sized and nothrow versions forward to these by default
+void *operator new(size_t size) {
+    auto *block = static_cast<std::byte *>(std::malloc(size + header_size));
+    if (block == nullptr) {
+        throw std::bad_alloc{};
+    }
+    *reinterpret_cast<size_t *>(block) = size;
+    if (counting.load(std::memory_order_acquire)) {
+        record_allocation(size);
+    }
+    return block + header_size;
+}
+
+void operator delete(void *ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    auto *block = static_cast<std::byte *>(ptr) - header_size;
+    if (counting.load(std::memory_order_acquire)) {
+        current_bytes.fetch_sub(static_cast<int64_t>(*reinterpret_cast<size_t *>(block)), std::memory_order_relaxed);
+    }
+    std::free(block);
+}
+
+void operator delete(void *ptr, size_t /*size*/) noexcept { operator delete(ptr); }
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+/**
+ * Counts heap allocations via the global operator new, so that the benchmark reports contain the memory usage.
+ *
+ * Google Benchmark runs one additional iteration of every benchmark while the memory manager is active and reports
+ * allocs_per_iter, max_bytes_used and net_heap_growth of that iteration.
+ */
+class AllocationCounter : public benchmark::MemoryManager {
+  public:
+    void Start() override;
+    void Stop(Result &result) override;
+};
@@ -0,0 +1,74 @@
+"""
+Plot the runtime and memory usage of the synthetic benchmarks over one sweep dimension.
+
+Usage: python plot_scaling.py results.json [--sweep obstacles|horizon|segments] [--output scaling.png]
+
+The results must be written by cr_knowledge_extraction_bench with --benchmark_out_format=json. Requires matplotlib.
+"""
+
+import argparse
+import json
+import re
+from collections import defaultdict
+
+import matplotlib.pyplot as plt
+
+SWEEP_DEFAULTS = {"obstacles": 16, "horizon": 20, "segments": 4}
+
+
+def parse_args(name: str) -> tuple[str, dict[str, int]]:
+    """Split a benchmark name like BM_SyntheticExtractAll/layout:0/obstacles:16/... into its base name and arguments."""
+    base, *args = name.split("/")
+    named_args = {}
+    for arg in args:
+        match = re.fullmatch(r"(\w+):(\d+)", arg)
+        if match is None:
+            base += "/" + arg
+        else:
+            named_args[match.group(1)] = int(match.group(2))
+    return base, named_args
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("results")
+    parser.add_argument("--sweep", choices=SWEEP_DEFAULTS.keys(), default="obstacles")
+    parser.add_argument("--output", default="scaling.png")
+    args = parser.parse_args()
+
+    with open(args.results) as file:
+        benchmarks = json.load(file)["benchmarks"]
+
+    # (benchmark, layout) -> sweep value -> (time in ms, max bytes used)
+    curves = defaultdict(dict)
+    for benchmark in benchmarks:
+        if not benchmark["name"].startswith("BM_Synthetic") or benchmark.get("run_type") == "aggregate":
+            continue
+        base, named_args = parse_args(benchmark["run_name"])
+        fixed = [dim for dim in SWEEP_DEFAULTS if dim != args.sweep]
+        if any(named_args.get(dim) != SWEEP_DEFAULTS[dim] for dim in fixed):
+            continue
+        curves[(base, benchmark.get("label", ""))][named_args[args.sweep]] = (
+            benchmark["real_time"],
+            benchmark.get("max_bytes_used", 0),
+        )
+
+    fig, (time_axis, memory_axis) = plt.subplots(1, 2, figsize=(14, 6))
+    for (base, layout), points in sorted(curves.items()):
+        values = sorted(points)
+        label = f"{base.removeprefix('BM_Synthetic')} ({layout})"
+        time_axis.plot(values, [points[value][0] for value in values], marker="o", label=label)
+        memory_axis.plot(values, [points[value][1] / 2**20 for value in values], marker="o", label=label)
+    for axis, ylabel in ((time_axis, "time [ms]"), (memory_axis, "max heap usage [MiB]")):
+        axis.set_xlabel(args.sweep)
+        axis.set_ylabel(ylabel)
+        axis.set_xscale("log", base=2)
+        axis.set_yscale("log")
+        axis.grid(True, which="both", alpha=0.3)
+    time_axis.legend(fontsize="x-small")
+    fig.tight_layout()
+    fig.savefig(args.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "cr_knowledge_extraction/extraction_result.hpp"
+#include "cr_knowledge_extraction/proposition.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace knowledge_extraction {
+/**
+ * The kind of extractor a unit of work is done by.
+ */
+enum class ExtractorKind : uint8_t {
+    KLEENE,
+    RELATIONSHIP,
+};
+
+/**
+ * A rough estimate of how expensive an extractor is per time step, used to schedule cheap extractors first.
+ */
+enum class ExtractionCost : uint8_t {
+    // Lookups of the lanelets or traffic rules of the obstacles, mostly independent of the ego vehicle
+    CHEAP,
+    // Comparisons of the reachable bounds of the ego vehicle with the obstacles
+    MODERATE,
+    // Reasoning over the lanelet network of intersections or over pairs of propositions
+    EXPENSIVE,
+};
+
+namespace anytime {
+/**
+ * Estimate the cost of an extractor.
+ *
+ * @param prop The proposition of the extractor.
+ * @param kind The kind of the extractor.
+ * @return The estimated cost.
+ */
+ExtractionCost estimate_cost(Proposition prop, ExtractorKind kind);
+} // namespace anytime
+
+/**
+ * Work that was skipped because the budget of an anytime extraction ran out.
+ *
+ * No knowledge was extracted for the proposition at the time step, independent of the parameter.
+ */
+struct SkippedWork {
+    ExtractorKind kind;
+    Proposition proposition;
+    time_step_t time_step;
+};
+
+/**
+ * Summary of an anytime extraction.
+ */
+struct AnytimeReport {
+    bool complete{true};
+    size_t num_completed{0};
+    // Sorted by the order in which the work would have been scheduled
+    std::vector<SkippedWork> skipped;
+};
+
+/**
+ * The result of an anytime extraction.
+ *
+ * Every unit of work is either fully done or skipped, so the knowledge is sound but possibly incomplete.
+ */
+struct AnytimeExtractionResult {
+    CompactExtractionResult knowledge;
+    AnytimeReport report;
+};
+} // namespace knowledge_extraction
@@ -2,18 +2,30 @@
 
 #include "cr_knowledge_extraction/ego_behavior/ego_params.hpp"
 #include "cr_knowledge_extraction/ego_behavior/sets/box.hpp"
+#include "cr_knowledge_extraction/parallel/concurrent_cache.hpp"
+#include "cr_knowledge_extraction/parallel/work_stealing_pool.hpp"
 #include "cr_knowledge_extraction/road_network/curvilinear_road_network.hpp"
+#include "cr_knowledge_extraction/road_network/lanelet_attribute_table.hpp"
+#include "cr_knowledge_extraction/statistics.hpp"
 
 #include <Eigen/Dense>
 #include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
 namespace knowledge_extraction::ego_behavior {
 class BehaviorOverapproximation {
   private:
-    const road_network::CurvilinearRoadNetwork ccs_road_network;
+    const std::shared_ptr<const road_network::CurvilinearRoadNetwork> ccs_road_network;
+    const std::shared_ptr<const road_network::LaneletAttributeTable> lanelet_attributes;
+    const std::shared_ptr<StatisticsCollector> statistics;
 
-    const Eigen::Matrix<double, 4, 4> system_matrix;
-    static Eigen::Matrix<double, 4, 4> make_system_matrix(double dt);
+    const double dt;
 
     const sets::Box4D input_state_update;
     static sets::Box4D make_input_state_update(double dt, const EgoParameters &ego_params);
@@ -29,19 +41,60 @@ class BehaviorOverapproximation {
 
     const time_step_t offset;
 
-    std::vector<sets::Box4D> center_approximation;
-    static sets::Box4D make_initial_center_approximation(const EgoParameters &ego_params);
+    /**
+     * The reachable bounds of the center of the ego vehicle at a single time step.
+     */
+    struct ReachableStep {
+        // State $(s, \dot{s}, d, \dot{d})$ as center and radius, as well as the resulting bounds
+        Eigen::Vector4d center;
+        Eigen::Vector4d radius;
+        Eigen::Vector4d min;
+        Eigen::Vector4d max;
+        // Minimum and maximum absolute velocity
+        std::pair<double, double> velocity;
+    };
+
+    // The reachable steps are stored in fixed-size segments that are never moved once published,
+    // so that readers do not need to synchronize with a concurrent precomputation
+    static constexpr size_t steps_per_segment = 256;
+    static constexpr size_t max_segments = 4096;
+    std::array<std::unique_ptr<ReachableStep[]>, max_segments> reachable_steps;
+    std::atomic<size_t> num_reachable_steps{0};
+    std::mutex precompute_mutex;
+
+    static ReachableStep make_initial_reachable_step(const EgoParameters &ego_params);
+    ReachableStep make_next_reachable_step(const ReachableStep &previous) const;
+    static void set_bounds(ReachableStep &step);
 
-    std::unordered_map<time_step_t, sets::Box2D> occupancy_approximation;
-    std::unordered_map<time_step_t, std::vector<std::shared_ptr<Lanelet>>> covered_lanelets;
-    std::unordered_map<std::pair<time_step_t, Direction>, std::pair<int, int>,
-                       boost::hash<std::pair<time_step_t, Direction>>>
-        priority_range;
+    /**
+     * Compute and publish the reachable bounds of the next time step, precompute_mutex must be held.
+     */
+    void append_reachable_step();
 
-    std::unordered_map<time_step_t, sets::Box2D> occupancy_intersection_approximation;
-    std::unordered_map<time_step_t, std::vector<std::shared_ptr<Lanelet>>> intersected_lanelets;
+    /**
+     * Get the reachable bounds at the given time step, precomputing all missing steps up to it.
+     *
+     * @param time_step The time step.
+     * @return The reachable bounds.
+     */
+    const ReachableStep &get_reachable_step(time_step_t time_step) {
+        auto idx = time_step - offset;
+        if (idx >= num_reachable_steps.load(std::memory_order_acquire)) {
+            precompute(idx);
+        }
+        return reachable_steps[idx / steps_per_segment][idx % steps_per_segment];
+    }
 
-    std::unordered_map<time_step_t, std::pair<double, double>> velocity_approximation;
+    // All approximations below are computed lazily and may be requested by multiple threads concurrently
+
+    parallel::ConcurrentCache<time_step_t, sets::Box2D> occupancy_approximation;
+    parallel::ConcurrentCache<time_step_t, std::vector<std::shared_ptr<Lanelet>>> covered_lanelets;
+    parallel::ConcurrentCache<std::pair<time_step_t, Direction>, std::pair<int, int>,
+                              boost::hash<std::pair<time_step_t, Direction>>>
+        priority_range;
+
+    parallel::ConcurrentCache<time_step_t, sets::Box2D> occupancy_intersection_approximation;
+    parallel::ConcurrentCache<time_step_t, std::vector<std::shared_ptr<Lanelet>>> intersected_lanelets;
 
     static sets::Box2D project_to_positions(const sets::Box4D &state_set);
 
@@ -50,13 +103,29 @@ class BehaviorOverapproximation {
      * Construct a behavior overapproximation for the ego vehicle.
      *
      * This allows us to conservatively bound the future behavior of position and velocity of the ego vehicle.
+     * All approximations are computed on demand and may be queried from multiple threads concurrently.
      *
      * @param dt The time step size in s.
      * @param ego_params The configuration parameters of the ego vehicle.
-     * @param ccs_road_network The curvilinear road network.
+     * @param ccs_road_network The curvilinear road network, may be shared with other approximations.
+     * @param lanelet_attributes The lanelet attributes of the same road network, may be shared with other
+     *     approximations.
+     * @param statistics The collector for the number of lanelet queries, may be shared with other approximations.
+     */
+    BehaviorOverapproximation(
+        double dt, const EgoParameters &ego_params,
+        std::shared_ptr<const road_network::CurvilinearRoadNetwork> ccs_road_network,
+        std::shared_ptr<const road_network::LaneletAttributeTable> lanelet_attributes,
+        std::shared_ptr<StatisticsCollector> statistics = std::make_shared<StatisticsCollector>());
+
+    /**
+     * Get the curvilinear road network used to determine the covered lanelets.
+     *
+     * @return The curvilinear road network.
      */
-    BehaviorOverapproximation(double dt, const EgoParameters &ego_params,
-                              road_network::CurvilinearRoadNetwork ccs_road_network);
+    const std::shared_ptr<const road_network::CurvilinearRoadNetwork> &get_ccs_road_network() const {
+        return ccs_road_network;
+    }
 
     /**
      * Get the radius of inscribed circle of the ego vehicle shape.
@@ -78,10 +147,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The minimal longitudinal position in m.
      */
-    double p_lon_min(time_step_t time_step) {
-        const auto &[min, _] = get_center_approximation(time_step).bounds();
-        return min(0);
-    }
+    double p_lon_min(time_step_t time_step) { return get_reachable_step(time_step).min(0); }
 
     /**
      * Get the maximal longitudinal position of the ego vehicle at the given time step.
@@ -89,10 +155,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The maximal longitudinal position in m.
      */
-    double p_lon_max(time_step_t time_step) {
-        const auto &[_, max] = get_center_approximation(time_step).bounds();
-        return max(0);
-    }
+    double p_lon_max(time_step_t time_step) { return get_reachable_step(time_step).max(0); }
 
     /**
      * Get the minimal lateral position of the ego vehicle at the given time step.
@@ -100,10 +163,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The minimal lateral position in m.
      */
-    double p_lat_min(time_step_t time_step) {
-        const auto &[min, _] = get_center_approximation(time_step).bounds();
-        return min(2);
-    }
+    double p_lat_min(time_step_t time_step) { return get_reachable_step(time_step).min(2); }
 
     /**
      * Get the maximal lateral position of the ego vehicle at the given time step.
@@ -111,10 +171,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The maximal lateral position in m.
      */
-    double p_lat_max(time_step_t time_step) {
-        const auto &[_, max] = get_center_approximation(time_step).bounds();
-        return max(2);
-    }
+    double p_lat_max(time_step_t time_step) { return get_reachable_step(time_step).max(2); }
 
     /**
      * Get the minimal longitudinal velocity of the ego vehicle at the given time step.
@@ -122,10 +179,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The minimal longitudinal velocity in $\frac{m}{s}$.
      */
-    double v_lon_min(time_step_t time_step) {
-        const auto &[min, _] = get_center_approximation(time_step).bounds();
-        return min(1);
-    }
+    double v_lon_min(time_step_t time_step) { return get_reachable_step(time_step).min(1); }
 
     /**
      * Get the maximal longitudinal velocity of the ego vehicle at the given time step.
@@ -133,10 +187,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The maximal longitudinal velocity in $\frac{m}{s}$.
      */
-    double v_lon_max(time_step_t time_step) {
-        const auto &[_, max] = get_center_approximation(time_step).bounds();
-        return max(1);
-    }
+    double v_lon_max(time_step_t time_step) { return get_reachable_step(time_step).max(1); }
 
     /**
      * Get the minimal lateral velocity of the ego vehicle at the given time step.
@@ -144,10 +195,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The minimal lateral velocity in $\frac{m}{s}$.
      */
-    double v_lat_min(time_step_t time_step) {
-        const auto &[min, _] = get_center_approximation(time_step).bounds();
-        return min(3);
-    }
+    double v_lat_min(time_step_t time_step) { return get_reachable_step(time_step).min(3); }
 
     /**
      * Get the maximal lateral velocity of the ego vehicle at the given time step.
@@ -155,10 +203,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The maximal lateral velocity in $\frac{m}{s}$.
      */
-    double v_lat_max(time_step_t time_step) {
-        const auto &[_, max] = get_center_approximation(time_step).bounds();
-        return max(3);
-    }
+    double v_lat_max(time_step_t time_step) { return get_reachable_step(time_step).max(3); }
 
     /**
      * Get the minimal absolute velocity of the ego vehicle at the given time step.
@@ -166,7 +211,7 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The minimal absolute velocity in $\frac{m}{s}$.
      */
-    double v_min(time_step_t time_step) { return get_velocity_approximation(time_step).first; }
+    double v_min(time_step_t time_step) { return get_reachable_step(time_step).velocity.first; }
 
     /**
      * Get the maximal absolute velocity of the ego vehicle at the given time step.
@@ -174,7 +219,38 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return The maximal absolute velocity in $\frac{m}{s}$.
      */
-    double v_max(time_step_t time_step) { return get_velocity_approximation(time_step).second; }
+    double v_max(time_step_t time_step) { return get_reachable_step(time_step).velocity.second; }
+
+    /**
+     * Precompute the reachable bounds of the ego vehicle for all time steps up to the given horizon.
+     *
+     * The bounds are computed in a single forward pass and stored in a table, so that subsequent queries of the
+     * approximations up to the horizon are plain table lookups. Queries beyond the horizon extend the table on demand.
+     *
+     * @param horizon The number of time steps after the initial time step to precompute.
+     */
+    void precompute(size_t horizon);
+
+    /**
+     * Precompute the reachable bounds of several approximations, e.g. of different ego hypotheses, at once.
+     *
+     * With a pool, each approximation is advanced by its own task, so the approximations are computed concurrently.
+     * The result is the same as calling precompute() for each of them.
+     *
+     * @param approximations The approximations, may contain duplicates.
+     * @param horizon The number of time steps after the respective initial time step to precompute.
+     * @param pool The pool to run the tasks on or nullptr to precompute the approximations one after another. Must not
+     *     be running other tasks.
+     */
+    static void precompute_batch(std::span<BehaviorOverapproximation *const> approximations, size_t horizon,
+                                 parallel::WorkStealingPool *pool = nullptr);
+
+    /**
+     * Get the number of time steps after the initial time step for which the reachable bounds are already computed.
+     *
+     * @return The precomputed horizon.
+     */
+    size_t get_precomputed_horizon() const { return num_reachable_steps.load(std::memory_order_acquire) - 1; }
 
     /**
      * Get a box approximating the state of the ego vehicle at the given time step.
@@ -228,7 +304,9 @@ class BehaviorOverapproximation {
      * @param time_step The time step.
      * @return A pair of minimum and maximum absolute velocity.
      */
-    const std::pair<double, double> &get_velocity_approximation(time_step_t time_step);
+    const std::pair<double, double> &get_velocity_approximation(time_step_t time_step) {
+        return get_reachable_step(time_step).velocity;
+    }
 
     /**
      * Get the minimum and maximal priority for the given turning direction of the ego vehicle possible at the given
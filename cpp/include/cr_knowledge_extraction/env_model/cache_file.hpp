@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace knowledge_extraction::env_model {
+/**
+ * Appends trivially copyable values to a byte buffer in native byte order.
+ *
+ * Cache files are only read on machines of the same architecture, a mismatching byte order is detected through the
+ * format version in the header of the file.
+ */
+class CacheWriter {
+  private:
+    std::string buffer;
+
+  public:
+    /**
+     * Append a value.
+     *
+     * @param value The value.
+     */
+    template <typename T> void write(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    /**
+     * Get the written bytes.
+     *
+     * @return The buffer.
+     */
+    const std::string &get_buffer() const { return buffer; }
+};
+
+/**
+ * Reads values written by a CacheWriter from a byte range, e.g. a memory-mapped cache file.
+ *
+ * All reads are bounds checked, so corrupt or truncated data is detected instead of read out of bounds.
+ */
+class CacheReader {
+  private:
+    std::span<const char> data;
+    size_t offset{0};
+
+  public:
+    /**
+     * Create a reader at the beginning of the given data.
+     *
+     * @param data The data, must outlive the reader.
+     */
+    explicit CacheReader(std::span<const char> data) : data(data) {}
+
+    /**
+     * Read the next value.
+     *
+     * The data does not need to be aligned for the value type.
+     *
+     * @return The value.
+     * @throws std::runtime_error If the data ends before the value.
+     */
+    template <typename T> T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (data.size() - offset < sizeof(T)) {
+            throw std::runtime_error("Unexpected end of cache data");
+        }
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    /**
+     * Get the number of bytes that have not been read yet.
+     *
+     * @return The number of bytes.
+     */
+    size_t get_remaining() const { return data.size() - offset; }
+};
+
+/**
+ * Hash bytes with 64-bit FNV-1a.
+ *
+ * Used to key cache files by content, thus it must give the same result on every platform and in every run, unlike
+ * std::hash.
+ *
+ * @param data The bytes.
+ * @param seed The hash of preceding bytes to continue hashing from.
+ * @return The hash.
+ */
+uint64_t hash_bytes(std::span<const char> data, uint64_t seed = 0xcbf29ce484222325);
+
+/**
+ * Memory-map a file read-only and pass its content to the given function.
+ *
+ * @param path The path of the file.
+ * @param read A callable taking the content, which is unmapped when the callable returns.
+ * @return False iff the file does not exist.
+ * @throws std::runtime_error If the file exists but cannot be mapped.
+ */
+bool read_mapped_file(const std::filesystem::path &path, const std::function<void(std::span<const char>)> &read);
+
+/**
+ * Hash the content of a file, e.g. a CommonRoad scenario, see hash_bytes.
+ *
+ * @param path The path of the file.
+ * @return The hash.
+ * @throws std::runtime_error If the file does not exist or cannot be read.
+ */
+uint64_t hash_file(const std::filesystem::path &path);
+
+/**
+ * Replace the content of a file so that concurrent readers see either the old or the new content.
+ *
+ * The content is written to a temporary file next to the target, which is then renamed to the target. Thus several
+ * processes may write the cache file of the same scenario at the same time.
+ *
+ * @param path The path of the file.
+ * @param content The new content.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void write_file_atomically(const std::filesystem::path &path, std::string_view content);
+} // namespace knowledge_extraction::env_model
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "cr_knowledge_extraction/env_model/dense_obstacle_cache.hpp"
+#include "cr_knowledge_extraction/env_model/world_cache.hpp"
+#include "cr_knowledge_extraction/road_network/curvilinear_road_network.hpp"
+
+#include <geometry/curvilinear_coordinate_system.h>
+
+#include <memory>
+#include <optional>
+
+namespace knowledge_extraction::env_model {
+/**
+ * Caches results that depend on a curvilinear coordinate system but not on the state or parameters of the ego vehicle.
+ *
+ * A single instance can be shared by all ego hypotheses that use the same reference path.
+ * All getters may be called from multiple threads concurrently.
+ */
+class CurvilinearCache {
+  private:
+    const std::shared_ptr<WorldCache> world_cache;
+    const std::shared_ptr<geometry::CurvilinearCoordinateSystem> ccs;
+
+    // The projected road network is only built once for each CCS
+    const std::shared_ptr<const road_network::CurvilinearRoadNetwork> ccs_road_network;
+
+    DenseObstacleCache<std::optional<double>> obstacle_rear_cache;
+    std::optional<double> get_obstacle_rear_impl(size_t time_step, const std::shared_ptr<Obstacle> &obstacle) const;
+
+    DenseObstacleCache<std::optional<double>> stopping_s_cache;
+    std::optional<double> get_stopping_s_impl(size_t time_step, const std::shared_ptr<Obstacle> &obstacle);
+
+  public:
+    /**
+     * Create an empty cache for the given CCS.
+     *
+     * @param world_cache The cache of the world the CCS belongs to.
+     * @param ccs The curvilinear coordinate system.
+     */
+    CurvilinearCache(std::shared_ptr<WorldCache> world_cache,
+                     std::shared_ptr<geometry::CurvilinearCoordinateSystem> ccs);
+
+    /**
+     * Get the cache of the world.
+     *
+     * @return The world cache.
+     */
+    const std::shared_ptr<WorldCache> &get_world_cache() const { return world_cache; }
+
+    /**
+     * Get the curvilinear coordinate system.
+     *
+     * @return The curvilinear coordinate system.
+     */
+    const std::shared_ptr<geometry::CurvilinearCoordinateSystem> &get_ccs() const { return ccs; }
+
+    /**
+     * Get the road network projected to the CCS.
+     *
+     * @return The curvilinear road network.
+     */
+    const std::shared_ptr<const road_network::CurvilinearRoadNetwork> &get_ccs_road_network() const {
+        return ccs_road_network;
+    }
+
+    /**
+     * Get the rear-most s-coordinate of the given obstacle in the CCS.
+     *
+     * @param time_step The time step of interest
+     * @param obstacle The obstacle.
+     * @return The rear-most s-coordinate at the given time step or std::nullopt if the coordinate conversion is not
+     *     possible.
+     */
+    std::optional<double> get_obstacle_rear(size_t time_step, const std::shared_ptr<Obstacle> &obstacle);
+
+    /**
+     * Get the rear s-coordinate in the CCS at which the obstacle would stop if it were to fully brake.
+     *
+     * @param time_step The time step of interest.
+     * @param obstacle The obstacle.
+     * @return The s-coordinate of std::nullopt if the coordinate conversion is not possible.
+     */
+    std::optional<double> get_stopping_s(size_t time_step, const std::shared_ptr<Obstacle> &obstacle);
+};
+} // namespace knowledge_extraction::env_model
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "cr_knowledge_extraction/id_index.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+#include <commonroad_cpp/obstacle/obstacle.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace knowledge_extraction::env_model {
+/**
+ * Maps pairs of time steps and obstacle IDs to compact slot indices.
+ *
+ * Time steps are contiguous and obstacles are known when the environment model is created, thus each pair of a known
+ * obstacle and a time step within the scenario horizon gets a unique slot in [0, get_num_slots()).
+ */
+class ObstacleTimeIndex {
+  private:
+    time_step_t first_time_step;
+    size_t num_time_steps;
+    size_t num_obstacles;
+    IdIndex obstacle_index;
+
+  public:
+    /**
+     * Create an index for the given obstacles and time steps.
+     *
+     * @param obstacle_ids The IDs of all obstacles, must be unique.
+     * @param first_time_step The first time step of the horizon.
+     * @param num_time_steps The number of time steps of the horizon.
+     */
+    ObstacleTimeIndex(const std::vector<size_t> &obstacle_ids, time_step_t first_time_step, size_t num_time_steps);
+
+    /**
+     * Create an index spanning all obstacles of the scenario and the time steps at which any of them exists.
+     *
+     * @param obstacles The obstacles of the scenario.
+     * @return The index.
+     */
+    static ObstacleTimeIndex from_obstacles(const std::vector<std::shared_ptr<Obstacle>> &obstacles);
+
+    /**
+     * Get the compact index of an obstacle.
+     *
+     * @param obstacle_id The ID of the obstacle.
+     * @return The index in [0, get_num_obstacles()) or std::nullopt if the obstacle is unknown.
+     */
+    std::optional<size_t> get_obstacle_index(size_t obstacle_id) const { return obstacle_index.find(obstacle_id); }
+
+    /**
+     * Get the slot of the given time step and obstacle.
+     *
+     * @param time_step The time step.
+     * @param obstacle_id The ID of the obstacle.
+     * @return The slot or std::nullopt if the obstacle is unknown or the time step is outside of the horizon.
+     */
+    std::optional<size_t> get_slot(time_step_t time_step, size_t obstacle_id) const {
+        // Time steps before the first one wrap around and are rejected as well
+        auto time_offset = time_step - first_time_step;
+        if (time_offset >= num_time_steps) {
+            return std::nullopt;
+        }
+        auto obstacle_index = get_obstacle_index(obstacle_id);
+        if (!obstacle_index.has_value()) {
+            return std::nullopt;
+        }
+        return (obstacle_index.value() * num_time_steps) + time_offset;
+    }
+
+    /**
+     * Get the total number of slots.
+     *
+     * @return The number of slots.
+     */
+    size_t get_num_slots() const { return num_obstacles * num_time_steps; }
+
+    /**
+     * Get the number of indexed obstacles.
+     *
+     * @return The number of obstacles.
+     */
+    size_t get_num_obstacles() const { return num_obstacles; }
+
+    /**
+     * Get the first time step of the horizon.
+     *
+     * @return The time step.
+     */
+    time_step_t get_first_time_step() const { return first_time_step; }
+
+    /**
+     * Get the number of time steps of the horizon.
+     *
+     * @return The number of time steps.
+     */
+    size_t get_num_time_steps() const { return num_time_steps; }
+};
+
+/**
+ * A cache for per-obstacle and per-time-step values stored in flat arrays.
+ *
+ * Each slot of the index holds Width values, e.g. one for each turning direction. Presence is tracked in bitmaps, so a
+ * cache hit is a single atomic load and an array access. Like parallel::ConcurrentCache, the cache can be used from
+ * multiple threads concurrently and computes each value at most once. Keys outside of the index are computed on every
+ * request without being cached.
+ *
+ * @tparam T The type of the cached values.
+ * @tparam Width The number of values per slot.
+ */
+template <typename T, size_t Width = 1> class DenseObstacleCache {
+  private:
+    static constexpr size_t bits_per_word = 64;
+
+    // The values of all time steps of a single obstacle
+    struct Column {
+        std::vector<T> values;
+        std::vector<std::atomic<uint64_t>> claimed;
+        std::vector<std::atomic<uint64_t>> ready;
+
+        explicit Column(size_t num_values)
+            : values(num_values), claimed((num_values + bits_per_word - 1) / bits_per_word),
+              ready((num_values + bits_per_word - 1) / bits_per_word) {}
+    };
+
+    std::shared_ptr<const ObstacleTimeIndex> index;
+    size_t column_size;
+    size_t num_values;
+
+    // Each column is allocated when the first value of its obstacle is inserted, so that memory only grows with the
+    // obstacles whose values are cached locally and not, e.g., with those found in a SharedWorldCache. Owned by the
+    // cache, a column is never replaced once it is set.
+    std::vector<std::atomic<Column *>> columns;
+
+    /**
+     * Get a column if it is allocated.
+     *
+     * @param column_index The index of the column.
+     * @return The column or nullptr.
+     */
+    const Column *find_column(size_t column_index) const {
+        return columns[column_index].load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get a column, allocating it if no value of the obstacle has been inserted yet.
+     *
+     * @param column_index The index of the column.
+     * @return The column.
+     */
+    Column &get_column(size_t column_index) {
+        auto *column = columns[column_index].load(std::memory_order_acquire);
+        if (column != nullptr) {
+            return *column;
+        }
+        auto allocated = std::make_unique<Column>(column_size);
+        // If another thread allocated the column in the meantime, ours is dropped and theirs is used
+        if (columns[column_index].compare_exchange_strong(column, allocated.get(), std::memory_order_acq_rel,
+                                                          std::memory_order_acquire)) {
+            return *allocated.release();
+        }
+        return *column;
+    }
+
+  public:
+    /**
+     * Create an empty cache, the values of an obstacle are only allocated when its first one is inserted.
+     *
+     * @param index The index mapping time steps and obstacles to slots.
+     */
+    explicit DenseObstacleCache(std::shared_ptr<const ObstacleTimeIndex> index)
+        : index(std::move(index)), column_size(this->index->get_num_time_steps() * Width),
+          num_values(this->index->get_num_slots() * Width), columns(this->index->get_num_obstacles()) {}
+
+    DenseObstacleCache(const DenseObstacleCache &) = delete;
+    DenseObstacleCache &operator=(const DenseObstacleCache &) = delete;
+
+    ~DenseObstacleCache() {
+        for (auto &column : columns) {
+            delete column.load(std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * Get the cached value or compute it if it is not cached yet.
+     *
+     * If the computation throws, the value stays absent and the next request retries the computation.
+     *
+     * @param time_step The time step.
+     * @param obstacle_id The ID of the obstacle.
+     * @param sub_index The index of the value within the slot, must be less than Width.
+     * @param compute A callable returning the value.
+     * @return The value.
+     */
+    template <typename Compute>
+    T get_or_compute(time_step_t time_step, size_t obstacle_id, size_t sub_index, Compute &&compute) {
+        auto maybe_position = get_position(time_step, obstacle_id, sub_index);
+        if (!maybe_position.has_value()) {
+            return compute();
+        }
+
+        auto position = maybe_position.value();
+        auto column_index = position / column_size;
+        auto offset = position % column_size;
+        auto word = offset / bits_per_word;
+        auto mask = uint64_t{1} << (offset % bits_per_word);
+
+        // Hits never allocate
+        if (const auto *column = find_column(column_index);
+            column != nullptr && (column->ready[word].load(std::memory_order_acquire) & mask) != 0) {
+            return column->values[offset];
+        }
+
+        auto &[values, claimed, ready] = get_column(column_index);
+        while (true) {
+            if ((ready[word].load(std::memory_order_acquire) & mask) != 0) {
+                return values[offset];
+            }
+            if ((claimed[word].fetch_or(mask, std::memory_order_acq_rel) & mask) == 0) {
+                try {
+                    values[offset] = compute();
+                } catch (...) {
+                    claimed[word].fetch_and(~mask, std::memory_order_release);
+                    throw;
+                }
+                ready[word].fetch_or(mask, std::memory_order_release);
+                return values[offset];
+            }
+            // Another thread is computing this value, computations are short so we do not block
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Get the cached value or compute it if it is not cached yet.
+     *
+     * @param time_step The time step.
+     * @param obstacle_id The ID of the obstacle.
+     * @param compute A callable returning the value.
+     * @return The value.
+     */
+    template <typename Compute> T get_or_compute(time_step_t time_step, size_t obstacle_id, Compute &&compute) {
+        return get_or_compute(time_step, obstacle_id, 0, std::forward<Compute>(compute));
+    }
+
+    /**
+     * Get the position of a value, which identifies it across caches with the same index.
+     *
+     * @param time_step The time step.
+     * @param obstacle_id The ID of the obstacle.
+     * @param sub_index The index of the value within the slot, must be less than Width.
+     * @return The position or std::nullopt if the key is outside of the index.
+     */
+    std::optional<size_t> get_position(time_step_t time_step, size_t obstacle_id, size_t sub_index = 0) const {
+        auto slot = index->get_slot(time_step, obstacle_id);
+        if (!slot.has_value()) {
+            return std::nullopt;
+        }
+        return (slot.value() * Width) + sub_index;
+    }
+
+    /**
+     * Get the number of values that the cache can hold, i.e., the number of slots times Width.
+     *
+     * @return The number of values.
+     */
+    size_t get_num_values() const { return num_values; }
+
+    /**
+     * Get the number of obstacles whose values have been allocated, which happens when their first one is inserted.
+     *
+     * @return The number of allocated columns.
+     */
+    size_t get_num_allocated_columns() const {
+        return static_cast<size_t>(std::ranges::count_if(
+            columns, [](const auto &column) { return column.load(std::memory_order_acquire) != nullptr; }));
+    }
+
+    /**
+     * Call the given function for each cached value in ascending order of position.
+     *
+     * Values that are computed concurrently may or may not be visited.
+     *
+     * @param visit A callable taking the position, see get_position, and the value.
+     */
+    template <typename Visit> void for_each_value(Visit &&visit) const {
+        for (size_t column_index = 0; column_index < columns.size(); ++column_index) {
+            const auto *column = find_column(column_index);
+            if (column == nullptr) {
+                continue;
+            }
+            for (size_t word = 0; word < column->ready.size(); ++word) {
+                for (auto bits = column->ready[word].load(std::memory_order_acquire); bits != 0; bits &= bits - 1) {
+                    auto offset = (word * bits_per_word) + static_cast<size_t>(std::countr_zero(bits));
+                    visit((column_index * column_size) + offset, column->values[offset]);
+                }
+            }
+        }
+    }
+
+    /**
+     * Insert a value that was computed before, e.g. by another process.
+     *
+     * @param position The position of the value, see get_position.
+     * @param value The value.
+     * @return False iff the position is out of range or the value is already cached or being computed.
+     */
+    bool restore(size_t position, T value) {
+        if (position >= num_values) {
+            return false;
+        }
+        auto offset = position % column_size;
+        auto word = offset / bits_per_word;
+        auto mask = uint64_t{1} << (offset % bits_per_word);
+        auto &[values, claimed, ready] = get_column(position / column_size);
+        if ((claimed[word].fetch_or(mask, std::memory_order_acq_rel) & mask) != 0) {
+            return false;
+        }
+        values[offset] = std::move(value);
+        ready[word].fetch_or(mask, std::memory_order_release);
+        return true;
+    }
+};
+} // namespace knowledge_extraction::env_model
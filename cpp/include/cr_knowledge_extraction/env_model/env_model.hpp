@@ -2,61 +2,84 @@
 
 #include "cr_knowledge_extraction/ego_behavior/behavior_overapproximation.hpp"
 #include "cr_knowledge_extraction/ego_behavior/ego_params.hpp"
+#include "cr_knowledge_extraction/env_model/curvilinear_cache.hpp"
+#include "cr_knowledge_extraction/env_model/world_cache.hpp"
 
-#include <boost/functional/hash.hpp>
 #include <commonroad_cpp/predicates/predicate_parameter_collection.h>
 #include <commonroad_cpp/world.h>
 #include <geometry/curvilinear_coordinate_system.h>
+
+#include <cstdint>
+#include <mutex>
+#include <span>
 #include <utility>
 
 namespace knowledge_extraction::env_model {
 class EnvironmentModel {
   private:
-    const std::shared_ptr<World> world;
-    const std::shared_ptr<geometry::CurvilinearCoordinateSystem> ego_ccs;
-    const ego_behavior::EgoParameters ego_params;
+    // Caches that do not depend on the ego vehicle, possibly shared with the models of other ego hypotheses
+    const std::shared_ptr<WorldCache> world_cache;
+    const std::shared_ptr<CurvilinearCache> ccs_cache;
+
+    // Only the initial state changes when the model is advanced to the next planning cycle
+    ego_behavior::EgoParameters ego_params;
     PredicateParameters predicate_params;
 
-    const std::shared_ptr<ego_behavior::BehaviorOverapproximation> ego_approximations;
+    std::shared_ptr<ego_behavior::BehaviorOverapproximation> ego_approximations;
     static std::shared_ptr<ego_behavior::BehaviorOverapproximation>
-    make_ego_approximations(const std::shared_ptr<World> &world,
-                            const std::shared_ptr<geometry::CurvilinearCoordinateSystem> &ego_ccs,
-                            ego_behavior::EgoParameters ego_params);
-
-    template <typename T> using ObstacleCache =
-        std::unordered_map<std::pair<time_step_t, size_t>, T, boost::hash<std::pair<time_step_t, size_t>>>;
-
-    ObstacleCache<std::optional<double>> obstacle_rear_cache;
-    std::optional<double> get_obstacle_rear_impl(size_t time_step, const std::shared_ptr<Obstacle> &obstacle) const;
-
-    ObstacleCache<std::optional<std::set<size_t>>> obstacle_lane_ids_cache;
-    std::optional<std::set<size_t>> get_obstacle_lane_ids_impl(size_t time_step,
-                                                               const std::shared_ptr<Obstacle> &obstacle) const;
-
-    ObstacleCache<std::optional<double>> stopping_s_cache;
-    std::optional<double> get_stopping_s_impl(size_t time_step, const std::shared_ptr<Obstacle> &obstacle);
-
-    std::unordered_map<size_t, std::unordered_set<Direction>> turning_directions_cache;
-    std::unordered_set<Direction> get_turning_directions_impl(const std::shared_ptr<Obstacle> &obstacle);
-
-    std::unordered_map<std::tuple<time_step_t, size_t, Direction>, std::optional<int>,
-                       boost::hash<std::tuple<time_step_t, size_t, Direction>>>
-        priority_cache;
+    make_ego_approximations(double dt, const CurvilinearCache &ccs_cache, ego_behavior::EgoParameters ego_params);
 
   public:
     /**
      * Create a wrapper around the given world to cache results that are needed often.
      *
+     * All getters may be called from multiple threads concurrently, each cached result is computed only once.
+     *
      * @param world The C++ world object corresponding to the CommonRoad scenario.
      * @param ego_ccs The curvilinear coordinate system of the ego vehicle.
      * @param ego_params The configuration parameters of the ego vehicle.
      * @param predicate_params The traffic rule predicate parameters.
      */
     EnvironmentModel(std::shared_ptr<World> world, std::shared_ptr<geometry::CurvilinearCoordinateSystem> ego_ccs,
-                     const ego_behavior::EgoParameters &ego_params, PredicateParameters predicate_params)
-        : world(std::move(world)), ego_ccs(std::move(ego_ccs)), ego_params(ego_params),
-          predicate_params(std::move(predicate_params)),
-          ego_approximations(make_ego_approximations(this->world, this->ego_ccs, this->ego_params)) {}
+                     const ego_behavior::EgoParameters &ego_params, PredicateParameters predicate_params);
+
+    /**
+     * Create an environment model that shares all ego-independent caches with other models.
+     *
+     * This is used to evaluate several ego hypotheses in the same world, the hypotheses may use the same or different
+     * CCSs as long as all caches belong to the same world.
+     *
+     * @param ccs_cache The cache of the curvilinear coordinate system of the ego vehicle.
+     * @param ego_params The configuration parameters of the ego vehicle.
+     * @param predicate_params The traffic rule predicate parameters.
+     */
+    EnvironmentModel(std::shared_ptr<CurvilinearCache> ccs_cache, const ego_behavior::EgoParameters &ego_params,
+                     PredicateParameters predicate_params);
+
+    /**
+     * Get the cache of all results that only depend on the world.
+     *
+     * @return The world cache.
+     */
+    const std::shared_ptr<WorldCache> &get_world_cache() const { return world_cache; }
+
+    /**
+     * Get the cache of all results that only depend on the world and the CCS of the ego vehicle.
+     *
+     * @return The CCS cache.
+     */
+    const std::shared_ptr<CurvilinearCache> &get_ccs_cache() const { return ccs_cache; }
+
+    /**
+     * Move the ego vehicle to a new initial state, e.g. for the next cycle of a receding-horizon planner.
+     *
+     * Only the ego behavior approximation is recomputed, all caches that do not depend on the ego vehicle are kept.
+     * Must not be called while knowledge is extracted, and references to the previous ego approximations stay valid
+     * but keep describing the previous initial state.
+     *
+     * @param new_initial_state The new initial state of the ego vehicle in Cartesian coordinates.
+     */
+    void advance(const State &new_initial_state);
 
     /**
      * Get the behavior approximation of the ego vehicle.
@@ -72,14 +95,54 @@ class EnvironmentModel {
      *
      * @return The curvilinear coordinate system.
      */
-    const std::shared_ptr<geometry::CurvilinearCoordinateSystem> &get_ego_ccs() const { return ego_ccs; }
+    const std::shared_ptr<geometry::CurvilinearCoordinateSystem> &get_ego_ccs() const { return ccs_cache->get_ccs(); }
 
     /**
      * Get the C++ world object corresponding to the CommonRoad scenario
      *
      * @return The world object.
      */
-    const std::shared_ptr<World> &get_world() const { return world; }
+    const std::shared_ptr<World> &get_world() const { return world_cache->get_world(); }
+
+    /**
+     * Get the obstacles with the given IDs in the order of the world, without scanning all obstacles of the world.
+     *
+     * @param obstacle_ids The IDs of the obstacles, std::nullopt (the ego vehicle) and unknown IDs are skipped.
+     * @return The obstacles.
+     */
+    std::vector<std::shared_ptr<Obstacle>>
+    get_obstacles(const std::unordered_set<std::optional<size_t>> &obstacle_ids) const {
+        return world_cache->get_obstacles(obstacle_ids);
+    }
+
+    /**
+     * Get the obstacles with the given IDs in the order of the world, without scanning all obstacles of the world.
+     *
+     * @param obstacle_ids The IDs of the obstacles, unknown IDs are skipped.
+     * @return The obstacles.
+     */
+    std::vector<std::shared_ptr<Obstacle>> get_obstacles(const std::unordered_set<size_t> &obstacle_ids) const {
+        return world_cache->get_obstacles(obstacle_ids);
+    }
+
+    /**
+     * Get the relevant obstacles of a single time step of a relevance matrix in the order of the world.
+     *
+     * @param relevant_obstacles The row of the relevance matrix, the ego vehicle is skipped.
+     * @return The obstacles.
+     */
+    std::vector<std::shared_ptr<Obstacle>> get_obstacles(const RelevanceMatrix::Row &relevant_obstacles) const {
+        return world_cache->get_obstacles(relevant_obstacles);
+    }
+
+    /**
+     * Get the types, adjacency flags, incoming groups, and priorities of all lanelets of the road network.
+     *
+     * @return The lanelet attribute table.
+     */
+    const road_network::LaneletAttributeTable &get_lanelet_attributes() const {
+        return *world_cache->get_lanelet_attributes();
+    }
 
     /**
      * Get the configuration parameters of the ego vehicle.
@@ -95,6 +158,17 @@ class EnvironmentModel {
      */
     PredicateParameters &get_predicate_params() { return predicate_params; }
 
+    /**
+     * Lock the world for exclusive access.
+     *
+     * Extractors must hold this lock while calling into CommonRoad obstacles, predicates, or the road network, since
+     * these are not safe to use from multiple threads concurrently. The getters of this model and of the ego
+     * approximations must not be called while holding the lock, as they might wait for another thread that needs it.
+     *
+     * @return The held lock.
+     */
+    std::unique_lock<std::recursive_mutex> lock_world() const { return world_cache->lock_world(); }
+
     /**
      * Get the rear-most s-coordinate of the given obstacle in the CCS of the ego vehicle.
      *
@@ -103,16 +177,22 @@ class EnvironmentModel {
      * @return The rear-most s-coordinate at the given time step or std::nullopt if the coordinate conversion is not
      *     possible.
      */
-    std::optional<double> get_obstacle_rear(size_t time_step, const std::shared_ptr<Obstacle> &obstacle);
+    std::optional<double> get_obstacle_rear(size_t time_step, const std::shared_ptr<Obstacle> &obstacle) {
+        return ccs_cache->get_obstacle_rear(time_step, obstacle);
+    }
 
     /**
      * Get the IDs of the lanelets that the obstacle occupies at the given time step.
      *
      * @param time_step The time step.
      * @param obstacle The obstacle.
-     * @return The set of occupied lanelet IDs or std::nullopt if there was an error getting the lanelets.
+     * @return The occupied lanelet IDs in ascending order, valid for the lifetime of the world cache, or std::nullopt
+     *     if there was an error getting the lanelets.
      */
-    std::optional<std::set<size_t>> get_obstacle_lane_ids(size_t time_step, const std::shared_ptr<Obstacle> &obstacle);
+    std::optional<std::span<const uint64_t>> get_obstacle_lane_ids(size_t time_step,
+                                                                   const std::shared_ptr<Obstacle> &obstacle) {
+        return world_cache->get_obstacle_lane_ids(time_step, obstacle);
+    }
 
     /**
      * Get the rear s-coordinate at which the obstacle would stop if it were to fully brake.
@@ -123,7 +203,21 @@ class EnvironmentModel {
      * @param obstacle The obstacle.
      * @return The s-coordinate of std::nullopt if the coordinate conversion is not possible.
      */
-    std::optional<double> get_stopping_s(size_t time_step, const std::shared_ptr<Obstacle> &obstacle);
+    std::optional<double> get_stopping_s(size_t time_step, const std::shared_ptr<Obstacle> &obstacle) {
+        return ccs_cache->get_stopping_s(time_step, obstacle);
+    }
+
+    /**
+     * Get the intersection and incoming lanelets of the reference lane of an obstacle.
+     *
+     * @param time_step The time step.
+     * @param obstacle The obstacle.
+     * @return The lanelets or nullptr if the obstacle has no reference lane at the time step.
+     */
+    const ReferenceLaneLanelets *get_reference_lane_lanelets(size_t time_step,
+                                                             const std::shared_ptr<Obstacle> &obstacle) {
+        return world_cache->get_reference_lane_lanelets(time_step, obstacle);
+    }
 
     /**
      * Get the possible turning directions of an obstacle.
@@ -133,7 +227,19 @@ class EnvironmentModel {
      * @param obstacle The obstacle.
      * @return The possible turning directions.
      */
-    const std::unordered_set<Direction> &get_turning_directions(const std::shared_ptr<Obstacle> &obstacle);
+    const std::unordered_set<Direction> &get_turning_directions(const std::shared_ptr<Obstacle> &obstacle) {
+        return world_cache->get_turning_directions(obstacle);
+    }
+
+    /**
+     * Get the lanelets that have a traffic sign of the given type.
+     *
+     * @param traffic_sign_type The type of the traffic sign.
+     * @return The lanelets as set over the indices of the lanelet attribute table.
+     */
+    const road_network::LaneletSet &get_lanelets_with_traffic_sign(TrafficSignTypes traffic_sign_type) {
+        return world_cache->get_lanelets_with_traffic_sign(traffic_sign_type);
+    }
 
     /**
      * Get the priority of the obstacle for the given turning direction.
@@ -143,6 +249,8 @@ class EnvironmentModel {
      * @param dir The turning direction.
      * @return The priority or std::nullopt if there was an error when determining the priorities.
      */
-    std::optional<int> get_priority(size_t time_step, const std::shared_ptr<Obstacle> &obstacle, Direction dir);
+    std::optional<int> get_priority(size_t time_step, const std::shared_ptr<Obstacle> &obstacle, Direction dir) {
+        return world_cache->get_priority(time_step, obstacle, dir);
+    }
 };
 } // namespace knowledge_extraction::env_model
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "cr_knowledge_extraction/env_model/dense_obstacle_cache.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace knowledge_extraction::env_model {
+/**
+ * The obstacles for which a proposition is relevant at each time step.
+ *
+ * Each time step is a row of bits, one for each obstacle at its compact index in the ObstacleTimeIndex of the world,
+ * and a separate flag for the ego vehicle. Rows are stored contiguously for a range of consecutive time steps, thus
+ * iterating the relevant obstacles is a bit scan and ranges of time steps can be copied cheaply, e.g. to split the
+ * extraction into tasks. Iteration skips time steps without any relevant obstacle.
+ */
+class RelevanceMatrix {
+  private:
+    static constexpr size_t bits_per_word = 64;
+
+    std::shared_ptr<const ObstacleTimeIndex> index;
+    size_t words_per_row;
+
+    // The rows cover the time steps [first_time_step, first_time_step + ego_flags.size())
+    time_step_t first_time_step{0};
+    std::vector<uint64_t> obstacle_bits;
+    std::vector<uint8_t> ego_flags;
+
+    size_t get_num_rows() const { return ego_flags.size(); }
+
+    /**
+     * Find the row of a time step.
+     *
+     * @param time_step The time step.
+     * @return The row or std::nullopt if the time step is not covered by the rows.
+     */
+    std::optional<size_t> find_row(time_step_t time_step) const;
+
+    /**
+     * Get the row of a time step, adding empty rows if the time step is not covered yet.
+     *
+     * @param time_step The time step.
+     * @return The row.
+     */
+    size_t get_or_add_row(time_step_t time_step);
+
+    bool is_row_empty(size_t row) const;
+
+  public:
+    /**
+     * The relevant obstacles at a single time step, a view into the matrix.
+     */
+    class Row {
+      private:
+        std::span<const uint64_t> words;
+        bool ego;
+
+      public:
+        Row(std::span<const uint64_t> words, bool ego) : words(words), ego(ego) {}
+
+        /**
+         * Check whether the proposition is relevant for the ego vehicle.
+         *
+         * @return True iff the ego vehicle is relevant.
+         */
+        bool contains_ego() const { return ego; }
+
+        /**
+         * Check whether the proposition is relevant for an obstacle.
+         *
+         * @param obstacle_index The compact index of the obstacle.
+         * @return True iff the obstacle is relevant.
+         */
+        bool contains(size_t obstacle_index) const {
+            auto word = obstacle_index / bits_per_word;
+            return word < words.size() && ((words[word] >> (obstacle_index % bits_per_word)) & 1U) != 0;
+        }
+
+        /**
+         * Get the number of relevant obstacles, including the ego vehicle.
+         *
+         * @return The number of relevant obstacles.
+         */
+        size_t size() const;
+
+        /**
+         * Call the given function with the compact index of each relevant obstacle in ascending order.
+         *
+         * The ego vehicle is not visited.
+         *
+         * @param visit A callable taking the index of an obstacle.
+         */
+        template <typename Visit> void for_each_obstacle_index(Visit &&visit) const {
+            for (size_t word = 0; word < words.size(); ++word) {
+                for (auto bits = words[word]; bits != 0; bits &= bits - 1) {
+                    visit((word * bits_per_word) + static_cast<size_t>(std::countr_zero(bits)));
+                }
+            }
+        }
+
+        /**
+         * Get the compact indices of all relevant obstacles, without the ego vehicle.
+         *
+         * @return The indices in ascending order.
+         */
+        std::vector<size_t> get_obstacle_indices() const;
+    };
+
+    /**
+     * Iterates the time steps with at least one relevant obstacle in ascending order.
+     */
+    class Iterator {
+      private:
+        const RelevanceMatrix *matrix{nullptr};
+        size_t row{0};
+
+        void skip_empty_rows() {
+            while (row < matrix->get_num_rows() && matrix->is_row_empty(row)) {
+                ++row;
+            }
+        }
+
+      public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = std::pair<time_step_t, Row>;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        Iterator(const RelevanceMatrix *matrix, size_t row) : matrix(matrix), row(row) { skip_empty_rows(); }
+
+        value_type operator*() const { return {matrix->first_time_step + row, matrix->get_row(row)}; }
+
+        Iterator &operator++() {
+            ++row;
+            skip_empty_rows();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const { return row == other.row; }
+    };
+
+    /**
+     * Create an empty matrix.
+     *
+     * @param index The index of the world, which assigns the compact obstacle indices.
+     */
+    explicit RelevanceMatrix(std::shared_ptr<const ObstacleTimeIndex> index);
+
+    /**
+     * Create a matrix from sets of obstacle IDs.
+     *
+     * @param index The index of the world, which assigns the compact obstacle indices.
+     * @param relevant_obstacle_ids_over_time Map of time steps to relevant obstacle IDs, std::nullopt indicates the
+     *     ego vehicle. Obstacles that are not part of the index are skipped.
+     */
+    RelevanceMatrix(
+        std::shared_ptr<const ObstacleTimeIndex> index,
+        const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time);
+
+    /**
+     * Mark the proposition as relevant for an obstacle at a time step.
+     *
+     * @param time_step The time step.
+     * @param obstacle_id The ID of the obstacle, std::nullopt indicates the ego vehicle.
+     * @return False iff the obstacle is not part of the index and thus cannot be marked.
+     */
+    bool insert(time_step_t time_step, std::optional<size_t> obstacle_id);
+
+    /**
+     * Mark the proposition as irrelevant for an obstacle at a time step.
+     *
+     * @param time_step The time step.
+     * @param obstacle_id The ID of the obstacle, std::nullopt indicates the ego vehicle.
+     */
+    void erase(time_step_t time_step, std::optional<size_t> obstacle_id);
+
+    /**
+     * Check whether the proposition is relevant for an obstacle at a time step.
+     *
+     * @param time_step The time step.
+     * @param obstacle_id The ID of the obstacle, std::nullopt indicates the ego vehicle.
+     * @return True iff the obstacle is relevant.
+     */
+    bool contains(time_step_t time_step, std::optional<size_t> obstacle_id) const;
+
+    /**
+     * Get the relevant obstacles at a single time step.
+     *
+     * @param row The row of the time step, relative to the first time step of the matrix.
+     * @return A view of the row, which is invalidated by modifications of the matrix.
+     */
+    Row get_row(size_t row) const {
+        return Row{std::span{obstacle_bits}.subspan(row * words_per_row, words_per_row), ego_flags[row] != 0};
+    }
+
+    /**
+     * Check whether the proposition is irrelevant for all obstacles at all time steps.
+     *
+     * @return True iff nothing is relevant.
+     */
+    bool empty() const { return begin() == end(); }
+
+    /**
+     * Get the number of time steps with at least one relevant obstacle.
+     *
+     * @return The number of time steps.
+     */
+    size_t count_time_steps() const;
+
+    /**
+     * Get the last time step with at least one relevant obstacle.
+     *
+     * @return The time step or std::nullopt if the matrix is empty.
+     */
+    std::optional<time_step_t> get_last_time_step() const;
+
+    /**
+     * Get the compact indices of all obstacles that are relevant at any time step, without the ego vehicle.
+     *
+     * @return The indices in ascending order.
+     */
+    std::vector<size_t> get_obstacle_indices() const;
+
+    /**
+     * Move all time steps by the same offset, without touching the rows.
+     *
+     * @param old_origin A time step before the move.
+     * @param new_origin The time step that the old origin is moved to.
+     */
+    void move_time_steps(time_step_t old_origin, time_step_t new_origin) {
+        first_time_step = first_time_step - old_origin + new_origin;
+    }
+
+    /**
+     * Copy the rows of a range of time steps into a new matrix.
+     *
+     * @param begin The first time step of the range.
+     * @param end The time step after the last one of the range.
+     * @return The matrix containing only the given time steps.
+     */
+    RelevanceMatrix slice(time_step_t begin, time_step_t end) const;
+
+    /**
+     * Split the matrix into chunks of consecutive time steps.
+     *
+     * @param time_steps_per_chunk The maximum number of time steps with relevant obstacles in each chunk.
+     * @return The chunks, ordered by time step.
+     */
+    std::vector<RelevanceMatrix> split(size_t time_steps_per_chunk) const;
+
+    Iterator begin() const { return Iterator{this, 0}; }
+
+    Iterator end() const { return Iterator{this, get_num_rows()}; }
+};
+} // namespace knowledge_extraction::env_model
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace knowledge_extraction::env_model {
+/**
+ * Read-only results of a WorldCache in a named shared memory segment.
+ *
+ * A parent process fills its world cache once and publishes it, worker processes on the same scenario attach their
+ * world caches to the segment by name. The values are stored in sorted flat arrays and looked up in place, so the
+ * workers neither compute nor copy them, and memory use does not grow with the number of workers.
+ *
+ * All values are stored in native byte order, thus only processes on the same machine can share a segment.
+ */
+class SharedWorldCache {
+  public:
+    struct Header {
+        std::array<char, 8> magic;
+        uint64_t version;
+        uint64_t scenario_hash;
+        uint64_t layout_hash;
+        uint64_t num_priorities;
+        uint64_t num_lane_id_sets;
+        uint64_t num_lane_ids;
+        uint64_t num_turning_directions;
+    };
+
+    struct PriorityRecord {
+        uint64_t position;
+        int32_t priority;
+        uint32_t has_priority;
+    };
+
+    struct LaneIdsRecord {
+        uint64_t position;
+        // The IDs are lane_ids[first_id, first_id + num_ids)
+        uint64_t first_id;
+        uint64_t num_ids;
+        uint64_t has_ids;
+    };
+
+    struct TurningDirectionsRecord {
+        uint64_t obstacle_id;
+        uint64_t directions;
+    };
+
+    /**
+     * Collects the values of a world cache and lays them out for a segment.
+     */
+    class Builder {
+      private:
+        std::vector<PriorityRecord> priorities;
+        std::vector<LaneIdsRecord> lane_id_sets;
+        std::vector<uint64_t> lane_ids;
+        std::vector<TurningDirectionsRecord> turning_directions;
+
+      public:
+        /**
+         * Add the priority at a position of the dense priority cache.
+         *
+         * @param position The position as passed by DenseObstacleCache::for_each_value.
+         * @param priority The priority.
+         */
+        void add_priority(size_t position, std::optional<int> priority);
+
+        /**
+         * Add the occupied lanelets at a position of the dense lanelet ID cache.
+         *
+         * @param position The position as passed by DenseObstacleCache::for_each_value.
+         * @param ids The lanelet IDs in ascending order.
+         */
+        void add_lane_ids(size_t position, std::optional<std::span<const uint64_t>> ids);
+
+        /**
+         * Add the turning directions of an obstacle.
+         *
+         * @param obstacle_id The ID of the obstacle.
+         * @param directions The directions as bitmask, the encoding is up to the world cache.
+         */
+        void add_turning_directions(size_t obstacle_id, uint64_t directions);
+
+        /**
+         * Lay out all added values.
+         *
+         * @param scenario_hash The hash of the content of the scenario.
+         * @param layout_hash The hash of the layout of the dense caches.
+         * @return The content of the segment.
+         */
+        std::string build(uint64_t scenario_hash, uint64_t layout_hash);
+    };
+
+  private:
+    struct Segment;
+
+    std::string name;
+    bool owner;
+    std::unique_ptr<Segment> segment;
+
+    Header header{};
+    std::span<const PriorityRecord> priorities;
+    std::span<const LaneIdsRecord> lane_id_sets;
+    std::span<const uint64_t> lane_ids;
+    std::span<const TurningDirectionsRecord> turning_directions;
+
+    SharedWorldCache(std::string name, bool owner, std::unique_ptr<Segment> segment);
+
+  public:
+    SharedWorldCache(const SharedWorldCache &) = delete;
+    SharedWorldCache &operator=(const SharedWorldCache &) = delete;
+    ~SharedWorldCache();
+
+    /**
+     * Create a segment, which is removed when the returned object is destroyed.
+     *
+     * Processes that attached to the segment before keep their mapping, later attempts to open it fail.
+     *
+     * @param name The name of the segment, must not contain slashes.
+     * @param content The content from Builder::build.
+     * @return The segment.
+     * @throws std::runtime_error If the segment cannot be created, e.g. because the name is taken.
+     */
+    static std::shared_ptr<SharedWorldCache> create(const std::string &name, const std::string &content);
+
+    /**
+     * Map an existing segment read-only.
+     *
+     * @param name The name of the segment.
+     * @return The segment.
+     * @throws std::runtime_error If the segment does not exist or does not contain a valid world cache.
+     */
+    static std::shared_ptr<SharedWorldCache> open(const std::string &name);
+
+    /**
+     * Get the name of the segment.
+     *
+     * @return The name.
+     */
+    const std::string &get_name() const { return name; }
+
+    /**
+     * Get the hash of the content of the scenario that the values belong to.
+     *
+     * @return The hash.
+     */
+    uint64_t get_scenario_hash() const { return header.scenario_hash; }
+
+    /**
+     * Get the hash of the layout of the dense caches that the positions refer to.
+     *
+     * @return The hash.
+     */
+    uint64_t get_layout_hash() const { return header.layout_hash; }
+
+    /**
+     * Look up a priority.
+     *
+     * @param position The position in the dense priority cache.
+     * @return The priority or std::nullopt if it is not part of the segment.
+     */
+    std::optional<std::optional<int>> find_priority(size_t position) const;
+
+    /**
+     * Look up the occupied lanelets.
+     *
+     * @param position The position in the dense lanelet ID cache.
+     * @return The lanelet IDs in ascending order, which are read in place and valid for the lifetime of the segment,
+     *     or std::nullopt if they are not part of the segment.
+     */
+    std::optional<std::optional<std::span<const uint64_t>>> find_lane_ids(size_t position) const;
+
+    /**
+     * Look up the turning directions of an obstacle.
+     *
+     * @param obstacle_id The ID of the obstacle.
+     * @return The directions as bitmask or std::nullopt if they are not part of the segment.
+     */
+    std::optional<uint64_t> find_turning_directions(size_t obstacle_id) const;
+};
+} // namespace knowledge_extraction::env_model
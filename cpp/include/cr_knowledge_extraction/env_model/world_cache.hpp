@@ -0,0 +1,338 @@
+#pragma once
+
+#include "cr_knowledge_extraction/env_model/dense_obstacle_cache.hpp"
+#include "cr_knowledge_extraction/env_model/relevance_matrix.hpp"
+#include "cr_knowledge_extraction/env_model/shared_world_cache.hpp"
+#include "cr_knowledge_extraction/parallel/concurrent_cache.hpp"
+#include "cr_knowledge_extraction/road_network/lanelet_attribute_table.hpp"
+#include "cr_knowledge_extraction/statistics.hpp"
+
+#include <commonroad_cpp/roadNetwork/regulatoryElements/traffic_sign.h>
+#include <commonroad_cpp/world.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace knowledge_extraction::env_model {
+/**
+ * The lanelets of the reference lane of an obstacle that the intersection extractors need.
+ */
+struct ReferenceLaneLanelets {
+    // Both in ascending order without duplicates
+    std::vector<size_t> intersection_lanelet_ids;
+    std::vector<size_t> incoming_lanelet_ids;
+
+    auto operator<=>(const ReferenceLaneLanelets &) const = default;
+};
+
+/**
+ * Caches results that only depend on the world, i.e., neither on the ego vehicle nor on its CCS.
+ *
+ * A single instance can be shared by the environment models of several ego hypotheses in the same world, so that this
+ * work is only done once. All getters may be called from multiple threads concurrently.
+ */
+class WorldCache {
+  private:
+    const std::shared_ptr<World> world;
+
+    // The CommonRoad objects lazily compute and cache intermediate results without synchronization,
+    // thus all accesses to the world are serialized
+    mutable std::recursive_mutex world_mutex;
+
+    // Statistics of all extractions in this world, shared by all models using this cache
+    const std::shared_ptr<StatisticsCollector> statistics;
+
+    // Dense slots for all pairs of scenario time steps and obstacles, shared by the caches below
+    const std::shared_ptr<const ObstacleTimeIndex> obstacle_time_index;
+
+    // The obstacles of the world at their dense index, which is their position in the world
+    const std::vector<std::shared_ptr<Obstacle>> obstacles_by_index;
+
+    // Types, adjacency flags, incoming groups, priorities, and lanes of all lanelets of the road network, computed once
+    const std::shared_ptr<const road_network::LaneletAttributeTable> lanelet_attributes;
+
+    // The lanelets with a traffic sign of each type, computed when the type is first requested
+    parallel::ConcurrentCache<TrafficSignTypes, road_network::LaneletSet> traffic_sign_lanelets_cache;
+
+    // Lanelet IDs in ascending order, equal ones are stored once. Guarded by world_mutex.
+    mutable std::set<std::vector<uint64_t>> interned_lane_ids;
+    const std::vector<uint64_t> *intern_lane_ids(std::vector<uint64_t> lane_ids) const;
+
+    // The IDs of the lanelets of the lanes through the occupied lanelets, merged from the lanelet attribute table, or
+    // nullptr if there was an error getting the lanelets
+    DenseObstacleCache<const std::vector<uint64_t> *> obstacle_lane_ids_cache;
+    const std::vector<uint64_t> *get_obstacle_lane_ids_impl(size_t time_step,
+                                                            const std::shared_ptr<Obstacle> &obstacle) const;
+
+    parallel::ConcurrentCache<size_t, std::unordered_set<Direction>> turning_directions_cache;
+    std::unordered_set<Direction> get_turning_directions_impl(const std::shared_ptr<Obstacle> &obstacle);
+
+    // Reference lanes rarely change between time steps, thus equal ones are stored once. Guarded by world_mutex.
+    mutable std::set<ReferenceLaneLanelets> interned_reference_lanes;
+
+    // The time steps for which a reference lane of an obstacle is used
+    struct ReferenceLaneInterval {
+        size_t first_time_step;
+        size_t last_time_step;
+        // The interned lanelets or nullptr if there was an error getting the reference lane
+        const ReferenceLaneLanelets *lanelets;
+        // Both in ascending order, the occupied lanelets are std::nullopt if there was an error getting them
+        std::vector<uint64_t> lane_lanelet_ids;
+        std::optional<std::vector<uint64_t>> occupied_lanelet_ids;
+
+        // Whether the occupied lanelets are the ones the lane was computed for or are all part of the lane
+        bool is_valid_for(const std::optional<std::vector<uint64_t>> &lanelet_ids) const;
+    };
+    // Disjoint intervals in ascending order at the dense index of the obstacle. Guarded by reference_lane_mutex, which
+    // is only locked exclusively while holding world_mutex.
+    mutable std::shared_mutex reference_lane_mutex;
+    std::vector<std::vector<ReferenceLaneInterval>> reference_lane_intervals;
+    std::optional<const ReferenceLaneLanelets *> find_reference_lane_lanelets(size_t time_step,
+                                                                              size_t obstacle_index) const;
+    ReferenceLaneInterval
+    compute_reference_lane_interval(size_t time_step, const std::shared_ptr<Obstacle> &obstacle,
+                                    std::optional<std::vector<uint64_t>> occupied_lanelet_ids) const;
+
+    // One value for each of the turning directions left, straight, and right
+    DenseObstacleCache<std::optional<int>, 3> priority_cache;
+
+    // Values published by another process, looked up before the caches above, set before the cache is used
+    std::shared_ptr<const SharedWorldCache> shared_cache;
+    std::optional<std::optional<std::span<const uint64_t>>> find_shared_lane_ids(size_t time_step,
+                                                                                 size_t obstacle_id) const;
+    std::optional<std::optional<int>> find_shared_priority(size_t time_step, size_t obstacle_id,
+                                                           size_t sub_index) const;
+
+    /**
+     * Hash the obstacle IDs in the order of the world and the horizon of the index, which determine the positions of
+     * the values in the dense caches.
+     *
+     * @return The hash.
+     */
+    uint64_t get_layout_hash() const;
+
+  public:
+    /**
+     * Create an empty cache for the given world.
+     *
+     * @param world The C++ world object corresponding to the CommonRoad scenario.
+     */
+    explicit WorldCache(std::shared_ptr<World> world);
+
+    /**
+     * Get the C++ world object corresponding to the CommonRoad scenario
+     *
+     * @return The world object.
+     */
+    const std::shared_ptr<World> &get_world() const { return world; }
+
+    /**
+     * Get the collector of the runtime statistics of all extractions in this world.
+     *
+     * @return The statistics collector.
+     */
+    const std::shared_ptr<StatisticsCollector> &get_statistics() const { return statistics; }
+
+    /**
+     * Get the index of all pairs of scenario time steps and obstacles.
+     *
+     * @return The index.
+     */
+    const std::shared_ptr<const ObstacleTimeIndex> &get_obstacle_time_index() const { return obstacle_time_index; }
+
+    /**
+     * Get the types, adjacency flags, incoming groups, and priorities of all lanelets of the road network.
+     *
+     * @return The lanelet attribute table.
+     */
+    const std::shared_ptr<const road_network::LaneletAttributeTable> &get_lanelet_attributes() const {
+        return lanelet_attributes;
+    }
+
+    /**
+     * Get an obstacle of the world by its ID without scanning all obstacles.
+     *
+     * @param obstacle_id The ID of the obstacle.
+     * @return The obstacle or nullptr if the world has no obstacle with this ID.
+     */
+    std::shared_ptr<Obstacle> get_obstacle(size_t obstacle_id) const;
+
+    /**
+     * Get the obstacles with the given IDs without scanning all obstacles.
+     *
+     * The cost only depends on the number of IDs, not on the number of obstacles in the world.
+     *
+     * @param obstacle_ids The IDs of the obstacles, std::nullopt (the ego vehicle) and unknown IDs are skipped.
+     * @return The obstacles in the same order as in the world.
+     */
+    std::vector<std::shared_ptr<Obstacle>>
+    get_obstacles(const std::unordered_set<std::optional<size_t>> &obstacle_ids) const;
+
+    /**
+     * Get the obstacles with the given IDs without scanning all obstacles.
+     *
+     * @param obstacle_ids The IDs of the obstacles, unknown IDs are skipped.
+     * @return The obstacles in the same order as in the world.
+     */
+    std::vector<std::shared_ptr<Obstacle>> get_obstacles(const std::unordered_set<size_t> &obstacle_ids) const;
+
+    /**
+     * Get the relevant obstacles of a single time step of a relevance matrix.
+     *
+     * @param relevant_obstacles The row of the relevance matrix, the ego vehicle is skipped.
+     * @return The obstacles in the same order as in the world.
+     */
+    std::vector<std::shared_ptr<Obstacle>> get_obstacles(const RelevanceMatrix::Row &relevant_obstacles) const {
+        return get_obstacles_by_index(relevant_obstacles.get_obstacle_indices());
+    }
+
+    /**
+     * Get the obstacles at the given compact indices of the obstacle time index.
+     *
+     * @param indices The compact indices, must be less than the number of indexed obstacles.
+     * @return The obstacles in the same order as in the world.
+     */
+    std::vector<std::shared_ptr<Obstacle>> get_obstacles_by_index(std::vector<size_t> indices) const;
+
+    /**
+     * Lock the world for exclusive access.
+     *
+     * @return The held lock.
+     */
+    std::unique_lock<std::recursive_mutex> lock_world() const { return std::unique_lock{world_mutex}; }
+
+    /**
+     * Get the IDs of the lanelets that the obstacle occupies at the given time step.
+     *
+     * @param time_step The time step.
+     * @param obstacle The obstacle.
+     * @return The occupied lanelet IDs in ascending order, which are read in place and valid for the lifetime of this
+     *     cache, or std::nullopt if there was an error getting the lanelets.
+     */
+    std::optional<std::span<const uint64_t>> get_obstacle_lane_ids(size_t time_step,
+                                                                   const std::shared_ptr<Obstacle> &obstacle);
+
+    /**
+     * Get the intersection and incoming lanelets of the reference lane of an obstacle.
+     *
+     * The reference lane is only computed again once the obstacle leaves the lanelets it occupied and the lanelets of
+     * the lane, so one lane is kept for an interval of time steps.
+     *
+     * @param time_step The time step.
+     * @param obstacle The obstacle.
+     * @return The lanelets, valid for the lifetime of this cache, or nullptr if the obstacle has no reference lane at
+     *     the time step.
+     */
+    const ReferenceLaneLanelets *get_reference_lane_lanelets(size_t time_step,
+                                                             const std::shared_ptr<Obstacle> &obstacle);
+
+    /**
+     * Get the possible turning directions of an obstacle.
+     *
+     * @param obstacle The obstacle.
+     * @return The possible turning directions.
+     */
+    const std::unordered_set<Direction> &get_turning_directions(const std::shared_ptr<Obstacle> &obstacle);
+
+    /**
+     * Get the lanelets that have a traffic sign of the given type.
+     *
+     * The lanelet network is only scanned when a type is requested for the first time.
+     *
+     * @param traffic_sign_type The type of the traffic sign.
+     * @return The lanelets as set over the indices of the lanelet attribute table.
+     */
+    const road_network::LaneletSet &get_lanelets_with_traffic_sign(TrafficSignTypes traffic_sign_type);
+
+    /**
+     * Get the priority of the obstacle for the given turning direction.
+     *
+     * @param time_step The time step of interest.
+     * @param obstacle The obstacle.
+     * @param dir The turning direction.
+     * @return The priority or std::nullopt if there was an error when determining the priorities.
+     */
+    std::optional<int> get_priority(size_t time_step, const std::shared_ptr<Obstacle> &obstacle, Direction dir);
+
+    /**
+     * Serialize all cached turning directions, priorities, and occupied lanelet IDs.
+     *
+     * @param scenario_hash The hash of the content of the scenario, e.g. from hash_file.
+     * @return The serialized results.
+     */
+    std::string serialize(uint64_t scenario_hash) const;
+
+    /**
+     * Add results serialized by a cache of the same scenario, so that they are not computed again.
+     *
+     * Results that are already cached are kept. May be called while the cache is in use.
+     *
+     * @param data The serialized results.
+     * @param scenario_hash The hash of the content of the scenario.
+     * @return False iff the data belongs to another scenario, obstacle set, or format version.
+     * @throws std::runtime_error If the data is corrupt, in which case no result is added.
+     */
+    bool deserialize(std::span<const char> data, uint64_t scenario_hash);
+
+    /**
+     * Write all cached results to a file, so that later processes working on the same scenario can load them.
+     *
+     * Several processes may save to the same file concurrently, the file always contains the results of one of them.
+     *
+     * @param path The path of the cache file.
+     * @param scenario_hash The hash of the content of the scenario, e.g. from hash_file.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void save(const std::filesystem::path &path, uint64_t scenario_hash) const;
+
+    /**
+     * Add the results of a cache file written by save, the file is memory-mapped while it is read.
+     *
+     * A corrupt file is ignored with a warning, since it can always be recomputed.
+     *
+     * @param path The path of the cache file.
+     * @param scenario_hash The hash of the content of the scenario.
+     * @return True iff results were loaded, i.e., the file exists, is intact, and belongs to the same scenario.
+     */
+    bool load(const std::filesystem::path &path, uint64_t scenario_hash);
+
+    /**
+     * Compute the turning directions of all obstacles, and their occupied lanelets and priorities at all time steps.
+     *
+     * This is meant to fill the cache before it is saved or published. Values whose computation fails are skipped
+     * with a warning.
+     */
+    void precompute();
+
+    /**
+     * Publish all cached results in a shared memory segment, so that other processes can attach to it.
+     *
+     * @param name The name of the segment, must not contain slashes.
+     * @param scenario_hash The hash of the content of the scenario, e.g. from hash_file.
+     * @return The segment, which is removed when the last reference to it is dropped.
+     * @throws std::runtime_error If the segment cannot be created.
+     */
+    std::shared_ptr<SharedWorldCache> publish(const std::string &name, uint64_t scenario_hash) const;
+
+    /**
+     * Look up results in a segment published by a cache of the same scenario before computing them.
+     *
+     * The values of the segment are read in place, nothing is copied into this cache. Must not be called while the
+     * cache is in use.
+     *
+     * @param shared_cache The segment.
+     * @param scenario_hash The hash of the content of the scenario.
+     * @return False iff the segment belongs to another scenario or obstacle set, in which case it is not used.
+     */
+    bool attach(std::shared_ptr<const SharedWorldCache> shared_cache, uint64_t scenario_hash);
+};
+} // namespace knowledge_extraction::env_model
@@ -1,71 +1,165 @@
 #pragma once
 
+#include "cr_knowledge_extraction/anytime.hpp"
 #include "cr_knowledge_extraction/env_model/env_model.hpp"
+#include "cr_knowledge_extraction/env_model/relevance_matrix.hpp"
+#include "cr_knowledge_extraction/extraction_result.hpp"
 #include "cr_knowledge_extraction/kleene/kleene_extractor.hpp"
+#include "cr_knowledge_extraction/parallel/budget.hpp"
+#include "cr_knowledge_extraction/parallel/work_stealing_pool.hpp"
 #include "cr_knowledge_extraction/relationship/relationship_extractor.hpp"
+#include "cr_knowledge_extraction/statistics.hpp"
 
 #include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
 #include <commonroad_cpp/world.h>
 #include <geometry/curvilinear_coordinate_system.h>
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace knowledge_extraction {
-/**
- * The result of knowledge extraction at a specific time step.
- */
-struct ExtractionResult {
-    std::vector<std::string> positive_propositions;
-    std::vector<std::string> negative_propositions;
-    std::vector<std::pair<std::string, std::string>> implications;
-    std::vector<std::pair<std::string, std::string>> equivalences;
-};
+class ExtractionSession;
 
 class ExtractionInterface {
   private:
+    friend class ExtractionSession;
+
     std::shared_ptr<env_model::EnvironmentModel> env_model;
     time_step_t initial_time_step;
 
+    // Only present if extraction runs on more than one thread, may be shared with other interfaces
+    std::shared_ptr<parallel::WorkStealingPool> pool;
+    static constexpr size_t time_steps_per_task = 8;
+
+    // Extractors are created on first use and reused by all later extractions, nullptr marks unsupported propositions
+    std::unordered_map<Proposition, std::unique_ptr<kleene::KleeneExtractor>> kleene_extractors;
+    std::unordered_map<Proposition, std::unique_ptr<relationship::RelationshipExtractor>> relationship_extractors;
+
+    // Propositions are parsed once, std::nullopt marks unknown propositions
+    std::unordered_map<std::string, std::optional<std::pair<Proposition, std::optional<size_t>>>> parsed_propositions;
+
+    /**
+     * Get the collector of the runtime statistics, which is shared by all interfaces on the same world.
+     *
+     * @return The statistics collector.
+     */
+    StatisticsCollector &get_statistics_collector() const { return *env_model->get_world_cache()->get_statistics(); }
+
     std::optional<std::unique_ptr<kleene::KleeneExtractor>> create_kleene_extractor(Proposition prop);
 
     std::optional<std::unique_ptr<relationship::RelationshipExtractor>> create_relationship_extractor(Proposition prop);
 
-    // We use std::nullopt to mark the ego vehicle
-    using RelevantObstacles =
-        std::unordered_map<Proposition, std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>>>;
+    /**
+     * Get the Kleene extractor for a proposition, creating it on first use.
+     *
+     * @param prop The proposition.
+     * @return The extractor or nullptr if there is no Kleene extractor for the proposition.
+     */
+    const kleene::KleeneExtractor *get_kleene_extractor(Proposition prop);
 
     /**
-     * Determine the relevant obstacles for each proposition over time.
+     * Get the relationship extractor for a proposition, creating it on first use.
      *
-     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
-     * @return A map from propositions to relevant obstacle IDs over time. We use std::nullopt to mark the ego vehicle.
+     * @param prop The proposition.
+     * @return The extractor or nullptr if there is no relationship extractor for the proposition.
+     */
+    const relationship::RelationshipExtractor *get_relationship_extractor(Proposition prop);
+
+    /**
+     * Parse a proposition string, reusing the result of earlier calls.
+     *
+     * @param prop The proposition string.
+     * @return The proposition and its parameter or std::nullopt if the proposition is unknown.
+     */
+    const std::optional<std::pair<Proposition, std::optional<size_t>>> &parse_proposition(const std::string &prop);
+
+    using RelevantObstacles = std::unordered_map<Proposition, env_model::RelevanceMatrix>;
+
+    /**
+     * Split the relevant obstacles of a proposition into chunks of consecutive time steps.
+     *
+     * Without a thread pool, a single chunk containing all time steps is returned.
+     *
+     * @param relevant_obstacles_over_time The relevant obstacles of a single proposition.
+     * @return The chunks, ordered by time step.
+     */
+    std::vector<env_model::RelevanceMatrix>
+    split_into_chunks(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const;
+
+    /**
+     * Precompute the reachable bounds of the ego vehicle up to the last time step of interest.
+     *
+     * @param relevant_obstacles The relevant obstacles per proposition.
+     */
+    void precompute_ego_approximations(const RelevantObstacles &relevant_obstacles) const;
+
+    /**
+     * Run the given tasks on the thread pool or sequentially if there is no pool.
+     *
+     * @param tasks The tasks to run.
      */
-    RelevantObstacles compute_relevant_obstacles(
-        const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) const;
+    void run_tasks(std::vector<std::function<void()>> tasks);
+
+    /**
+     * Extract Kleene knowledge with a single extractor.
+     *
+     * @param extractor The extractor.
+     * @param relevant_obstacles_over_time The relevant obstacles of the proposition of the extractor.
+     * @param records Output parameter, the extracted knowledge is appended to it.
+     */
+    void extract_kleene_records(const kleene::KleeneExtractor &extractor,
+                                const env_model::RelevanceMatrix &relevant_obstacles_over_time,
+                                std::vector<KnowledgeRecord> &records) const;
+
+    /**
+     * Extract relationships with a single extractor.
+     *
+     * @param extractor The extractor.
+     * @param relevant_obstacles_over_time The relevant obstacles of the left-hand side proposition of the extractor.
+     * @param records Output parameter, the extracted knowledge is appended to it.
+     */
+    void extract_relationship_records(const relationship::RelationshipExtractor &extractor,
+                                      const env_model::RelevanceMatrix &relevant_obstacles_over_time,
+                                      std::vector<KnowledgeRecord> &records) const;
 
     /**
      * Extract Kleene knowledge for the relevant obstacles.
      *
      * @param relevant_obstacles The relevant obstacles for each proposition over time.
-     * @param result Output parameter for the extraction results.
+     * @param records Output parameter, the extracted knowledge is appended to it.
      */
-    void extract_kleene(const RelevantObstacles &relevant_obstacles,
-                        std::unordered_map<time_step_t, ExtractionResult> &result);
+    void extract_kleene(const RelevantObstacles &relevant_obstacles, std::vector<KnowledgeRecord> &records);
 
     /**
      * Extract relationships for the relevant obstacles.
      *
      * @param relevant_obstacles The relevant obstacles for each proposition over time.
-     * @param result Output parameter for the extraction results.
+     * @param records Output parameter, the extracted knowledge is appended to it.
      * @param type If given, extract mostly relationships of this type.
      */
-    void extract_relationships(const RelevantObstacles &relevant_obstacles,
-                               std::unordered_map<time_step_t, ExtractionResult> &result,
+    void extract_relationships(const RelevantObstacles &relevant_obstacles, std::vector<KnowledgeRecord> &records,
                                std::optional<relationship::RelationshipType> type = std::nullopt);
 
+    /**
+     * Extract Kleene knowledge and relationships for the relevant obstacles until the budget runs out.
+     *
+     * The work is split into units of one extractor at one time step, which are started in the order of their
+     * estimated cost and then of their time step. Units that have not been started when the budget runs out are
+     * skipped, units that have been started are always finished.
+     *
+     * @param relevant_obstacles The relevant obstacles for each proposition over time.
+     * @param budget The budget for the extraction.
+     * @return The knowledge of all finished units and a report of the skipped units.
+     */
+    AnytimeExtractionResult extract_anytime(const RelevantObstacles &relevant_obstacles,
+                                            const parallel::Budget &budget);
+
   public:
     /**
      * Create an interface for knowledge extraction.
@@ -73,14 +167,85 @@ class ExtractionInterface {
      * @param world The C++ world object corresponding to the CommonRoad scenario.
      * @param ego_ccs The curvilinear coordinate system of the ego vehicle.
      * @param ego_params The configuration parameters of the ego vehicle.
+     * @param num_threads The number of threads used for extraction. With 1, everything runs on the calling thread,
+     *     with 0, one thread per hardware core is used.
      */
     ExtractionInterface(std::shared_ptr<World> world, std::shared_ptr<geometry::CurvilinearCoordinateSystem> ego_ccs,
-                        const ego_behavior::EgoParameters &ego_params)
-        : env_model(std::make_shared<env_model::EnvironmentModel>(std::move(world), std::move(ego_ccs), ego_params,
-                                                                  PredicateParameters{})),
-          initial_time_step(ego_params.initial_state.getTimeStep()) {}
+                        const ego_behavior::EgoParameters &ego_params, size_t num_threads = 1);
     // TODO: Make predicate parameters configurable from Python
 
+    /**
+     * Create an interface for knowledge extraction on an existing environment model.
+     *
+     * @param env_model The environment model, which may share its caches with other models.
+     * @param pool The thread pool used for extraction or nullptr to run everything on the calling thread. Interfaces
+     *     sharing a pool must not extract concurrently.
+     */
+    ExtractionInterface(std::shared_ptr<env_model::EnvironmentModel> env_model,
+                        std::shared_ptr<parallel::WorkStealingPool> pool);
+
+    /**
+     * Create the thread pool for the given number of threads.
+     *
+     * @param num_threads The number of threads. With 1, no pool is needed, with 0, one thread per hardware core is
+     *     used.
+     * @return The pool or nullptr if no pool is needed.
+     */
+    static std::shared_ptr<parallel::WorkStealingPool> make_pool(size_t num_threads);
+
+    /**
+     * Get the environment model used for extraction.
+     *
+     * @return The environment model.
+     */
+    const std::shared_ptr<env_model::EnvironmentModel> &get_env_model() const { return env_model; }
+
+    /**
+     * Move the ego vehicle to a new initial state for the next planning cycle.
+     *
+     * All knowledge that does not depend on the ego vehicle stays cached. Afterwards, the relevant propositions of
+     * all extractions and sessions refer to time steps relative to the time step of the new initial state.
+     *
+     * @param new_initial_state The new initial state of the ego vehicle.
+     */
+    void advance(const State &new_initial_state);
+
+    /**
+     * Get the time step of the current initial state of the ego vehicle.
+     *
+     * @return The initial time step.
+     */
+    time_step_t get_initial_time_step() const { return initial_time_step; }
+
+    /**
+     * Enable or disable the collection of runtime statistics.
+     *
+     * Statistics are collected per world, so this also affects other interfaces sharing the caches of this world,
+     * e.g. the interfaces of other ego hypotheses in the same batch. Disabled collection costs almost nothing.
+     *
+     * @param enabled Whether to collect statistics.
+     */
+    void set_statistics_enabled(bool enabled) { get_statistics_collector().set_enabled(enabled); }
+
+    /**
+     * Check whether runtime statistics are collected.
+     *
+     * @return True iff collection is enabled.
+     */
+    bool is_statistics_enabled() const { return get_statistics_collector().is_enabled(); }
+
+    /**
+     * Get the runtime statistics collected since collection was enabled or the statistics were last reset.
+     *
+     * @return A snapshot of the statistics.
+     */
+    ExtractionStatistics get_statistics() const { return get_statistics_collector().get_statistics(); }
+
+    /**
+     * Reset the runtime statistics, e.g. to get the statistics of the next extraction only.
+     */
+    void reset_statistics() { get_statistics_collector().reset(); }
+
     /**
      * Extract all knowledge for the relevant propositions.
      *
@@ -90,6 +255,29 @@ class ExtractionInterface {
     std::unordered_map<time_step_t, ExtractionResult>
     extract_all(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
 
+    /**
+     * Extract all knowledge for the relevant propositions, without rendering it as strings.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult
+    extract_all_compact(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
+    /**
+     * Extract as much knowledge for the relevant propositions as possible within the given budget.
+     *
+     * Cheap extractors and near time steps are scheduled first. The extracted knowledge is sound, but may be incomplete
+     * if the budget runs out.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @param budget The budget for the extraction.
+     * @return The extracted knowledge and a report of the skipped work.
+     */
+    AnytimeExtractionResult
+    extract_all_anytime(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions,
+                        const parallel::Budget &budget);
+
     /**
      * Extract all knowledge except implications for the relevant propositions.
      *
@@ -99,6 +287,15 @@ class ExtractionInterface {
     std::unordered_map<time_step_t, ExtractionResult> extract_all_but_implications(
         const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
 
+    /**
+     * Extract all knowledge except implications for the relevant propositions, without rendering it as strings.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_all_but_implications_compact(
+        const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
     /**
      * Extract only Kleene knowledge for the relevant propositions.
      *
@@ -108,6 +305,15 @@ class ExtractionInterface {
     std::unordered_map<time_step_t, ExtractionResult>
     extract_kleene(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
 
+    /**
+     * Extract only Kleene knowledge for the relevant propositions, without rendering it as strings.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult
+    extract_kleene_compact(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
     /**
      * Extract only relationships for the relevant propositions.
      *
@@ -117,6 +323,15 @@ class ExtractionInterface {
     std::unordered_map<time_step_t, ExtractionResult>
     extract_relationships(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
 
+    /**
+     * Extract only relationships for the relevant propositions, without rendering it as strings.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_relationships_compact(
+        const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
     /**
      * Extract only equivalences for the relevant propositions.
      *
@@ -126,6 +341,15 @@ class ExtractionInterface {
     std::unordered_map<time_step_t, ExtractionResult>
     extract_equivalences(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
 
+    /**
+     * Extract only equivalences for the relevant propositions, without rendering it as strings.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_equivalences_compact(
+        const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
     /**
      * Extract only implications for the relevant propositions.
      *
@@ -134,5 +358,14 @@ class ExtractionInterface {
      */
     std::unordered_map<time_step_t, ExtractionResult>
     extract_implications(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
+    /**
+     * Extract only implications for the relevant propositions, without rendering it as strings.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_implications_compact(
+        const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
 };
 } // namespace knowledge_extraction
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "cr_knowledge_extraction/proposition.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace knowledge_extraction {
+/**
+ * The result of knowledge extraction at a specific time step.
+ */
+struct ExtractionResult {
+    std::vector<std::string> positive_propositions;
+    std::vector<std::string> negative_propositions;
+    std::vector<std::pair<std::string, std::string>> implications;
+    std::vector<std::pair<std::string, std::string>> equivalences;
+};
+
+/**
+ * The kind of a piece of extracted knowledge.
+ */
+enum class KnowledgeKind : uint8_t {
+    POSITIVE,
+    NEGATIVE,
+    IMPLICATION,
+    EQUIVALENCE,
+};
+
+/**
+ * A single piece of extracted knowledge without any strings.
+ *
+ * Positive and negative propositions only use the left-hand side, relationships use both sides.
+ * We use std::nullopt as parameter to mark the ego vehicle.
+ */
+struct KnowledgeRecord {
+    time_step_t time_step;
+    KnowledgeKind kind;
+    Proposition lhs;
+    std::optional<size_t> lhs_parameter;
+    Proposition rhs{};
+    std::optional<size_t> rhs_parameter{};
+};
+
+/**
+ * Extracted knowledge for all time steps stored as contiguous records grouped by formula time step.
+ *
+ * Strings are only created when the knowledge is rendered.
+ */
+class CompactExtractionResult {
+  private:
+    std::vector<KnowledgeRecord> records;
+    // The records of time step t are records[offsets[t]] to records[offsets[t + 1]]
+    std::vector<size_t> offsets{0};
+
+  public:
+    CompactExtractionResult() = default;
+
+    /**
+     * Group the given records by time step.
+     *
+     * The order of the records within each time step is preserved.
+     *
+     * @param records The records in arbitrary time step order.
+     */
+    explicit CompactExtractionResult(std::vector<KnowledgeRecord> records);
+
+    /**
+     * Get all records ordered by time step.
+     *
+     * @return The records.
+     */
+    const std::vector<KnowledgeRecord> &get_records() const { return records; }
+
+    /**
+     * Get the records of a single time step.
+     *
+     * @param time_step The formula time step.
+     * @return The records, empty if there is no knowledge for the time step.
+     */
+    std::span<const KnowledgeRecord> get_records(time_step_t time_step) const {
+        if (time_step + 1 >= offsets.size()) {
+            return {};
+        }
+        return std::span{records}.subspan(offsets[time_step], offsets[time_step + 1] - offsets[time_step]);
+    }
+
+    /**
+     * Get the time steps for which knowledge was extracted in ascending order.
+     *
+     * @return The time steps.
+     */
+    std::vector<time_step_t> get_time_steps() const;
+
+    /**
+     * Get the total number of records.
+     *
+     * @return The number of records.
+     */
+    size_t size() const { return records.size(); }
+
+    /**
+     * Render the knowledge of a single time step as strings.
+     *
+     * @param time_step The formula time step.
+     * @return The rendered knowledge.
+     */
+    ExtractionResult render(time_step_t time_step) const;
+
+    /**
+     * Render the knowledge of all time steps as strings.
+     *
+     * @return The rendered knowledge for each time step with at least one record.
+     */
+    std::unordered_map<time_step_t, ExtractionResult> render_all() const;
+};
+} // namespace knowledge_extraction
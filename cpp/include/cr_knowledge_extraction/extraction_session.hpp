@@ -0,0 +1,108 @@
+#pragma once
+
+#include "cr_knowledge_extraction/anytime.hpp"
+#include "cr_knowledge_extraction/extraction_interface.hpp"
+#include "cr_knowledge_extraction/extraction_result.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace knowledge_extraction {
+/**
+ * A set of relevant propositions that is kept across several extraction passes.
+ *
+ * The propositions are parsed once when the session is created. Updating the session with a new set of relevant
+ * propositions, e.g. for the augmented formula of a later pass, only parses the propositions that were added.
+ * If the interface is advanced to a new initial state, the session follows without parsing anything again.
+ */
+class ExtractionSession {
+  private:
+    ExtractionInterface &extraction_interface;
+
+    // The relevant propositions in formula time steps and the parsed relevance structure in scenario time steps
+    std::unordered_map<time_step_t, std::unordered_set<std::string>> relevant_propositions;
+    ExtractionInterface::RelevantObstacles relevant_obstacles;
+    // The initial time step of the interface when the scenario time steps above were computed
+    time_step_t initial_time_step;
+
+    /**
+     * Shift the scenario time steps of the relevance structure if the interface was advanced in the meantime.
+     */
+    void sync_initial_time_step();
+
+    void add_relevant_proposition(time_step_t time_step, const std::string &prop);
+
+    void remove_relevant_proposition(time_step_t time_step, const std::string &prop);
+
+  public:
+    /**
+     * Create a session for the given relevant propositions.
+     *
+     * @param extraction_interface The interface used for extraction, must outlive the session.
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     */
+    ExtractionSession(ExtractionInterface &extraction_interface,
+                      const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
+    /**
+     * Replace the relevant propositions, only parsing propositions that were not relevant before.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     */
+    void update(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
+    /**
+     * Extract all knowledge for the relevant propositions.
+     *
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_all();
+
+    /**
+     * Extract as much knowledge for the relevant propositions as possible within the given budget.
+     *
+     * @param budget The budget for the extraction.
+     * @return The extracted knowledge and a report of the skipped work.
+     */
+    AnytimeExtractionResult extract_all_anytime(const parallel::Budget &budget);
+
+    /**
+     * Extract all knowledge except implications for the relevant propositions.
+     *
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_all_but_implications();
+
+    /**
+     * Extract only Kleene knowledge for the relevant propositions.
+     *
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_kleene();
+
+    /**
+     * Extract only relationships for the relevant propositions.
+     *
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_relationships();
+
+    /**
+     * Extract only equivalences for the relevant propositions.
+     *
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_equivalences();
+
+    /**
+     * Extract only implications for the relevant propositions.
+     *
+     * @return The extracted knowledge.
+     */
+    CompactExtractionResult extract_implications();
+};
+} // namespace knowledge_extraction
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "cr_knowledge_extraction/ego_behavior/ego_params.hpp"
+#include "cr_knowledge_extraction/env_model/world_cache.hpp"
+#include "cr_knowledge_extraction/extraction_interface.hpp"
+#include "cr_knowledge_extraction/extraction_result.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+#include <commonroad_cpp/world.h>
+#include <geometry/curvilinear_coordinate_system.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace knowledge_extraction {
+/**
+ * A hypothesis about the ego vehicle, i.e., its reference path and its parameters including the initial state.
+ */
+struct EgoHypothesis {
+    std::shared_ptr<geometry::CurvilinearCoordinateSystem> ego_ccs;
+    ego_behavior::EgoParameters ego_params;
+};
+
+/**
+ * Knowledge extraction for several ego hypotheses in the same world.
+ *
+ * All hypotheses share the caches that only depend on the world, and hypotheses with the same CCS additionally share
+ * the caches that depend on the CCS, so this work is only done once for the whole batch.
+ */
+class HypothesisBatch {
+  private:
+    std::shared_ptr<env_model::WorldCache> world_cache;
+    std::shared_ptr<parallel::WorkStealingPool> pool;
+    std::vector<std::unique_ptr<ExtractionInterface>> extraction_interfaces;
+
+    /**
+     * Precompute the reachable bounds of all hypotheses concurrently on the pool of the batch.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     */
+    void precompute_ego_approximations(
+        const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
+  public:
+    /**
+     * Create a batch of ego hypotheses.
+     *
+     * @param world The C++ world object corresponding to the CommonRoad scenario.
+     * @param hypotheses The ego hypotheses. Hypotheses share CCS-dependent caches if they use the same CCS object.
+     * @param num_threads The number of threads used for extraction. With 1, everything runs on the calling thread,
+     *     with 0, one thread per hardware core is used.
+     */
+    HypothesisBatch(std::shared_ptr<World> world, const std::vector<EgoHypothesis> &hypotheses,
+                    size_t num_threads = 1);
+
+    /**
+     * Get the number of hypotheses.
+     *
+     * @return The number of hypotheses.
+     */
+    size_t size() const { return extraction_interfaces.size(); }
+
+    /**
+     * Get the extraction interface of a single hypothesis, e.g. to run further extraction passes on it.
+     *
+     * @param hypothesis The index of the hypothesis.
+     * @return The extraction interface.
+     */
+    ExtractionInterface &get_extraction_interface(size_t hypothesis) { return *extraction_interfaces.at(hypothesis); }
+
+    /**
+     * Extract all knowledge for the relevant propositions for each hypothesis.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @return The extracted knowledge for each hypothesis, in the order of the hypotheses.
+     */
+    std::vector<std::unordered_map<time_step_t, ExtractionResult>>
+    extract_all(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+
+    /**
+     * Extract all knowledge for the relevant propositions for each hypothesis, without rendering it as strings.
+     *
+     * @param relevant_propositions The propositions that are relevant for extraction at each time step.
+     * @return The extracted knowledge for each hypothesis, in the order of the hypotheses.
+     */
+    std::vector<CompactExtractionResult>
+    extract_all_compact(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions);
+};
+} // namespace knowledge_extraction
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace knowledge_extraction {
+/**
+ * Maps the sparse IDs of CommonRoad objects, e.g. obstacles or lanelets, to compact indices.
+ *
+ * IDs within a small range are mapped through a lookup table, otherwise by binary search.
+ */
+class IdIndex {
+  private:
+    static constexpr uint32_t no_index = UINT32_MAX;
+    // ID ranges up to this size are mapped through a lookup table
+    static constexpr size_t max_lookup_table_size = size_t{1} << 20;
+
+    size_t num_ids{0};
+    size_t min_id{0};
+    std::vector<uint32_t> lookup_table;
+    std::vector<std::pair<size_t, uint32_t>> sorted_ids;
+
+  public:
+    IdIndex() = default;
+
+    /**
+     * Create an index that maps each ID to its position in the given vector.
+     *
+     * @param ids The IDs.
+     * @throws std::invalid_argument If an ID is not unique.
+     */
+    explicit IdIndex(const std::vector<size_t> &ids);
+
+    /**
+     * Get the compact index of an ID.
+     *
+     * @param id The ID.
+     * @return The index in [0, size()) or std::nullopt if the ID is unknown.
+     */
+    std::optional<size_t> find(size_t id) const {
+        if (!lookup_table.empty()) {
+            auto offset = id - min_id;
+            if (offset >= lookup_table.size() || lookup_table[offset] == no_index) {
+                return std::nullopt;
+            }
+            return lookup_table[offset];
+        }
+        auto it = std::lower_bound(sorted_ids.begin(), sorted_ids.end(), std::make_pair(id, uint32_t{0}));
+        if (it == sorted_ids.end() || it->first != id) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * Get the number of indexed IDs.
+     *
+     * @return The number of IDs.
+     */
+    size_t size() const { return num_ids; }
+};
+} // namespace knowledge_extraction
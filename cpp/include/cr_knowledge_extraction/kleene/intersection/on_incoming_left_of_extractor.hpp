@@ -5,21 +5,30 @@
 namespace knowledge_extraction::kleene::intersection {
 class OnIncomingLeftOfExtractor : public KleeneExtractor {
   private:
-    std::optional<bool> is_on_incoming_left_of(const time_step_t &left_of_incoming_id,
-                                               const std::shared_ptr<Obstacle> &obstacle,
-                                               const std::unordered_set<size_t> &left_of_incomings_could,
-                                               const std::unordered_set<size_t> &left_of_incomings_must) const;
+    std::optional<bool>
+    is_on_incoming_left_of(const time_step_t &time_step, const std::shared_ptr<Obstacle> &obstacle,
+                           const std::unordered_set<size_t> &left_of_incomings_could,
+                           const std::optional<std::unordered_set<size_t>> &left_of_incomings_must) const;
 
-    static std::unordered_set<size_t>
+    /**
+     * Get the incoming groups that the incoming groups of the given lanelets are left of.
+     *
+     * An incoming lanelet whose incoming group is missing or not left of another one is left of no group, thus no
+     * obstacle is on the incoming left of a vehicle on it.
+     *
+     * @param lanelets The lanelets, lanelets that are not incoming lanelets are skipped.
+     * @param lanelet_attributes The lanelet attributes of the road network.
+     * @return The IDs of the incoming groups and false iff an incoming lanelet is left of no group.
+     */
+    static std::pair<std::unordered_set<size_t>, bool>
     get_incoming_left_of_ids_from_lanelets(const std::vector<std::shared_ptr<Lanelet>> &lanelets,
-                                           const std::shared_ptr<RoadNetwork> &road_network);
+                                           const road_network::LaneletAttributeTable &lanelet_attributes);
 
   public:
     OnIncomingLeftOfExtractor(std::shared_ptr<knowledge_extraction::env_model::EnvironmentModel> env_model)
         : KleeneExtractor(std::move(env_model), Proposition::ON_INCOMING_LEFT_OF) {}
 
     std::unordered_map<time_step_t, TrueFalseObstacleIds>
-    extract(const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>>
-                &relevant_obstacle_ids_over_time) const override;
+    extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const override;
 };
 } // namespace knowledge_extraction::kleene::intersection
@@ -13,6 +13,6 @@ class OtherTurningExtractor : public KleeneExtractor {
         : KleeneExtractor(std::move(env_model), prop), direction(direction) {}
 
     std::unordered_map<time_step_t, TrueFalseObstacleIds>
-    extract(const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &opt) const override;
+    extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const override;
 };
 } // namespace knowledge_extraction::kleene::intersection
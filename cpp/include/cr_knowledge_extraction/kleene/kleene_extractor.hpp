@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cr_knowledge_extraction/env_model/env_model.hpp"
+#include "cr_knowledge_extraction/env_model/relevance_matrix.hpp"
 #include "cr_knowledge_extraction/proposition.hpp"
 
 #include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
@@ -52,12 +53,10 @@ class KleeneExtractor {
     /**
      * Extract Kleene knowledge.
      *
-     * @param relevant_obstacle_ids_over_time Map of time steps to relevant obstacle IDs, like above std::nullopt
-     *     indicates the ego vehicle.
+     * @param relevant_obstacles_over_time The relevant obstacles, including the ego vehicle, at each time step.
      * @return The extracted knowledge for each time step.
      */
     virtual std::unordered_map<time_step_t, TrueFalseObstacleIds>
-    extract(const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>>
-                &relevant_obstacle_ids_over_time) const = 0;
+    extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const = 0;
 };
 } // namespace knowledge_extraction::kleene
@@ -9,7 +9,6 @@ class InSameLaneExtractor : public KleeneExtractor {
         : KleeneExtractor(std::move(env_model), Proposition::IN_SAME_LANE) {}
 
     std::unordered_map<time_step_t, TrueFalseObstacleIds>
-    extract(const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>>
-                &relevant_obstacle_ids_over_time) const override;
+    extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const override;
 };
 } // namespace knowledge_extraction::kleene::position
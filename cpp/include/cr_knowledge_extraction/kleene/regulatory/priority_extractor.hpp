@@ -23,7 +23,6 @@ class PriorityExtractor : public KleeneExtractor {
         : KleeneExtractor(std::move(env_model), prop), ego_turn(ego_turn), other_turn(other_turn), mode(mode) {}
 
     std::unordered_map<time_step_t, TrueFalseObstacleIds>
-    extract(const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>>
-                &relevant_obstacle_ids_over_time) const override;
+    extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const override;
 };
 } // namespace knowledge_extraction::kleene::regulatory
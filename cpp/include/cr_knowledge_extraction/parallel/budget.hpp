@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace knowledge_extraction::parallel {
+/**
+ * A flag to cancel running work from another thread.
+ */
+class CancellationToken {
+  private:
+    std::atomic<bool> cancelled{false};
+
+  public:
+    /**
+     * Request cancellation. Work that has already started is finished, but no new work is started.
+     */
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    /**
+     * Check whether cancellation was requested.
+     *
+     * @return True iff cancel() was called.
+     */
+    bool is_cancelled() const { return cancelled.load(std::memory_order_relaxed); }
+};
+
+/**
+ * A time budget for work that can be stopped early, given by a deadline and/or a cancellation token.
+ *
+ * A default constructed budget never expires.
+ */
+class Budget {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+  private:
+    std::optional<Clock::time_point> deadline;
+    std::shared_ptr<const CancellationToken> token;
+
+  public:
+    Budget() = default;
+
+    /**
+     * Create a budget.
+     *
+     * @param deadline The point in time after which no new work is started or std::nullopt for no deadline.
+     * @param token The token to cancel the work early or nullptr.
+     */
+    explicit Budget(std::optional<Clock::time_point> deadline,
+                    std::shared_ptr<const CancellationToken> token = nullptr)
+        : deadline(deadline), token(std::move(token)) {}
+
+    /**
+     * Create a budget that expires after the given duration from now.
+     *
+     * @param timeout The available time.
+     * @param token The token to cancel the work early or nullptr.
+     * @return The budget.
+     */
+    static Budget from_timeout(Clock::duration timeout, std::shared_ptr<const CancellationToken> token = nullptr) {
+        return Budget{Clock::now() + timeout, std::move(token)};
+    }
+
+    /**
+     * Check whether the budget is used up, i.e., the deadline has passed or cancellation was requested.
+     *
+     * @return True iff no new work should be started.
+     */
+    bool is_expired() const {
+        return (token && token->is_cancelled()) || (deadline.has_value() && Clock::now() >= deadline.value());
+    }
+};
+} // namespace knowledge_extraction::parallel
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace knowledge_extraction::parallel {
+/**
+ * A cache that can be read and filled by multiple threads concurrently.
+ *
+ * Keys are distributed over independently locked shards. Every value is computed at most once: threads requesting an
+ * entry that is currently being computed wait for the result instead of computing it again. Once computed, entries are
+ * never moved, so references to cached values stay valid for the lifetime of the cache.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The type of the cached values.
+ * @tparam Hash The hash function for the keys.
+ * @tparam NumShards The number of independently locked shards.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>, size_t NumShards = 16> class ConcurrentCache {
+  private:
+    struct Entry {
+        std::mutex mutex;
+        std::atomic<bool> ready{false};
+        std::optional<Value> value;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, std::unique_ptr<Entry>, Hash> entries;
+    };
+
+    std::array<Shard, NumShards> shards;
+
+    Shard &get_shard(const Key &key) { return shards[Hash{}(key) % NumShards]; }
+
+    Entry &get_entry(const Key &key) {
+        auto &shard = get_shard(key);
+        {
+            std::shared_lock lock{shard.mutex};
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end()) {
+                return *it->second;
+            }
+        }
+        std::unique_lock lock{shard.mutex};
+        auto &entry = shard.entries[key];
+        if (!entry) {
+            entry = std::make_unique<Entry>();
+        }
+        return *entry;
+    }
+
+  public:
+    /**
+     * Get the cached value for the given key or compute it if it is not cached yet.
+     *
+     * The computation runs without holding a shard lock, so it may query other entries of this cache. It must not
+     * query the entry it is computing. If the computation throws, the entry stays empty and the next request for it
+     * retries the computation.
+     *
+     * @param key The key.
+     * @param compute A callable returning the value for the key.
+     * @return A reference to the cached value.
+     */
+    template <typename Compute> const Value &get_or_compute(const Key &key, Compute &&compute) {
+        auto &entry = get_entry(key);
+        if (!entry.ready.load(std::memory_order_acquire)) {
+            std::scoped_lock lock{entry.mutex};
+            if (!entry.ready.load(std::memory_order_relaxed)) {
+                entry.value.emplace(std::invoke(std::forward<Compute>(compute)));
+                entry.ready.store(true, std::memory_order_release);
+            }
+        }
+        return entry.value.value();
+    }
+
+    /**
+     * Get the number of computed entries.
+     *
+     * @return The number of entries.
+     */
+    size_t size() const {
+        size_t result = 0;
+        for (const auto &shard : shards) {
+            std::shared_lock lock{shard.mutex};
+            for (const auto &[_, entry] : shard.entries) {
+                result += entry->ready.load(std::memory_order_acquire) ? 1 : 0;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Call the given function for each computed entry in unspecified order.
+     *
+     * The function is called while holding a shard lock, thus it must not query this cache.
+     *
+     * @param visit A callable taking the key and the value.
+     */
+    template <typename Visit> void for_each(Visit &&visit) const {
+        for (const auto &shard : shards) {
+            std::shared_lock lock{shard.mutex};
+            for (const auto &[key, entry] : shard.entries) {
+                if (entry->ready.load(std::memory_order_acquire)) {
+                    visit(key, entry->value.value());
+                }
+            }
+        }
+    }
+
+    /**
+     * Remove all entries.
+     *
+     * Invalidates all references to cached values, thus must not be called while the cache is in use.
+     */
+    void clear() {
+        for (auto &shard : shards) {
+            std::unique_lock lock{shard.mutex};
+            shard.entries.clear();
+        }
+    }
+};
+} // namespace knowledge_extraction::parallel
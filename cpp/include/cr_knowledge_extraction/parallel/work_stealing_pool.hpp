@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace knowledge_extraction::parallel {
+class WorkStealingPool {
+  public:
+    using Task = std::function<void()>;
+
+  private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> task_indices;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_done;
+    size_t generation{0};
+    size_t remaining_tasks{0};
+    bool stopping{false};
+
+    std::vector<Task> *current_tasks{nullptr};
+    std::vector<std::exception_ptr> current_errors;
+
+    /**
+     * Take the next task index from the own queue or steal one from another worker.
+     *
+     * @param worker The index of the worker looking for work.
+     * @return The index of the task to execute or std::nullopt if all queues are empty.
+     */
+    std::optional<size_t> pop_or_steal(size_t worker);
+
+    /**
+     * Execute tasks until all queues are empty.
+     *
+     * @param worker The index of the executing worker.
+     */
+    void drain(size_t worker);
+
+    void worker_loop(size_t worker);
+
+  public:
+    /**
+     * Create a pool of workers that balance their load by stealing tasks from each other.
+     *
+     * The thread calling run() participates as one of the workers, so only num_threads - 1 threads are spawned.
+     *
+     * @param num_threads The total number of workers, must be at least one.
+     */
+    explicit WorkStealingPool(size_t num_threads);
+
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /**
+     * Get the total number of workers including the calling thread.
+     *
+     * @return The number of workers.
+     */
+    size_t get_num_threads() const { return queues.size(); }
+
+    /**
+     * Execute all tasks and block until they have finished.
+     *
+     * Tasks are distributed round-robin over the workers, idle workers steal from the front of other queues.
+     * If tasks throw, the exception of the task with the smallest index is rethrown once all tasks have finished.
+     * Must not be called concurrently or from within a task.
+     *
+     * @param tasks The tasks to execute.
+     */
+    void run(std::vector<Task> tasks);
+};
+} // namespace knowledge_extraction::parallel
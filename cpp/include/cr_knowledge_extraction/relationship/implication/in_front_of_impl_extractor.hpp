@@ -12,7 +12,6 @@ class InFrontOfImplExtractor : public RelationshipExtractor {
                                 RelationshipType::IMPLICATION){};
 
     std::unordered_map<time_step_t, std::vector<Relationship>>
-    extract(const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>>
-                &relevant_obstacle_ids_over_time) const override;
+    extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const override;
 };
 } // namespace knowledge_extraction::relationship::implication
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "cr_knowledge_extraction/proposition.hpp"
+
+#include <commonroad_cpp/auxiliaryDefs/types_and_definitions.h>
+#include <commonroad_cpp/world.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace knowledge_extraction {
+/**
+ * Instantiate propositions for all time steps of a horizon, e.g. for benchmarks or batch runs without a formula.
+ *
+ * Propositions of predicates that only refer to the ego vehicle are instantiated once per time step, all others once
+ * per obstacle that exists at the time step.
+ *
+ * @param world The world.
+ * @param propositions The propositions to instantiate.
+ * @param initial_time_step The initial time step of the ego vehicle in the scenario.
+ * @param horizon The number of time steps.
+ * @return The relevant propositions keyed by formula time steps in [0, horizon), as expected by the extraction
+ *     interface.
+ */
+std::unordered_map<time_step_t, std::vector<std::string>>
+make_relevant_propositions(const World &world, const std::vector<Proposition> &propositions,
+                           time_step_t initial_time_step, time_step_t horizon);
+} // namespace knowledge_extraction
@@ -8,6 +8,7 @@ namespace knowledge_extraction::road_network {
  */
 struct CurvilinearLanelet {
     const std::shared_ptr<Lanelet> lanelet;
+    // Polygon with the (s, d) coordinates of the border vertices of the lanelet, s is stored as x and d as y
     const polygon_type curvilinear_polygon;
 };
 } // namespace knowledge_extraction::road_network
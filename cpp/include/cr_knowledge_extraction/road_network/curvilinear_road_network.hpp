@@ -3,19 +3,46 @@
 #include "cr_knowledge_extraction/ego_behavior/sets/box.hpp"
 #include "cr_knowledge_extraction/road_network/curvilinear_lanelet.hpp"
 
+#include <boost/geometry/index/rtree.hpp>
 #include <commonroad_cpp/roadNetwork/road_network.h>
 #include <geometry/curvilinear_coordinate_system.h>
 
+#include <optional>
+
 namespace knowledge_extraction::road_network {
 class CurvilinearRoadNetwork {
   private:
+    using box_type = boost::geometry::model::box<point_type>;
+    using rtree_value_type = std::pair<box_type, size_t>;
+
+    // Projected edges between border vertices are straight lines in the CCS, while the actual borders are slightly
+    // curved. Queries are enlarged by this margin (in m) to stay conservative.
+    static constexpr double query_margin = 0.05;
+
     const std::shared_ptr<RoadNetwork> road_network;
     const std::shared_ptr<geometry::CurvilinearCoordinateSystem> ego_ccs;
 
+    // Lanelets in the order of the lanelet network, all of which are fully inside the projection domain
+    std::vector<CurvilinearLanelet> curvilinear_lanelets;
+    boost::geometry::index::rtree<rtree_value_type, boost::geometry::index::rstar<16>> lanelet_tree;
+    // Lanelets that cannot be projected into the CCS, these are returned for every query
+    std::vector<std::shared_ptr<Lanelet>> unprojectable_lanelets;
+
+    /**
+     * Project the border of a lanelet into the CCS.
+     *
+     * @param lanelet The lanelet.
+     * @return The polygon in curvilinear coordinates or std::nullopt if a border vertex is outside of the projection
+     *     domain.
+     */
+    std::optional<polygon_type> project_lanelet(const Lanelet &lanelet) const;
+
   public:
     /**
      * Construct a road network that is described in the curvilinear coordinates of the ego vehicle.
      *
+     * All lanelets are projected into the CCS once and indexed by their curvilinear bounding boxes.
+     *
      * @param road_network The road network in Cartesian coordinates.
      * @param ego_ccs The curvilinear coordinate system of the ego vehicle.
      */
@@ -25,10 +52,20 @@ class CurvilinearRoadNetwork {
     /**
      * Find all lanelets that overlap with the given bounding box.
      *
+     * The query is answered in curvilinear coordinates. Lanelets that cannot be projected into the CCS are always
+     * considered to overlap.
+     *
      * @param ccs_bounding_box The bounding box in curvilinear coordinates.
      * @return The lanelets that overlap with the bounding box.
      */
     std::vector<std::shared_ptr<Lanelet>>
     get_overlapping_lanelets(const knowledge_extraction::ego_behavior::sets::Box2D &ccs_bounding_box) const;
+
+    /**
+     * Get the lanelets that could be projected into the CCS.
+     *
+     * @return The projected lanelets.
+     */
+    const std::vector<CurvilinearLanelet> &get_curvilinear_lanelets() const { return curvilinear_lanelets; }
 };
 } // namespace knowledge_extraction::road_network
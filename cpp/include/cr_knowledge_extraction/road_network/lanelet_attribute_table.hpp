@@ -0,0 +1,283 @@
+#pragma once
+
+#include "cr_knowledge_extraction/id_index.hpp"
+
+#include <commonroad_cpp/roadNetwork/lanelet/lanelet.h>
+#include <commonroad_cpp/roadNetwork/regulatoryElements/regulatory_elements_utils.h>
+#include <commonroad_cpp/roadNetwork/road_network.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace knowledge_extraction::road_network {
+/**
+ * The types and derived adjacency properties of a lanelet as bitmasks.
+ */
+struct LaneletAttributes {
+    // No adjacent lanelet in driving direction on the left or right
+    static constexpr uint8_t leftmost = 1U << 0U;
+    static constexpr uint8_t rightmost = 1U << 1U;
+    // The adjacent lanelet on the left or right has the opposite driving direction
+    static constexpr uint8_t left_neighbour_opposite = 1U << 2U;
+    static constexpr uint8_t right_neighbour_opposite = 1U << 3U;
+
+    // One bit per lanelet type, see type_bit
+    uint64_t types{0};
+    uint8_t flags{0};
+
+    /**
+     * Get the bit of a lanelet type in the type mask.
+     *
+     * @param type The lanelet type.
+     * @return The bit.
+     * @throws std::logic_error If the lanelet type does not fit into the mask.
+     */
+    static uint64_t type_bit(LaneletType type);
+
+    /**
+     * Check whether the lanelet has the given type.
+     *
+     * @param type The lanelet type.
+     * @return True iff the lanelet has the type.
+     */
+    bool has_type(LaneletType type) const { return (types & type_bit(type)) != 0; }
+
+    /**
+     * Check whether the lanelet has at least one of the given flags.
+     *
+     * @param flag_mask The flags combined with bitwise OR.
+     * @return True iff any of the flags is set.
+     */
+    bool has_any_flag(uint8_t flag_mask) const { return (flags & flag_mask) != 0; }
+};
+
+/**
+ * A set of lanelets of a LaneletAttributeTable, stored as one bit per lanelet index.
+ */
+class LaneletSet {
+  private:
+    static constexpr size_t bits_per_word = 64;
+
+    std::vector<uint64_t> words;
+    size_t num_lanelets{0};
+
+  public:
+    /**
+     * Create an empty set.
+     *
+     * @param table_size The number of lanelets in the table.
+     */
+    explicit LaneletSet(size_t table_size) : words((table_size + bits_per_word - 1) / bits_per_word) {}
+
+    /**
+     * Add a lanelet.
+     *
+     * @param lanelet_index The index of the lanelet in the table.
+     */
+    void insert(size_t lanelet_index) {
+        auto &word = words[lanelet_index / bits_per_word];
+        auto bit = uint64_t{1} << (lanelet_index % bits_per_word);
+        num_lanelets += (word & bit) == 0 ? 1 : 0;
+        word |= bit;
+    }
+
+    /**
+     * Check whether a lanelet is part of the set.
+     *
+     * @param lanelet_index The index of the lanelet in the table.
+     * @return True iff the lanelet is part of the set.
+     */
+    bool contains(size_t lanelet_index) const {
+        return (words[lanelet_index / bits_per_word] & (uint64_t{1} << (lanelet_index % bits_per_word))) != 0;
+    }
+
+    /**
+     * Get the number of lanelets in the set.
+     *
+     * @return The number of lanelets.
+     */
+    size_t size() const { return num_lanelets; }
+
+    /**
+     * Check whether the set is empty.
+     *
+     * @return True iff the set contains no lanelet.
+     */
+    bool empty() const { return num_lanelets == 0; }
+};
+
+/**
+ * Attributes of all lanelets of a road network, computed once when the table is created.
+ *
+ * Extractors that only depend on the types of the lanelets the ego vehicle may occupy combine the type masks of these
+ * lanelets with bitwise OR and AND instead of querying each lanelet for each time step. Likewise, the incoming groups
+ * of incoming lanelets are resolved once instead of searching the intersections of the road network, and the priority
+ * signs of each lanelet are evaluated once for each turning direction.
+ */
+class LaneletAttributeTable {
+  private:
+    static constexpr size_t no_incoming_group = SIZE_MAX;
+    // The turning directions left, straight, and right
+    static constexpr size_t num_priority_directions = 3;
+
+    IdIndex lanelet_index;
+    std::vector<LaneletAttributes> attributes;
+    // Flat arrays at the lanelet index, no_incoming_group for lanelets that are not incoming or whose group is missing
+    std::vector<size_t> incoming_group_ids;
+    std::vector<size_t> left_of_incoming_group_ids;
+    // The priority of the lanelet index i for the direction index d is at i * num_priority_directions + d
+    std::vector<int> priorities;
+    // The sorted IDs of the lanelets of all lanes through the lanelet index i are lane_lanelet_ids in the range from
+    // lane_lanelet_offsets[i] to lane_lanelet_offsets[i + 1]
+    std::vector<uint64_t> lane_lanelet_ids;
+    std::vector<size_t> lane_lanelet_offsets{0};
+
+    std::optional<size_t> get_incoming_group_value(const std::vector<size_t> &group_ids, size_t lanelet_id) const;
+
+  public:
+    LaneletAttributeTable() = default;
+
+    /**
+     * Compute the attributes of all lanelets of a road network.
+     *
+     * Incoming lanelets without an incoming group, or whose incoming group is not left of another one, are reported
+     * with a warning once. The lanes through each lanelet are built once, so that the lanes through a set of lanelets
+     * are known without building them again.
+     *
+     * @param road_network The road network, e.g. of a world.
+     * @throws std::invalid_argument If a lanelet ID is not unique.
+     */
+    explicit LaneletAttributeTable(const std::shared_ptr<RoadNetwork> &road_network);
+
+    /**
+     * Get the index of a turning direction in the priority table.
+     *
+     * @param dir The turning direction.
+     * @return The index or std::nullopt if the direction is not left, straight, or right.
+     */
+    static std::optional<size_t> get_priority_direction_index(Direction dir);
+
+    /**
+     * Compute the attributes of a single lanelet.
+     *
+     * @param lanelet The lanelet.
+     * @return The attributes.
+     */
+    static LaneletAttributes compute_attributes(const Lanelet &lanelet);
+
+    /**
+     * Get the compact index of a lanelet.
+     *
+     * @param lanelet_id The ID of the lanelet.
+     * @return The index or std::nullopt if the lanelet is not part of the table.
+     */
+    std::optional<size_t> get_lanelet_index(size_t lanelet_id) const { return lanelet_index.find(lanelet_id); }
+
+    /**
+     * Get the attributes of a lanelet.
+     *
+     * @param lanelet The lanelet, lanelets that are not part of the table are computed on the fly.
+     * @return The attributes.
+     */
+    LaneletAttributes get_attributes(const std::shared_ptr<Lanelet> &lanelet) const;
+
+    /**
+     * Get the types that at least one of the given lanelets has.
+     *
+     * @param lanelets The lanelets.
+     * @return The bitwise OR of the type masks, zero if there are no lanelets.
+     */
+    uint64_t get_types_of_any(const std::vector<std::shared_ptr<Lanelet>> &lanelets) const;
+
+    /**
+     * Get the types that all of the given lanelets have.
+     *
+     * @param lanelets The lanelets.
+     * @return The bitwise AND of the type masks, all bits are set if there are no lanelets.
+     */
+    uint64_t get_types_of_all(const std::vector<std::shared_ptr<Lanelet>> &lanelets) const;
+
+    /**
+     * Collect lanelets into a set over the lanelet indices of this table.
+     *
+     * @param lanelets The lanelets, lanelets that are not part of the table are skipped.
+     * @return The set.
+     */
+    LaneletSet make_lanelet_set(const std::vector<std::shared_ptr<Lanelet>> &lanelets) const;
+
+    /**
+     * Check whether a lanelet is part of a set.
+     *
+     * @param lanelet_set The set, created by this table.
+     * @param lanelet The lanelet.
+     * @return True iff the lanelet is part of the table and of the set.
+     */
+    bool contains(const LaneletSet &lanelet_set, const std::shared_ptr<Lanelet> &lanelet) const {
+        auto index = lanelet_index.find(lanelet->getId());
+        return index.has_value() && lanelet_set.contains(index.value());
+    }
+
+    /**
+     * Get the incoming group of an incoming lanelet.
+     *
+     * @param lanelet_id The ID of the lanelet.
+     * @return The ID of the incoming group or std::nullopt if the lanelet is unknown, not an incoming lanelet, or has
+     *     no incoming group.
+     */
+    std::optional<size_t> get_incoming_group_id(size_t lanelet_id) const {
+        return get_incoming_group_value(incoming_group_ids, lanelet_id);
+    }
+
+    /**
+     * Get the incoming group that the incoming group of a lanelet is left of.
+     *
+     * @param lanelet_id The ID of the lanelet.
+     * @return The ID of the incoming group or std::nullopt if the lanelet is unknown, not an incoming lanelet, or its
+     *     incoming group is missing or not left of another one.
+     */
+    std::optional<size_t> get_left_of_incoming_group_id(size_t lanelet_id) const {
+        return get_incoming_group_value(left_of_incoming_group_ids, lanelet_id);
+    }
+
+    /**
+     * Get the priority that the traffic signs of a lanelet give to vehicles turning in the given direction.
+     *
+     * @param lanelet The lanelet, lanelets that are not part of the table are evaluated on the fly.
+     * @param dir The turning direction, directions other than left, straight, and right are evaluated on the fly.
+     * @return The priority, std::numeric_limits<int>::min() if no sign determines it.
+     */
+    int get_priority(const std::shared_ptr<Lanelet> &lanelet, Direction dir) const;
+
+    /**
+     * Get the range of the priorities of the given lanelets for a turning direction.
+     *
+     * @param lanelets The lanelets, must not be empty.
+     * @param dir The turning direction.
+     * @return A pair of the minimum and maximum priority.
+     * @throws std::invalid_argument If there are no lanelets.
+     */
+    std::pair<int, int> get_priority_range(const std::vector<std::shared_ptr<Lanelet>> &lanelets, Direction dir) const;
+
+    /**
+     * Get the lanelets of all lanes through a lanelet.
+     *
+     * @param lanelet_index The index of the lanelet in the table.
+     * @return The sorted and unique lanelet IDs.
+     */
+    std::span<const uint64_t> get_lane_lanelet_ids(size_t lanelet_index) const {
+        auto first = lane_lanelet_offsets[lanelet_index];
+        return std::span<const uint64_t>{lane_lanelet_ids}.subspan(first, lane_lanelet_offsets[lanelet_index + 1] - first);
+    }
+
+    /**
+     * Get the number of lanelets in the table.
+     *
+     * @return The number of lanelets.
+     */
+    size_t size() const { return attributes.size(); }
+};
+} // namespace knowledge_extraction::road_network
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "cr_knowledge_extraction/anytime.hpp"
+#include "cr_knowledge_extraction/proposition.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace knowledge_extraction {
+/**
+ * The caches of the environment model for which hits and misses are counted.
+ */
+enum class CacheKind : uint8_t {
+    OBSTACLE_LANE_IDS,
+    TURNING_DIRECTIONS,
+    PRIORITY,
+    OBSTACLE_REAR,
+    STOPPING_S,
+    REFERENCE_LANE,
+};
+
+/**
+ * The phases of an extraction.
+ */
+enum class ExtractionPhase : uint8_t {
+    // Precomputation of the reachable bounds of the ego vehicle
+    PRECOMPUTATION,
+    KLEENE,
+    RELATIONSHIP,
+    ANYTIME,
+};
+
+/**
+ * Runtime statistics of a single extractor.
+ *
+ * Times are summed over all calls in s, so with several threads they may exceed the elapsed time.
+ */
+struct ExtractorStatistics {
+    ExtractorKind kind;
+    Proposition proposition;
+    size_t num_calls{0};
+    double creation_time{0};
+    double extraction_time{0};
+    // The number of extracted pieces of knowledge
+    size_t num_decided{0};
+};
+
+/**
+ * Hits and misses of a single cache.
+ */
+struct CacheStatistics {
+    CacheKind cache;
+    size_t hits{0};
+    size_t misses{0};
+};
+
+/**
+ * Elapsed time in s and extracted pieces of knowledge of a single phase.
+ */
+struct PhaseStatistics {
+    ExtractionPhase phase;
+    size_t num_runs{0};
+    double wall_time{0};
+    size_t num_decided{0};
+};
+
+/**
+ * A snapshot of the runtime statistics of the extraction.
+ *
+ * Only extractors and phases that ran are listed, all caches are listed.
+ */
+struct ExtractionStatistics {
+    std::vector<ExtractorStatistics> extractors;
+    std::vector<CacheStatistics> caches;
+    std::vector<PhaseStatistics> phases;
+    size_t num_overlapping_lanelet_queries{0};
+    size_t num_lane_constructions{0};
+};
+
+/**
+ * Collects runtime statistics of the extraction from multiple threads.
+ *
+ * Collection is disabled by default. While disabled, every recording function returns after a single relaxed atomic
+ * load, and no clock is read.
+ */
+class StatisticsCollector {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+  private:
+    static constexpr size_t num_propositions =
+        static_cast<size_t>(Proposition::OTHER_HAS_STRAIGHT_STRAIGHT_PRIORITY) + 1;
+    static constexpr size_t num_extractor_kinds = 2;
+    static constexpr size_t num_caches = static_cast<size_t>(CacheKind::REFERENCE_LANE) + 1;
+    static constexpr size_t num_phases = static_cast<size_t>(ExtractionPhase::ANYTIME) + 1;
+
+    std::atomic<bool> enabled{false};
+
+    // Counters are padded to separate cache lines, as different threads usually update different counters
+    struct alignas(64) ExtractorCounters {
+        std::atomic<uint64_t> num_calls{0};
+        std::atomic<uint64_t> creation_ns{0};
+        std::atomic<uint64_t> extraction_ns{0};
+        std::atomic<uint64_t> num_decided{0};
+    };
+    std::array<ExtractorCounters, num_extractor_kinds * num_propositions> extractor_counters;
+
+    struct alignas(64) CacheCounters {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+    };
+    std::array<CacheCounters, num_caches> cache_counters;
+
+    struct alignas(64) PhaseCounters {
+        std::atomic<uint64_t> num_runs{0};
+        std::atomic<uint64_t> wall_ns{0};
+        std::atomic<uint64_t> num_decided{0};
+    };
+    std::array<PhaseCounters, num_phases> phase_counters;
+
+    alignas(64) std::atomic<uint64_t> num_overlapping_lanelet_queries{0};
+    alignas(64) std::atomic<uint64_t> num_lane_constructions{0};
+
+    ExtractorCounters &get_extractor_counters(ExtractorKind kind, Proposition prop) {
+        return extractor_counters[(static_cast<size_t>(kind) * num_propositions) + static_cast<size_t>(prop)];
+    }
+
+    static uint64_t elapsed_ns(Clock::time_point start) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+  public:
+    /**
+     * Check whether statistics are collected.
+     *
+     * @return True iff collection is enabled.
+     */
+    bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Enable or disable the collection of statistics. Already collected statistics are kept.
+     *
+     * @param value Whether to collect statistics.
+     */
+    void set_enabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+
+    /**
+     * Start measuring the time of some work.
+     *
+     * @return The current time or std::nullopt if collection is disabled.
+     */
+    std::optional<Clock::time_point> start_timer() const {
+        if (!is_enabled()) {
+            return std::nullopt;
+        }
+        return Clock::now();
+    }
+
+    /**
+     * Record an access to a cache.
+     *
+     * @param cache The cache.
+     * @param hit Whether the value was already cached.
+     */
+    void record_cache_access(CacheKind cache, bool hit) {
+        if (!is_enabled()) {
+            return;
+        }
+        auto &counters = cache_counters[static_cast<size_t>(cache)];
+        (hit ? counters.hits : counters.misses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Record a query of the lanelets overlapping with a box in the curvilinear road network.
+     */
+    void record_overlapping_lanelet_query() {
+        if (!is_enabled()) {
+            return;
+        }
+        num_overlapping_lanelet_queries.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Record a query of an obstacle that builds lanes through the road network.
+     */
+    void record_lane_construction() {
+        if (!is_enabled()) {
+            return;
+        }
+        num_lane_constructions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Record the creation of an extractor.
+     *
+     * @param kind The kind of the extractor.
+     * @param prop The proposition of the extractor.
+     * @param start The result of start_timer() before the extractor was created.
+     */
+    void record_extractor_creation(ExtractorKind kind, Proposition prop, std::optional<Clock::time_point> start) {
+        if (!start.has_value()) {
+            return;
+        }
+        get_extractor_counters(kind, prop).creation_ns.fetch_add(elapsed_ns(start.value()), std::memory_order_relaxed);
+    }
+
+    /**
+     * Record a single call of an extractor.
+     *
+     * @param kind The kind of the extractor.
+     * @param prop The proposition of the extractor.
+     * @param start The result of start_timer() before the extractor was called.
+     * @param num_decided The number of extracted pieces of knowledge.
+     */
+    void record_extraction(ExtractorKind kind, Proposition prop, std::optional<Clock::time_point> start,
+                           size_t num_decided) {
+        if (!start.has_value()) {
+            return;
+        }
+        auto &counters = get_extractor_counters(kind, prop);
+        counters.num_calls.fetch_add(1, std::memory_order_relaxed);
+        counters.extraction_ns.fetch_add(elapsed_ns(start.value()), std::memory_order_relaxed);
+        counters.num_decided.fetch_add(num_decided, std::memory_order_relaxed);
+    }
+
+    /**
+     * Record a run of an extraction phase.
+     *
+     * @param phase The phase.
+     * @param start The result of start_timer() before the phase started.
+     * @param num_decided The number of extracted pieces of knowledge.
+     */
+    void record_phase(ExtractionPhase phase, std::optional<Clock::time_point> start, size_t num_decided) {
+        if (!start.has_value()) {
+            return;
+        }
+        auto &counters = phase_counters[static_cast<size_t>(phase)];
+        counters.num_runs.fetch_add(1, std::memory_order_relaxed);
+        counters.wall_ns.fetch_add(elapsed_ns(start.value()), std::memory_order_relaxed);
+        counters.num_decided.fetch_add(num_decided, std::memory_order_relaxed);
+    }
+
+    /**
+     * Reset all statistics to zero.
+     *
+     * Work that is recorded concurrently may be partially counted.
+     */
+    void reset();
+
+    /**
+     * Get a snapshot of the collected statistics.
+     *
+     * @return The statistics.
+     */
+    ExtractionStatistics get_statistics() const;
+};
+} // namespace knowledge_extraction
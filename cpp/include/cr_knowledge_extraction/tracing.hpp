@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace knowledge_extraction::tracing {
+/**
+ * Check whether tracing support was compiled in, i.e., the library was built with CR_KNOWLEDGE_EXTRACTION_TRACING.
+ *
+ * @return True iff zones are recorded while tracing is active.
+ */
+constexpr bool is_available() {
+#ifdef CR_KNOWLEDGE_EXTRACTION_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Check whether zones are currently recorded.
+ *
+ * @return True iff tracing is active.
+ */
+bool is_active();
+
+/**
+ * Start recording zones, discarding all zones of a previous recording that was not written.
+ *
+ * Without tracing support, a warning is logged and nothing is recorded.
+ */
+void start();
+
+/**
+ * Stop recording zones and write them to a file in the Chrome trace event format, which can be opened in Perfetto.
+ *
+ * Must not be called while zones are still open on other threads, i.e., while knowledge is extracted.
+ *
+ * @param path The path of the JSON file.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void stop(const std::string &path);
+
+/**
+ * Records the time between its construction and destruction as a trace event on the current thread.
+ *
+ * Use the CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE macros instead of this class, so that zones compile out without tracing
+ * support.
+ */
+class Zone {
+  private:
+    const char *name;
+    const char *detail;
+    std::chrono::steady_clock::time_point start;
+
+  public:
+    /**
+     * Open a zone.
+     *
+     * @param name The name of the zone, must outlive the recording, e.g. a string literal.
+     * @param detail Additional information shown with the zone or nullptr, must outlive the recording.
+     */
+    explicit Zone(const char *name, const char *detail = nullptr);
+    ~Zone();
+
+    Zone(const Zone &) = delete;
+    Zone &operator=(const Zone &) = delete;
+};
+} // namespace knowledge_extraction::tracing
+
+#define CR_KNOWLEDGE_EXTRACTION_TRACE_CONCAT_IMPL(a, b) a##b
+#define CR_KNOWLEDGE_EXTRACTION_TRACE_CONCAT(a, b) CR_KNOWLEDGE_EXTRACTION_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef CR_KNOWLEDGE_EXTRACTION_TRACING
+/**
+ * Record the rest of the enclosing scope as a zone with the given name.
+ */
+#define CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE(name)                                                                      \
+    const ::knowledge_extraction::tracing::Zone CR_KNOWLEDGE_EXTRACTION_TRACE_CONCAT(trace_zone_, __LINE__) { name }
+/**
+ * Record the rest of the enclosing scope as a zone with the given name and detail.
+ *
+ * The detail expression is only evaluated while tracing is active.
+ */
+#define CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE_DETAIL(name, detail)                                                       \
+    const ::knowledge_extraction::tracing::Zone CR_KNOWLEDGE_EXTRACTION_TRACE_CONCAT(trace_zone_, __LINE__) {         \
+        name, ::knowledge_extraction::tracing::is_active() ? (detail) : nullptr                                       \
+    }
+#else
+#define CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE(name) static_cast<void>(0)
+#define CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE_DETAIL(name, detail) static_cast<void>(0)
+#endif
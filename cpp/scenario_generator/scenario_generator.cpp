@@ -0,0 +1,602 @@
+#include "scenario_generator.hpp"
+
+#include <commonroad_cpp/interfaces/commonroad/input_utils.h>
+
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace knowledge_extraction::scenario_generator;
+using knowledge_extraction::ego_behavior::EgoParameters;
+
+namespace {
+using Polyline = std::vector<Eigen::Vector2d>;
+
+// Distance between consecutive vertices of straight lanelet bounds
+constexpr double vertex_spacing = 10;
+// Number of vertices of the curved bounds of turning lanelets
+constexpr size_t num_arc_vertices = 8;
+// Distance between the incoming lanelets and the area of an intersection, which is the inner radius of right turns
+constexpr double intersection_margin = 4;
+// Longitudinal distance over which obstacles change lanes
+constexpr double lane_change_length = 40;
+constexpr double lane_change_probability = 0.3;
+
+struct LaneletSpec {
+    Polyline left_bound;
+    Polyline right_bound;
+    std::vector<size_t> predecessors;
+    std::vector<size_t> successors;
+    // The adjacent lanelet and whether it has the same driving direction
+    std::optional<std::pair<size_t, bool>> adjacent_left;
+    std::optional<std::pair<size_t, bool>> adjacent_right;
+    std::vector<std::string> types;
+    std::vector<size_t> traffic_signs;
+    // The traffic sign of the stop line at the end of the lanelet
+    std::optional<size_t> stop_line_sign;
+};
+
+struct TrafficSignSpec {
+    size_t id;
+    // The German traffic sign ID, e.g. 206 for stop
+    std::string sign_id;
+    Eigen::Vector2d position;
+};
+
+struct IncomingSpec {
+    size_t id;
+    size_t incoming_lanelet;
+    size_t successor_right;
+    size_t successor_straight;
+    size_t successor_left;
+    // The incoming on the right, i.e., this incoming is left of it
+    size_t left_of;
+};
+
+struct IntersectionSpec {
+    size_t id;
+    std::vector<IncomingSpec> incomings;
+};
+
+struct ObstacleState {
+    Eigen::Vector2d position;
+    double orientation;
+};
+
+struct ObstacleSpec {
+    size_t id;
+    double velocity;
+    std::vector<ObstacleState> states;
+};
+
+// Straight route of the ego vehicle, which is also used as reference path
+struct EgoRoute {
+    Eigen::Vector2d start;
+    Eigen::Vector2d end;
+    double initial_offset;
+    double initial_velocity;
+};
+
+struct ScenarioSpec {
+    // IDs are shared by all elements of a scenario
+    size_t next_id{1};
+    std::map<size_t, LaneletSpec> lanelets;
+    std::vector<TrafficSignSpec> traffic_signs;
+    std::vector<IntersectionSpec> intersections;
+    std::vector<ObstacleSpec> obstacles;
+    // The lanelets on which obstacles may start
+    std::vector<size_t> start_lanelets;
+
+    size_t add_lanelet(Polyline left_bound, Polyline right_bound, std::vector<std::string> types) {
+        auto id = next_id++;
+        lanelets.emplace(id, LaneletSpec{std::move(left_bound), std::move(right_bound), {}, {}, std::nullopt,
+                                         std::nullopt, std::move(types), {}, std::nullopt});
+        return id;
+    }
+
+    void connect(size_t predecessor, size_t successor) {
+        lanelets.at(predecessor).successors.push_back(successor);
+        lanelets.at(successor).predecessors.push_back(predecessor);
+    }
+
+    void set_adjacent(size_t left, size_t right) {
+        lanelets.at(right).adjacent_left = {left, true};
+        lanelets.at(left).adjacent_right = {right, true};
+    }
+
+    void set_opposite(size_t lanelet, size_t other) {
+        lanelets.at(lanelet).adjacent_left = {other, false};
+        lanelets.at(other).adjacent_left = {lanelet, false};
+    }
+};
+
+Polyline straight_line(const Eigen::Vector2d &from, const Eigen::Vector2d &to) {
+    auto num_vertices = std::max<size_t>(2, static_cast<size_t>(std::ceil((to - from).norm() / vertex_spacing)) + 1);
+    Polyline line;
+    line.reserve(num_vertices);
+    for (size_t i = 0; i < num_vertices; ++i) {
+        line.emplace_back(from + ((to - from) * static_cast<double>(i) / static_cast<double>(num_vertices - 1)));
+    }
+    return line;
+}
+
+Polyline arc(const Eigen::Vector2d &center, double radius, double start_angle, double end_angle) {
+    Polyline line;
+    line.reserve(num_arc_vertices);
+    for (size_t i = 0; i < num_arc_vertices; ++i) {
+        auto angle = start_angle + ((end_angle - start_angle) * static_cast<double>(i) /
+                                    static_cast<double>(num_arc_vertices - 1));
+        line.emplace_back(center + (radius * Eigen::Vector2d{std::cos(angle), std::sin(angle)}));
+    }
+    return line;
+}
+
+// Rotate by a multiple of 90 degrees around the origin and move to the given center
+Polyline transform(const Polyline &line, const Eigen::Vector2d &center, size_t rotation) {
+    Eigen::Rotation2Dd rotation_matrix{static_cast<double>(rotation) * std::numbers::pi / 2};
+    Polyline transformed;
+    transformed.reserve(line.size());
+    for (const auto &vertex : line) {
+        transformed.emplace_back(center + (rotation_matrix * vertex));
+    }
+    return transformed;
+}
+
+Polyline center_line(const LaneletSpec &lanelet) {
+    Polyline line;
+    line.reserve(lanelet.left_bound.size());
+    for (size_t i = 0; i < lanelet.left_bound.size(); ++i) {
+        line.emplace_back((lanelet.left_bound[i] + lanelet.right_bound[i]) / 2);
+    }
+    return line;
+}
+
+double length(const Polyline &line) {
+    double result = 0;
+    for (size_t i = 1; i < line.size(); ++i) {
+        result += (line[i] - line[i - 1]).norm();
+    }
+    return result;
+}
+
+EgoRoute build_highway(ScenarioSpec &spec, const ScenarioParameters &params) {
+    auto width = params.lane_width;
+    auto segment_length = params.segment_length;
+
+    // Lane 0 is the rightmost lane, all lanes run in positive x direction
+    std::vector<std::vector<size_t>> lanes(params.num_lanes);
+    for (size_t lane = 0; lane < params.num_lanes; ++lane) {
+        auto y_right = static_cast<double>(lane) * width;
+        for (size_t segment = 0; segment < params.num_segments; ++segment) {
+            auto x_start = static_cast<double>(segment) * segment_length;
+            auto id = spec.add_lanelet(straight_line({x_start, y_right + width}, {x_start + segment_length, y_right + width}),
+                                       straight_line({x_start, y_right}, {x_start + segment_length, y_right}),
+                                       {"interstate", "mainCarriageWay"});
+            spec.start_lanelets.push_back(id);
+            if (segment > 0) {
+                spec.connect(lanes[lane].back(), id);
+            }
+            if (lane > 0) {
+                spec.set_adjacent(id, lanes[lane - 1][segment]);
+            }
+            lanes[lane].push_back(id);
+        }
+    }
+
+    if (params.layout == RoadLayout::ON_RAMP) {
+        // Each ramp runs along two segments and can only be left to the main carriageway in its last segment
+        for (size_t first_segment = 0; first_segment < params.num_segments; first_segment += 3) {
+            auto last_segment = std::min(first_segment + 1, params.num_segments - 1);
+            std::optional<size_t> previous;
+            for (auto segment = first_segment; segment <= last_segment; ++segment) {
+                auto x_start = static_cast<double>(segment) * segment_length;
+                auto id = spec.add_lanelet(straight_line({x_start, 0}, {x_start + segment_length, 0}),
+                                           straight_line({x_start, -width}, {x_start + segment_length, -width}),
+                                           {"interstate", "accessRamp"});
+                spec.start_lanelets.push_back(id);
+                if (previous.has_value()) {
+                    spec.connect(previous.value(), id);
+                }
+                if (segment == last_segment) {
+                    spec.set_adjacent(lanes[0][segment], id);
+                }
+                previous = id;
+            }
+        }
+    }
+
+    auto total_length = static_cast<double>(params.num_segments) * segment_length;
+    return {{0, width / 2}, {total_length, width / 2}, 10, 25};
+}
+
+EgoRoute build_intersections(ScenarioSpec &spec, const ScenarioParameters &params) {
+    auto width = params.lane_width;
+    auto arm_length = params.segment_length;
+    // Half size of an intersection, the incoming lanelets end at this distance from its center
+    auto half_size = width + intersection_margin;
+    auto spacing = (2 * half_size) + arm_length;
+
+    // Each arm consists of an incoming lanelet towards the intersection and an outgoing lanelet away from it
+    struct Arm {
+        size_t incoming;
+        size_t outgoing;
+    };
+    std::optional<Arm> previous_east_arm;
+    for (size_t i = 0; i < params.num_segments; ++i) {
+        Eigen::Vector2d center{static_cast<double>(i) * spacing, 0};
+
+        // All geometry is described for the arm in negative x direction (rotation 0) and rotated counterclockwise,
+        // i.e., rotation 1 is the southern, 2 the eastern and 3 the northern arm
+        std::array<Arm, 4> arms{};
+        for (size_t rotation = 0; rotation < 4; ++rotation) {
+            if (rotation == 0 && previous_east_arm.has_value()) {
+                // The road between two intersections is shared, what leaves one intersection enters the next one
+                arms[0] = {previous_east_arm->outgoing, previous_east_arm->incoming};
+                continue;
+            }
+            auto incoming = spec.add_lanelet(
+                transform(straight_line({-half_size - arm_length, 0}, {-half_size, 0}), center, rotation),
+                transform(straight_line({-half_size - arm_length, -width}, {-half_size, -width}), center, rotation),
+                {"urban"});
+            auto outgoing = spec.add_lanelet(
+                transform(straight_line({-half_size, 0}, {-half_size - arm_length, 0}), center, rotation),
+                transform(straight_line({-half_size, width}, {-half_size - arm_length, width}), center, rotation),
+                {"urban"});
+            spec.set_opposite(incoming, outgoing);
+            spec.start_lanelets.push_back(incoming);
+            spec.start_lanelets.push_back(outgoing);
+            arms[rotation] = {incoming, outgoing};
+        }
+        previous_east_arm = arms[2];
+
+        std::array<size_t, 4> incoming_ids{};
+        for (auto &id : incoming_ids) {
+            id = spec.next_id++;
+        }
+        IntersectionSpec intersection{spec.next_id++, {}};
+        for (size_t rotation = 0; rotation < 4; ++rotation) {
+            constexpr auto quarter = std::numbers::pi / 2;
+            auto straight = spec.add_lanelet(
+                transform(straight_line({-half_size, 0}, {half_size, 0}), center, rotation),
+                transform(straight_line({-half_size, -width}, {half_size, -width}), center, rotation),
+                {"urban", "intersection"});
+            auto right = spec.add_lanelet(
+                transform(arc({-half_size, -half_size}, half_size, quarter, 0), center, rotation),
+                transform(arc({-half_size, -half_size}, intersection_margin, quarter, 0), center, rotation),
+                {"urban", "intersection"});
+            auto left = spec.add_lanelet(
+                transform(arc({-half_size, half_size}, half_size, -quarter, 0), center, rotation),
+                transform(arc({-half_size, half_size}, half_size + width, -quarter, 0), center, rotation),
+                {"urban", "intersection"});
+            spec.connect(arms[rotation].incoming, straight);
+            spec.connect(arms[rotation].incoming, right);
+            spec.connect(arms[rotation].incoming, left);
+            spec.connect(straight, arms[(rotation + 2) % 4].outgoing);
+            spec.connect(right, arms[(rotation + 1) % 4].outgoing);
+            spec.connect(left, arms[(rotation + 3) % 4].outgoing);
+
+            // The main road in x direction has priority, the side roads alternate between yield and stop signs
+            std::string sign_id = rotation % 2 == 0 ? "306" : (i % 2 == 0 ? "205" : "206");
+            auto sign = spec.next_id++;
+            spec.traffic_signs.push_back(
+                {sign, sign_id, transform({{-half_size, -width - 1}}, center, rotation).front()});
+            auto &incoming_lanelet = spec.lanelets.at(arms[rotation].incoming);
+            incoming_lanelet.traffic_signs.push_back(sign);
+            if (sign_id == "206") {
+                incoming_lanelet.stop_line_sign = sign;
+            }
+
+            intersection.incomings.push_back({incoming_ids[rotation], arms[rotation].incoming, right, straight, left,
+                                              incoming_ids[(rotation + 1) % 4]});
+        }
+        spec.intersections.push_back(std::move(intersection));
+    }
+
+    // The ego vehicle drives along the main road in positive x direction
+    auto x_end = (static_cast<double>(params.num_segments - 1) * spacing) + half_size + arm_length;
+    return {{-half_size - arm_length, -width / 2}, {x_end, -width / 2}, 10, 10};
+}
+
+void generate_obstacles(ScenarioSpec &spec, const ScenarioParameters &params, std::mt19937 &rng) {
+    auto highway = params.layout != RoadLayout::INTERSECTIONS;
+    std::uniform_real_distribution<double> velocity_distribution{highway ? 20.0 : 6.0, highway ? 35.0 : 12.0};
+    std::uniform_int_distribution<size_t> start_distribution{0, spec.start_lanelets.size() - 1};
+    std::bernoulli_distribution lane_change_distribution{lane_change_probability};
+
+    for (size_t n = 0; n < params.num_obstacles; ++n) {
+        auto current = spec.start_lanelets[start_distribution(rng)];
+        auto path = center_line(spec.lanelets.at(current));
+        auto offset = std::uniform_real_distribution<double>{0, length(path) / 2}(rng);
+        auto velocity = velocity_distribution(rng);
+        auto required_length =
+            offset + (velocity * static_cast<double>(params.num_time_steps - 1) * params.time_step_size);
+
+        // Random walk along the successors, possibly switching to the successor of an adjacent lanelet
+        while (length(path) < required_length) {
+            const auto &lanelet = spec.lanelets.at(current);
+            auto candidates = lanelet.successors;
+            auto lane_change = false;
+            if (lane_change_distribution(rng)) {
+                std::vector<size_t> adjacent;
+                for (const auto &neighbor : {lanelet.adjacent_left, lanelet.adjacent_right}) {
+                    if (neighbor.has_value() && neighbor->second) {
+                        adjacent.push_back(neighbor->first);
+                    }
+                }
+                if (!adjacent.empty()) {
+                    auto target = adjacent[std::uniform_int_distribution<size_t>{0, adjacent.size() - 1}(rng)];
+                    if (!spec.lanelets.at(target).successors.empty()) {
+                        candidates = spec.lanelets.at(target).successors;
+                        lane_change = true;
+                    }
+                }
+            }
+            if (candidates.empty()) {
+                break;
+            }
+            current = candidates[std::uniform_int_distribution<size_t>{0, candidates.size() - 1}(rng)];
+
+            auto next = center_line(spec.lanelets.at(current));
+            if (lane_change) {
+                // Change lanes diagonally instead of jumping to the adjacent lane
+                auto end = path.back();
+                while (path.size() > 1 && (path.back() - end).norm() < lane_change_length) {
+                    path.pop_back();
+                }
+                path.insert(path.end(), next.begin(), next.end());
+            } else {
+                path.insert(path.end(), next.begin() + 1, next.end());
+            }
+        }
+
+        // Sample the path with constant velocity, the obstacle disappears at its end
+        ObstacleSpec obstacle{0, velocity, {}};
+        size_t segment = 1;
+        double segment_start = 0;
+        for (size_t time_step = 0; time_step < params.num_time_steps; ++time_step) {
+            auto s = offset + (velocity * static_cast<double>(time_step) * params.time_step_size);
+            while (segment < path.size() && segment_start + (path[segment] - path[segment - 1]).norm() < s) {
+                segment_start += (path[segment] - path[segment - 1]).norm();
+                ++segment;
+            }
+            if (segment >= path.size()) {
+                break;
+            }
+            Eigen::Vector2d direction = path[segment] - path[segment - 1];
+            Eigen::Vector2d position = path[segment - 1] + (direction.normalized() * (s - segment_start));
+            obstacle.states.push_back({position, std::atan2(direction.y(), direction.x())});
+        }
+        obstacle.id = spec.next_id++;
+        spec.obstacles.push_back(std::move(obstacle));
+    }
+}
+
+void write_point(std::ostream &out, const Eigen::Vector2d &point, const std::string &indent) {
+    out << indent << "<point>\n"
+        << indent << "  <x>" << point.x() << "</x>\n"
+        << indent << "  <y>" << point.y() << "</y>\n"
+        << indent << "</point>\n";
+}
+
+void write_bound(std::ostream &out, const std::string &tag, const Polyline &bound) {
+    out << "    <" << tag << ">\n";
+    for (const auto &vertex : bound) {
+        write_point(out, vertex, "      ");
+    }
+    out << "    </" << tag << ">\n";
+}
+
+void write_lanelet(std::ostream &out, size_t id, const LaneletSpec &lanelet) {
+    out << "  <lanelet id=\"" << id << "\">\n";
+    write_bound(out, "leftBound", lanelet.left_bound);
+    write_bound(out, "rightBound", lanelet.right_bound);
+    for (auto predecessor : lanelet.predecessors) {
+        out << "    <predecessor ref=\"" << predecessor << "\"/>\n";
+    }
+    for (auto successor : lanelet.successors) {
+        out << "    <successor ref=\"" << successor << "\"/>\n";
+    }
+    if (lanelet.adjacent_left.has_value()) {
+        out << "    <adjacentLeft ref=\"" << lanelet.adjacent_left->first << "\" drivingDir=\""
+            << (lanelet.adjacent_left->second ? "same" : "opposite") << "\"/>\n";
+    }
+    if (lanelet.adjacent_right.has_value()) {
+        out << "    <adjacentRight ref=\"" << lanelet.adjacent_right->first << "\" drivingDir=\""
+            << (lanelet.adjacent_right->second ? "same" : "opposite") << "\"/>\n";
+    }
+    if (lanelet.stop_line_sign.has_value()) {
+        out << "    <stopLine>\n";
+        write_point(out, lanelet.left_bound.back(), "      ");
+        write_point(out, lanelet.right_bound.back(), "      ");
+        out << "      <lineMarking>solid</lineMarking>\n"
+            << "      <trafficSignRef ref=\"" << lanelet.stop_line_sign.value() << "\"/>\n"
+            << "    </stopLine>\n";
+    }
+    for (const auto &type : lanelet.types) {
+        out << "    <laneletType>" << type << "</laneletType>\n";
+    }
+    for (auto sign : lanelet.traffic_signs) {
+        out << "    <trafficSignRef ref=\"" << sign << "\"/>\n";
+    }
+    out << "  </lanelet>\n";
+}
+
+void write_traffic_sign(std::ostream &out, const TrafficSignSpec &sign) {
+    out << "  <trafficSign id=\"" << sign.id << "\">\n"
+        << "    <trafficSignElement>\n"
+        << "      <trafficSignID>" << sign.sign_id << "</trafficSignID>\n"
+        << "    </trafficSignElement>\n"
+        << "    <position>\n";
+    write_point(out, sign.position, "      ");
+    out << "    </position>\n"
+        << "    <virtual>false</virtual>\n"
+        << "  </trafficSign>\n";
+}
+
+void write_intersection(std::ostream &out, const IntersectionSpec &intersection) {
+    out << "  <intersection id=\"" << intersection.id << "\">\n";
+    for (const auto &incoming : intersection.incomings) {
+        out << "    <incoming id=\"" << incoming.id << "\">\n"
+            << "      <incomingLanelet ref=\"" << incoming.incoming_lanelet << "\"/>\n"
+            << "      <successorsRight ref=\"" << incoming.successor_right << "\"/>\n"
+            << "      <successorsStraight ref=\"" << incoming.successor_straight << "\"/>\n"
+            << "      <successorsLeft ref=\"" << incoming.successor_left << "\"/>\n"
+            << "      <isLeftOf ref=\"" << incoming.left_of << "\"/>\n"
+            << "    </incoming>\n";
+    }
+    out << "  </intersection>\n";
+}
+
+void write_state(std::ostream &out, size_t time_step, const ObstacleState &state, double velocity,
+                 const std::string &indent) {
+    out << indent << "<time>\n" << indent << "  <exact>" << time_step << "</exact>\n" << indent << "</time>\n";
+    out << indent << "<position>\n";
+    write_point(out, state.position, indent + "  ");
+    out << indent << "</position>\n";
+    out << indent << "<orientation>\n"
+        << indent << "  <exact>" << state.orientation << "</exact>\n"
+        << indent << "</orientation>\n"
+        << indent << "<velocity>\n"
+        << indent << "  <exact>" << velocity << "</exact>\n"
+        << indent << "</velocity>\n"
+        << indent << "<acceleration>\n"
+        << indent << "  <exact>0.0</exact>\n"
+        << indent << "</acceleration>\n";
+}
+
+void write_obstacle(std::ostream &out, const ObstacleSpec &obstacle) {
+    out << "  <dynamicObstacle id=\"" << obstacle.id << "\">\n"
+        << "    <type>car</type>\n"
+        << "    <shape>\n"
+        << "      <rectangle>\n"
+        << "        <length>4.5</length>\n"
+        << "        <width>1.8</width>\n"
+        << "      </rectangle>\n"
+        << "    </shape>\n"
+        << "    <initialState>\n";
+    write_state(out, 0, obstacle.states.front(), obstacle.velocity, "      ");
+    out << "    </initialState>\n";
+    if (obstacle.states.size() > 1) {
+        out << "    <trajectory>\n";
+        for (size_t time_step = 1; time_step < obstacle.states.size(); ++time_step) {
+            out << "      <state>\n";
+            write_state(out, time_step, obstacle.states[time_step], obstacle.velocity, "        ");
+            out << "      </state>\n";
+        }
+        out << "    </trajectory>\n";
+    }
+    out << "  </dynamicObstacle>\n";
+}
+
+void validate(const ScenarioParameters &params) {
+    if (params.num_lanes == 0 || params.num_segments == 0 || params.num_time_steps == 0) {
+        throw std::invalid_argument("The number of lanes, segments and time steps must be positive");
+    }
+    // Obstacles start in the first half of a lanelet and must not leave the map before their second time step
+    if (params.segment_length < vertex_spacing || params.lane_width <= 0 || params.time_step_size <= 0) {
+        throw std::invalid_argument("The segment length must be at least " + std::to_string(vertex_spacing) +
+                                    " m, the lane width and time step size must be positive");
+    }
+}
+
+std::pair<ScenarioSpec, EgoRoute> build_scenario(const ScenarioParameters &params) {
+    validate(params);
+    ScenarioSpec spec;
+    auto route =
+        params.layout == RoadLayout::INTERSECTIONS ? build_intersections(spec, params) : build_highway(spec, params);
+    std::mt19937 rng{params.seed};
+    generate_obstacles(spec, params, rng);
+    return {std::move(spec), route};
+}
+} // namespace
+
+std::string knowledge_extraction::scenario_generator::generate_commonroad_xml(const ScenarioParameters &params) {
+    auto [spec, route] = build_scenario(params);
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(4);
+    // The DEU prefix selects German traffic signs when the scenario is read
+    out << "<?xml version='1.0' encoding='UTF-8'?>\n"
+        << "<commonRoad timeStepSize=\"" << params.time_step_size
+        << "\" commonRoadVersion=\"2020a\" author=\"\" affiliation=\"\" source=\"Synthetic\" "
+           "benchmarkID=\"DEU_Synthetic-1_1_T-1\" date=\"2025-01-01\">\n"
+        << "  <location>\n"
+        << "    <geoNameId>-999</geoNameId>\n"
+        << "    <gpsLatitude>999.0</gpsLatitude>\n"
+        << "    <gpsLongitude>999.0</gpsLongitude>\n"
+        << "  </location>\n"
+        << "  <scenarioTags/>\n";
+    for (const auto &[id, lanelet] : spec.lanelets) {
+        write_lanelet(out, id, lanelet);
+    }
+    for (const auto &sign : spec.traffic_signs) {
+        write_traffic_sign(out, sign);
+    }
+    for (const auto &intersection : spec.intersections) {
+        write_intersection(out, intersection);
+    }
+    for (const auto &obstacle : spec.obstacles) {
+        write_obstacle(out, obstacle);
+    }
+    out << "</commonRoad>\n";
+    return out.str();
+}
+
+GeneratedScenario knowledge_extraction::scenario_generator::generate_scenario(const ScenarioParameters &params) {
+    auto xml = generate_commonroad_xml(params);
+    auto route = build_scenario(params).second;
+
+    // The CommonRoad reader only reads files, the file is removed as soon as the scenario is loaded
+    static std::atomic<size_t> file_counter{0};
+    auto path = std::filesystem::temp_directory_path() /
+                ("cr_knowledge_extraction_synthetic_" + std::to_string(std::random_device{}()) + "_" +
+                 std::to_string(file_counter.fetch_add(1)) + ".xml");
+    {
+        std::ofstream file{path};
+        file << xml;
+        if (!file) {
+            throw std::runtime_error("Cannot write synthetic scenario to " + path.string());
+        }
+    }
+    struct RemoveFile {
+        const std::filesystem::path &path;
+        ~RemoveFile() {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+    } remove_file{path};
+    auto scenario = InputUtils::getDataFromCommonRoad(path.string());
+
+    auto world = std::make_shared<World>("synthetic", 0, scenario.roadNetwork, std::vector<std::shared_ptr<Obstacle>>{},
+                                         scenario.obstacles, scenario.timeStepSize);
+
+    // The reference path extends beyond the map, so that the whole route is inside the projection domain
+    Eigen::Vector2d direction = (route.end - route.start).normalized();
+    geometry::EigenPolyline reference_path{route.start - (50 * direction), (route.start + route.end) / 2,
+                                           route.end + (50 * direction)};
+    auto ccs = std::make_shared<geometry::CurvilinearCoordinateSystem>(reference_path, 100);
+
+    EgoParameters ego_params;
+    Eigen::Vector2d initial_position = route.start + (route.initial_offset * direction);
+    ego_params.initial_state = State{0,
+                                     initial_position.x(),
+                                     initial_position.y(),
+                                     route.initial_velocity,
+                                     0,
+                                     std::atan2(direction.y(), direction.x())};
+
+    return {world, ccs, ego_params};
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "cr_knowledge_extraction/ego_behavior/ego_params.hpp"
+
+#include <commonroad_cpp/world.h>
+#include <geometry/curvilinear_coordinate_system.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace knowledge_extraction::scenario_generator {
+/**
+ * The road layouts that can be generated.
+ */
+enum class RoadLayout : uint8_t {
+    // Straight multi-lane highway
+    HIGHWAY,
+    // Highway with an access ramp on the right every three segments
+    ON_RAMP,
+    // Chain of 4-way intersections with a priority road and yield or stop signs on the side roads
+    INTERSECTIONS,
+};
+
+/**
+ * Parameters of a synthetic scenario, all lengths in m and times in s.
+ */
+struct ScenarioParameters {
+    RoadLayout layout{RoadLayout::HIGHWAY};
+    // Lanes per direction on highways, intersections always have one lane per direction
+    size_t num_lanes{3};
+    // Number of highway segments or intersections, which determines the size of the map
+    size_t num_segments{4};
+    // Length of a highway segment or of the road between two intersections
+    double segment_length{100};
+    double lane_width{3.5};
+    size_t num_obstacles{16};
+    // Number of time steps of the predicted obstacle trajectories, including the initial time step
+    size_t num_time_steps{50};
+    double time_step_size{0.1};
+    uint32_t seed{0};
+};
+
+/**
+ * A generated scenario together with everything that is needed to create an extraction interface on it.
+ */
+struct GeneratedScenario {
+    std::shared_ptr<World> world;
+    // Straight reference path along the route of the ego vehicle
+    std::shared_ptr<geometry::CurvilinearCoordinateSystem> ego_ccs;
+    ego_behavior::EgoParameters ego_params;
+};
+
+/**
+ * Generate a synthetic scenario in the CommonRoad XML format.
+ *
+ * Obstacles follow random routes along the lanelet successors with constant velocity, on highways they may change
+ * lanes. The same parameters always result in the same scenario.
+ *
+ * @param params The parameters of the scenario.
+ * @return The scenario as CommonRoad XML (format version 2020a).
+ * @throws std::invalid_argument If a parameter is out of range.
+ */
+std::string generate_commonroad_xml(const ScenarioParameters &params);
+
+/**
+ * Generate a synthetic scenario and load it into a world.
+ *
+ * The scenario is loaded with the regular CommonRoad reader, so that lanelet adjacencies, intersections and traffic
+ * signs are set up exactly as for recorded scenarios.
+ *
+ * @param params The parameters of the scenario.
+ * @return The world, the CCS and the parameters of the ego vehicle.
+ * @throws std::invalid_argument If a parameter is out of range.
+ */
+GeneratedScenario generate_scenario(const ScenarioParameters &params);
+} // namespace knowledge_extraction::scenario_generator
@@ -0,0 +1,34 @@
+#include "cr_knowledge_extraction/anytime.hpp"
+
+using namespace knowledge_extraction;
+
+ExtractionCost anytime::estimate_cost(Proposition prop, ExtractorKind kind) {
+    if (kind == ExtractorKind::RELATIONSHIP) {
+        switch (prop) {
+        case Proposition::IN_SAME_LANE:
+        case Proposition::IN_FRONT_OF:
+            return ExtractionCost::MODERATE;
+        default:
+            return ExtractionCost::EXPENSIVE;
+        }
+    }
+
+    switch (prop) {
+    case Proposition::ON_MAIN_CARRIAGEWAY:
+    case Proposition::IN_INTERSECTION:
+    case Proposition::ON_MAIN_CARRIAGEWAY_RIGHT_LANE:
+    case Proposition::ON_MAIN_CARRIAGEWAY_LEFT_LANE:
+    case Proposition::OTHER_ON_ACCESS_RAMP:
+    case Proposition::OTHER_ON_MAIN_CARRIAGEWAY:
+    case Proposition::AT_STOP_SIGN:
+    case Proposition::RELEVANT_TRAFFIC_LIGHT:
+    case Proposition::OTHER_TURNING_LEFT:
+    case Proposition::OTHER_GOING_STRAIGHT:
+    case Proposition::OTHER_TURNING_RIGHT:
+        return ExtractionCost::CHEAP;
+    case Proposition::ON_INCOMING_LEFT_OF:
+        return ExtractionCost::EXPENSIVE;
+    default:
+        return ExtractionCost::MODERATE;
+    }
+}
@@ -1,9 +1,12 @@
 #include "cr_knowledge_extraction/ego_behavior/behavior_overapproximation.hpp"
 
-#include <commonroad_cpp/roadNetwork/regulatoryElements/regulatory_elements_utils.h>
+#include "cr_knowledge_extraction/tracing.hpp"
 
+#include <algorithm>
 #include <numbers>
 #include <ranges>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
 using namespace knowledge_extraction::ego_behavior;
@@ -13,22 +16,19 @@ using knowledge_extraction::road_network::CurvilinearLanelet;
 
 BehaviorOverapproximation::BehaviorOverapproximation(
     double dt, const EgoParameters &ego_params,
-    knowledge_extraction::road_network::CurvilinearRoadNetwork ccs_road_network)
-    : ccs_road_network(std::move(ccs_road_network)), system_matrix(make_system_matrix(dt)),
+    std::shared_ptr<const knowledge_extraction::road_network::CurvilinearRoadNetwork> ccs_road_network,
+    std::shared_ptr<const knowledge_extraction::road_network::LaneletAttributeTable> lanelet_attributes,
+    std::shared_ptr<StatisticsCollector> statistics)
+    : ccs_road_network(std::move(ccs_road_network)), lanelet_attributes(std::move(lanelet_attributes)),
+      statistics(std::move(statistics)), dt(dt),
       input_state_update(make_input_state_update(dt, ego_params)),
       admissible_states(make_admissible_states(ego_params)),
       shrink_delta(compute_shrink_delta(ego_params.length, ego_params.width)),
       outer_shape_box(make_outer_shape_box(ego_params.length, ego_params.width)),
-      offset(ego_params.initial_state.getTimeStep()),
-      center_approximation({make_initial_center_approximation(ego_params)}) {}
-
-Eigen::Matrix<double, 4, 4> BehaviorOverapproximation::make_system_matrix(double dt) {
-    return Eigen::Matrix4d{
-        {1, dt, 0, 0},
-        {0, 1, 0, 0},
-        {0, 0, 1, dt},
-        {0, 0, 0, 1},
-    };
+      offset(ego_params.initial_state.getTimeStep()) {
+    reachable_steps[0] = std::make_unique<ReachableStep[]>(steps_per_segment);
+    reachable_steps[0][0] = make_initial_reachable_step(ego_params);
+    num_reachable_steps.store(1, std::memory_order_release);
 }
 
 Box4D BehaviorOverapproximation::make_input_state_update(double dt, const EgoParameters &ego_params) {
@@ -64,7 +64,8 @@ sets::Box2D BehaviorOverapproximation::make_outer_shape_box(double length, doubl
     return Box2D{{0, 0}, {side_half, side_half}};
 }
 
-sets::Box4D BehaviorOverapproximation::make_initial_center_approximation(const EgoParameters &ego_params) {
+BehaviorOverapproximation::ReachableStep
+BehaviorOverapproximation::make_initial_reachable_step(const EgoParameters &ego_params) {
     const auto &initial_state = ego_params.initial_state;
 
     auto theta = initial_state.getCurvilinearOrientation();
@@ -75,95 +76,158 @@ sets::Box4D BehaviorOverapproximation::make_initial_center_approximation(const E
     auto lon_pos = initial_state.getLonPosition();
     auto lat_pos = initial_state.getLatPosition();
 
-    auto center = Eigen::Vector4d{lon_pos, lon_velocity, lat_pos, lat_velocity};
-    auto radius = Eigen::Vector4d{ego_params.uncertainty_p_lon, ego_params.uncertainty_v_lon,
+    ReachableStep step;
+    step.center = Eigen::Vector4d{lon_pos, lon_velocity, lat_pos, lat_velocity};
+    step.radius = Eigen::Vector4d{ego_params.uncertainty_p_lon, ego_params.uncertainty_v_lon,
                                   ego_params.uncertainty_p_lat, ego_params.uncertainty_v_lat};
-    return Box4D{center, radius};
+    set_bounds(step);
+    return step;
 }
 
-sets::Box4D BehaviorOverapproximation::get_center_approximation(time_step_t time_step) {
-    auto idx = time_step - offset;
-    if (center_approximation.size() <= idx) {
-        // compute missing steps
-        auto previous = get_center_approximation(time_step - 1);
-        auto next = previous.linear_map_positive(system_matrix).sum(input_state_update).intersect(admissible_states);
-        center_approximation.emplace_back(std::move(next));
+BehaviorOverapproximation::ReachableStep
+BehaviorOverapproximation::make_next_reachable_step(const ReachableStep &previous) const {
+    const auto &[admissible_min, admissible_max] = admissible_states.bounds();
+
+    // The double integrator dynamics are decoupled, so the longitudinal (0, 1) and lateral (2, 3) position and velocity
+    // are propagated independently. This is equivalent to the linear map by the system matrix followed by the sum with
+    // the input set and the intersection with the admissible states.
+    ReachableStep next;
+    for (int pos : {0, 2}) {
+        auto vel = pos + 1;
+        next.center(pos) = previous.center(pos) + (dt * previous.center(vel)) + input_state_update.center(pos);
+        next.radius(pos) = previous.radius(pos) + (dt * previous.radius(vel)) + input_state_update.radius(pos);
+        next.center(vel) = previous.center(vel) + input_state_update.center(vel);
+        next.radius(vel) = previous.radius(vel) + input_state_update.radius(vel);
     }
-    return center_approximation[idx];
-}
 
-sets::Box2D BehaviorOverapproximation::get_occupancy_approximation(time_step_t time_step) {
-    if (!occupancy_approximation.contains(time_step)) {
-        auto center_approx = get_center_approximation(time_step);
-        auto occ_approx = project_to_positions(center_approx).sum(outer_shape_box);
-        occupancy_approximation.emplace(time_step, std::move(occ_approx));
+    Eigen::Vector4d min = (next.center - next.radius).cwiseMax(admissible_min);
+    Eigen::Vector4d max = (next.center + next.radius).cwiseMin(admissible_max);
+    if (!(min.array() <= max.array()).all()) {
+        throw std::runtime_error("Intersection leads to empty set, which cannot be represented.");
     }
-    return occupancy_approximation.at(time_step);
+    next.radius = (max - min) / 2;
+    next.center = min + next.radius;
+    set_bounds(next);
+    return next;
 }
 
-const std::vector<std::shared_ptr<Lanelet>> &BehaviorOverapproximation::get_covered_lanelets(time_step_t time_step) {
-    if (!covered_lanelets.contains(time_step)) {
-        auto occ_approx = get_occupancy_approximation(time_step);
-        auto lanelets = ccs_road_network.get_overlapping_lanelets(occ_approx);
-        covered_lanelets.emplace(time_step, std::move(lanelets));
+void BehaviorOverapproximation::set_bounds(ReachableStep &step) {
+    step.min = step.center - step.radius;
+    step.max = step.center + step.radius;
+
+    auto v_x_max = step.max(1);
+    auto v_y_max = step.max(3);
+    auto v_x_min = step.min(1);
+    auto v_y_min = step.min(3);
+
+    auto v_max =
+        std::sqrt(std::max(v_x_max * v_x_max, v_x_min * v_x_min) + std::max(v_y_max * v_y_max, v_y_min * v_y_min));
+
+    auto v_x_abs_min = v_x_min >= 0 ? v_x_min : v_x_max <= 0 ? v_x_max : 0;
+    auto v_y_abs_min = v_y_min >= 0 ? v_y_min : v_y_max <= 0 ? v_y_max : 0;
+
+    auto v_min = std::sqrt((v_x_abs_min * v_x_abs_min) + (v_y_abs_min * v_y_abs_min));
+
+    step.velocity = std::make_pair(v_min, v_max);
+}
+
+void BehaviorOverapproximation::append_reachable_step() {
+    auto idx = num_reachable_steps.load(std::memory_order_relaxed);
+    const auto &previous = reachable_steps[(idx - 1) / steps_per_segment][(idx - 1) % steps_per_segment];
+    auto &segment = reachable_steps[idx / steps_per_segment];
+    if (!segment) {
+        segment = std::make_unique<ReachableStep[]>(steps_per_segment);
     }
-    return covered_lanelets.at(time_step);
+    segment[idx % steps_per_segment] = make_next_reachable_step(previous);
+    // Publish each step right away, so readers of earlier steps do not wait for the whole horizon
+    num_reachable_steps.store(idx + 1, std::memory_order_release);
 }
 
-sets::Box2D BehaviorOverapproximation::get_occupancy_intersection_approximation(time_step_t time_step) {
-    if (!occupancy_intersection_approximation.contains(time_step)) {
-        auto center_approx = get_center_approximation(time_step);
-        auto occ_int_approx = project_to_positions(center_approx).shrink(shrink_delta);
-        occupancy_intersection_approximation.emplace(time_step, std::move(occ_int_approx));
+void BehaviorOverapproximation::precompute(size_t horizon) {
+    if (horizon >= max_segments * steps_per_segment) {
+        throw std::out_of_range("Horizon " + std::to_string(horizon) + " exceeds the maximal supported horizon");
+    }
+
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("BehaviorOverapproximation::precompute");
+    std::scoped_lock lock{precompute_mutex};
+    while (num_reachable_steps.load(std::memory_order_relaxed) <= horizon) {
+        append_reachable_step();
     }
-    return occupancy_intersection_approximation.at(time_step);
 }
 
-const std::vector<std::shared_ptr<Lanelet>> &
-BehaviorOverapproximation::get_intersected_lanelets(time_step_t time_step) {
-    if (!intersected_lanelets.contains(time_step)) {
-        auto occ_int_approx = get_occupancy_intersection_approximation(time_step);
-        auto lanelets = ccs_road_network.get_overlapping_lanelets(occ_int_approx);
-        intersected_lanelets.emplace(time_step, std::move(lanelets));
+void BehaviorOverapproximation::precompute_batch(std::span<BehaviorOverapproximation *const> approximations,
+                                                 size_t horizon, parallel::WorkStealingPool *pool) {
+    if (horizon >= max_segments * steps_per_segment) {
+        throw std::out_of_range("Horizon " + std::to_string(horizon) + " exceeds the maximal supported horizon");
     }
-    return intersected_lanelets.at(time_step);
+
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("BehaviorOverapproximation::precompute_batch");
+    // Tasks for the same approximation would only wait for each other's lock
+    std::vector<BehaviorOverapproximation *> unique_approximations{approximations.begin(), approximations.end()};
+    std::ranges::sort(unique_approximations);
+    auto duplicates = std::ranges::unique(unique_approximations);
+    unique_approximations.erase(duplicates.begin(), duplicates.end());
+
+    if (pool == nullptr || unique_approximations.size() < 2) {
+        for (auto *approximation : unique_approximations) {
+            approximation->precompute(horizon);
+        }
+        return;
+    }
+
+    // The recurrences of different approximations are independent, so each one is advanced by its own task
+    std::vector<parallel::WorkStealingPool::Task> tasks;
+    tasks.reserve(unique_approximations.size());
+    for (auto *approximation : unique_approximations) {
+        tasks.emplace_back([approximation, horizon]() { approximation->precompute(horizon); });
+    }
+    pool->run(std::move(tasks));
 }
 
-const std::pair<double, double> &BehaviorOverapproximation::get_velocity_approximation(time_step_t time_step) {
-    if (!velocity_approximation.contains(time_step)) {
-        const auto &[min, max] = get_center_approximation(time_step).bounds();
-        auto v_x_max = max(1);
-        auto v_y_max = max(3);
-        auto v_x_min = min(1);
-        auto v_y_min = min(3);
+sets::Box4D BehaviorOverapproximation::get_center_approximation(time_step_t time_step) {
+    const auto &step = get_reachable_step(time_step);
+    return Box4D{step.center, step.radius};
+}
 
-        auto v_max =
-            std::sqrt(std::max(v_x_max * v_x_max, v_x_min * v_x_min) + std::max(v_y_max * v_y_max, v_y_min * v_y_min));
+sets::Box2D BehaviorOverapproximation::get_occupancy_approximation(time_step_t time_step) {
+    return occupancy_approximation.get_or_compute(time_step, [this, time_step]() {
+        auto center_approx = get_center_approximation(time_step);
+        return project_to_positions(center_approx).sum(outer_shape_box);
+    });
+}
 
-        auto v_x_abs_min = v_x_min >= 0 ? v_x_min : v_x_max <= 0 ? v_x_max : 0;
-        auto v_y_abs_min = v_y_min >= 0 ? v_y_min : v_y_max <= 0 ? v_y_max : 0;
+const std::vector<std::shared_ptr<Lanelet>> &BehaviorOverapproximation::get_covered_lanelets(time_step_t time_step) {
+    return covered_lanelets.get_or_compute(time_step, [this, time_step]() {
+        CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("BehaviorOverapproximation::get_covered_lanelets");
+        auto occ_approx = get_occupancy_approximation(time_step);
+        statistics->record_overlapping_lanelet_query();
+        return ccs_road_network->get_overlapping_lanelets(occ_approx);
+    });
+}
 
-        auto v_min = std::sqrt((v_x_abs_min * v_x_abs_min) + (v_y_abs_min * v_y_abs_min));
+sets::Box2D BehaviorOverapproximation::get_occupancy_intersection_approximation(time_step_t time_step) {
+    return occupancy_intersection_approximation.get_or_compute(time_step, [this, time_step]() {
+        auto center_approx = get_center_approximation(time_step);
+        return project_to_positions(center_approx).shrink(shrink_delta);
+    });
+}
 
-        velocity_approximation.emplace(time_step, std::make_pair(v_min, v_max));
-    }
-    return velocity_approximation.at(time_step);
+const std::vector<std::shared_ptr<Lanelet>> &
+BehaviorOverapproximation::get_intersected_lanelets(time_step_t time_step) {
+    return intersected_lanelets.get_or_compute(time_step, [this, time_step]() {
+        CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("BehaviorOverapproximation::get_intersected_lanelets");
+        auto occ_int_approx = get_occupancy_intersection_approximation(time_step);
+        statistics->record_overlapping_lanelet_query();
+        return ccs_road_network->get_overlapping_lanelets(occ_int_approx);
+    });
 }
 
 const std::pair<int, int> &BehaviorOverapproximation::get_priority_range(time_step_t time_step, Direction dir) {
-    auto key = std::make_pair(time_step, dir);
-
-    if (!priority_range.contains(key)) {
-        auto ego_covered_lanelets = get_covered_lanelets(time_step);
+    return priority_range.get_or_compute(std::make_pair(time_step, dir), [this, time_step, dir]() {
+        const auto &ego_covered_lanelets = get_covered_lanelets(time_step);
         assert(!ego_covered_lanelets.empty());
-        auto priorities = ego_covered_lanelets | std::views::transform([&dir](const auto &lanelet) {
-                              return regulatory_elements_utils::extractPriorityTrafficSign({lanelet}, dir);
-                          });
-        auto [min, max] = std::ranges::minmax_element(priorities.begin(), priorities.end());
-        priority_range.emplace(std::make_pair(time_step, dir), std::make_pair(*min, *max));
-    }
-
-    return priority_range.at(key);
+        return lanelet_attributes->get_priority_range(ego_covered_lanelets, dir);
+    });
 }
 
 sets::Box2D BehaviorOverapproximation::project_to_positions(const Box4D &state_set) {
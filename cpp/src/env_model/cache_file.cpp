@@ -0,0 +1,76 @@
+#include "cr_knowledge_extraction/env_model/cache_file.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <fstream>
+#include <random>
+#include <system_error>
+
+using namespace knowledge_extraction::env_model;
+
+uint64_t knowledge_extraction::env_model::hash_bytes(std::span<const char> data, uint64_t seed) {
+    constexpr uint64_t prime = 0x100000001b3;
+    auto hash = seed;
+    for (auto byte : data) {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= prime;
+    }
+    return hash;
+}
+
+bool knowledge_extraction::env_model::read_mapped_file(const std::filesystem::path &path,
+                                                       const std::function<void(std::span<const char>)> &read) {
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    if (error) {
+        if (!std::filesystem::exists(path)) {
+            return false;
+        }
+        throw std::runtime_error("Cannot read " + path.string() + ": " + error.message());
+    }
+    if (size == 0) {
+        // Empty regions cannot be mapped
+        read({});
+        return true;
+    }
+    try {
+        boost::interprocess::file_mapping file{path.string().c_str(), boost::interprocess::read_only};
+        boost::interprocess::mapped_region region{file, boost::interprocess::read_only};
+        read({static_cast<const char *>(region.get_address()), region.get_size()});
+    } catch (const boost::interprocess::interprocess_exception &e) {
+        throw std::runtime_error("Cannot map " + path.string() + ": " + e.what());
+    }
+    return true;
+}
+
+uint64_t knowledge_extraction::env_model::hash_file(const std::filesystem::path &path) {
+    uint64_t hash = 0;
+    if (!read_mapped_file(path, [&hash](std::span<const char> content) { hash = hash_bytes(content); })) {
+        throw std::runtime_error("File does not exist: " + path.string());
+    }
+    return hash;
+}
+
+void knowledge_extraction::env_model::write_file_atomically(const std::filesystem::path &path,
+                                                            std::string_view content) {
+    // A random suffix keeps concurrent writers of the same file apart
+    auto temporary_path = path;
+    temporary_path += ".tmp" + std::to_string(std::random_device{}());
+    std::ofstream file{temporary_path, std::ios::binary | std::ios::trunc};
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    // Closing flushes the content, so write errors are only known afterwards
+    file.close();
+    if (!file) {
+        std::error_code ignored;
+        std::filesystem::remove(temporary_path, ignored);
+        throw std::runtime_error("Cannot write " + temporary_path.string());
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error) {
+        std::error_code ignored;
+        std::filesystem::remove(temporary_path, ignored);
+        throw std::runtime_error("Cannot write " + path.string() + ": " + error.message());
+    }
+}
@@ -0,0 +1,66 @@
+#include "cr_knowledge_extraction/env_model/curvilinear_cache.hpp"
+
+#include <commonroad_cpp/obstacle/obstacle.h>
+
+using namespace knowledge_extraction::env_model;
+
+CurvilinearCache::CurvilinearCache(std::shared_ptr<WorldCache> world_cache,
+                                   std::shared_ptr<geometry::CurvilinearCoordinateSystem> ccs)
+    : world_cache(std::move(world_cache)), ccs(std::move(ccs)),
+      ccs_road_network(std::make_shared<const road_network::CurvilinearRoadNetwork>(
+          this->world_cache->get_world()->getRoadNetwork(), this->ccs)),
+      obstacle_rear_cache(this->world_cache->get_obstacle_time_index()),
+      stopping_s_cache(this->world_cache->get_obstacle_time_index()) {}
+
+std::optional<double> CurvilinearCache::get_obstacle_rear_impl(size_t time_step,
+                                                               const std::shared_ptr<Obstacle> &obstacle) const {
+    std::shared_ptr<State> obstacle_state;
+    try {
+        obstacle_state = obstacle->getStateByTimeStep(time_step);
+    } catch (std::logic_error &e) {
+        return std::nullopt;
+    }
+    if (!ccs->cartesianPointInProjectionDomain(obstacle_state->getXPosition(), obstacle_state->getYPosition())) {
+        return std::nullopt;
+    }
+
+    return obstacle->rearS(time_step, ccs);
+}
+
+std::optional<double> CurvilinearCache::get_obstacle_rear(size_t time_step, const std::shared_ptr<Obstacle> &obstacle) {
+    auto hit = true;
+    auto result = obstacle_rear_cache.get_or_compute(time_step, obstacle->getId(), [&]() {
+        hit = false;
+        auto lock = world_cache->lock_world();
+        return get_obstacle_rear_impl(time_step, obstacle);
+    });
+    world_cache->get_statistics()->record_cache_access(CacheKind::OBSTACLE_REAR, hit);
+    return result;
+}
+
+std::optional<double> CurvilinearCache::get_stopping_s_impl(size_t time_step,
+                                                            const std::shared_ptr<Obstacle> &obstacle) {
+    auto rear_opt = get_obstacle_rear(time_step, obstacle);
+    if (!rear_opt.has_value()) {
+        return std::nullopt;
+    }
+    auto rear = rear_opt.value();
+
+    auto lock = world_cache->lock_world();
+    // This cannot fail, otherwise get_obstacle_rear would have returned std::nullopt
+    auto velocity = obstacle->getStateByTimeStep(time_step)->getVelocity();
+
+    return rear + ((velocity * velocity) / (2 * std::abs(obstacle->getAminLong())));
+}
+
+std::optional<double> CurvilinearCache::get_stopping_s(size_t time_step, const std::shared_ptr<Obstacle> &obstacle) {
+    // The world is locked inside, since the computation itself queries the cached rear position
+    auto hit = true;
+    auto result = stopping_s_cache.get_or_compute(time_step, obstacle->getId(), [&]() {
+        hit = false;
+        return get_stopping_s_impl(time_step, obstacle);
+    });
+    world_cache->get_statistics()->record_cache_access(CacheKind::STOPPING_S, hit);
+    return result;
+}
+
@@ -0,0 +1,29 @@
+#include "cr_knowledge_extraction/env_model/dense_obstacle_cache.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using namespace knowledge_extraction::env_model;
+
+ObstacleTimeIndex::ObstacleTimeIndex(const std::vector<size_t> &obstacle_ids, time_step_t first_time_step,
+                                     size_t num_time_steps)
+    : first_time_step(first_time_step), num_time_steps(num_time_steps), num_obstacles(obstacle_ids.size()),
+      obstacle_index(obstacle_ids) {}
+
+ObstacleTimeIndex ObstacleTimeIndex::from_obstacles(const std::vector<std::shared_ptr<Obstacle>> &obstacles) {
+    if (obstacles.empty()) {
+        return ObstacleTimeIndex{{}, 0, 0};
+    }
+
+    std::vector<size_t> obstacle_ids;
+    obstacle_ids.reserve(obstacles.size());
+    auto first_time_step = std::numeric_limits<time_step_t>::max();
+    time_step_t final_time_step = 0;
+    for (const auto &obstacle : obstacles) {
+        obstacle_ids.push_back(obstacle->getId());
+        first_time_step = std::min(first_time_step, obstacle->getFirstTimeStep());
+        final_time_step = std::max(final_time_step, obstacle->getFinalTimeStep());
+    }
+
+    return ObstacleTimeIndex{obstacle_ids, first_time_step, final_time_step - first_time_step + 1};
+}
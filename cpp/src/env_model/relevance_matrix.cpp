@@ -0,0 +1,172 @@
+#include "cr_knowledge_extraction/env_model/relevance_matrix.hpp"
+
+#include <algorithm>
+
+using namespace knowledge_extraction::env_model;
+
+RelevanceMatrix::RelevanceMatrix(std::shared_ptr<const ObstacleTimeIndex> index)
+    : index(std::move(index)), words_per_row((this->index->get_num_obstacles() + bits_per_word - 1) / bits_per_word) {}
+
+RelevanceMatrix::RelevanceMatrix(
+    std::shared_ptr<const ObstacleTimeIndex> index,
+    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
+    : RelevanceMatrix(std::move(index)) {
+    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
+        for (const auto &obstacle_id : obstacle_ids) {
+            insert(time_step, obstacle_id);
+        }
+    }
+}
+
+size_t RelevanceMatrix::Row::size() const {
+    size_t count = ego ? 1 : 0;
+    for (auto word : words) {
+        count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+}
+
+std::vector<size_t> RelevanceMatrix::Row::get_obstacle_indices() const {
+    std::vector<size_t> indices;
+    for_each_obstacle_index([&indices](size_t obstacle_index) { indices.push_back(obstacle_index); });
+    return indices;
+}
+
+std::optional<size_t> RelevanceMatrix::find_row(time_step_t time_step) const {
+    // Time steps before the first one wrap around and are rejected as well
+    auto row = time_step - first_time_step;
+    if (row >= get_num_rows()) {
+        return std::nullopt;
+    }
+    return row;
+}
+
+size_t RelevanceMatrix::get_or_add_row(time_step_t time_step) {
+    if (get_num_rows() == 0) {
+        first_time_step = time_step;
+    }
+    if (time_step < first_time_step) {
+        // Rarely needed, the relevant propositions of a formula usually start at the initial time step
+        auto num_new_rows = first_time_step - time_step;
+        obstacle_bits.insert(obstacle_bits.begin(), num_new_rows * words_per_row, 0);
+        ego_flags.insert(ego_flags.begin(), num_new_rows, 0);
+        first_time_step = time_step;
+    }
+    auto row = time_step - first_time_step;
+    if (row >= get_num_rows()) {
+        obstacle_bits.resize((row + 1) * words_per_row, 0);
+        ego_flags.resize(row + 1, 0);
+    }
+    return row;
+}
+
+bool RelevanceMatrix::is_row_empty(size_t row) const {
+    if (ego_flags[row] != 0) {
+        return false;
+    }
+    auto words = std::span{obstacle_bits}.subspan(row * words_per_row, words_per_row);
+    return std::ranges::all_of(words, [](uint64_t word) { return word == 0; });
+}
+
+bool RelevanceMatrix::insert(time_step_t time_step, std::optional<size_t> obstacle_id) {
+    if (!obstacle_id.has_value()) {
+        ego_flags[get_or_add_row(time_step)] = 1;
+        return true;
+    }
+    auto obstacle_index = index->get_obstacle_index(obstacle_id.value());
+    if (!obstacle_index.has_value()) {
+        return false;
+    }
+    auto row = get_or_add_row(time_step);
+    obstacle_bits[(row * words_per_row) + (obstacle_index.value() / bits_per_word)] |=
+        uint64_t{1} << (obstacle_index.value() % bits_per_word);
+    return true;
+}
+
+void RelevanceMatrix::erase(time_step_t time_step, std::optional<size_t> obstacle_id) {
+    auto row = find_row(time_step);
+    if (!row.has_value()) {
+        return;
+    }
+    if (!obstacle_id.has_value()) {
+        ego_flags[row.value()] = 0;
+        return;
+    }
+    auto obstacle_index = index->get_obstacle_index(obstacle_id.value());
+    if (obstacle_index.has_value()) {
+        obstacle_bits[(row.value() * words_per_row) + (obstacle_index.value() / bits_per_word)] &=
+            ~(uint64_t{1} << (obstacle_index.value() % bits_per_word));
+    }
+}
+
+bool RelevanceMatrix::contains(time_step_t time_step, std::optional<size_t> obstacle_id) const {
+    auto row = find_row(time_step);
+    if (!row.has_value()) {
+        return false;
+    }
+    if (!obstacle_id.has_value()) {
+        return ego_flags[row.value()] != 0;
+    }
+    auto obstacle_index = index->get_obstacle_index(obstacle_id.value());
+    return obstacle_index.has_value() && get_row(row.value()).contains(obstacle_index.value());
+}
+
+size_t RelevanceMatrix::count_time_steps() const {
+    return static_cast<size_t>(std::ranges::distance(begin(), end()));
+}
+
+std::optional<time_step_t> RelevanceMatrix::get_last_time_step() const {
+    for (auto row = get_num_rows(); row > 0; --row) {
+        if (!is_row_empty(row - 1)) {
+            return first_time_step + row - 1;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<size_t> RelevanceMatrix::get_obstacle_indices() const {
+    std::vector<uint64_t> any_row(words_per_row, 0);
+    for (size_t row = 0; row < get_num_rows(); ++row) {
+        for (size_t word = 0; word < words_per_row; ++word) {
+            any_row[word] |= obstacle_bits[(row * words_per_row) + word];
+        }
+    }
+    return Row{any_row, false}.get_obstacle_indices();
+}
+
+RelevanceMatrix RelevanceMatrix::slice(time_step_t begin, time_step_t end) const {
+    RelevanceMatrix result{index};
+    begin = std::max(begin, first_time_step);
+    end = std::min(end, first_time_step + get_num_rows());
+    if (begin >= end) {
+        return result;
+    }
+    auto first_row = begin - first_time_step;
+    auto last_row = end - first_time_step;
+    result.first_time_step = first_time_step + first_row;
+    result.obstacle_bits.assign(obstacle_bits.begin() + static_cast<std::ptrdiff_t>(first_row * words_per_row),
+                                obstacle_bits.begin() + static_cast<std::ptrdiff_t>(last_row * words_per_row));
+    result.ego_flags.assign(ego_flags.begin() + static_cast<std::ptrdiff_t>(first_row),
+                            ego_flags.begin() + static_cast<std::ptrdiff_t>(last_row));
+    return result;
+}
+
+std::vector<RelevanceMatrix> RelevanceMatrix::split(size_t time_steps_per_chunk) const {
+    std::vector<RelevanceMatrix> chunks;
+    std::optional<time_step_t> chunk_begin;
+    size_t chunk_size = 0;
+    for (const auto &[time_step, _] : *this) {
+        if (!chunk_begin.has_value()) {
+            chunk_begin = time_step;
+        }
+        if (++chunk_size == time_steps_per_chunk) {
+            chunks.push_back(slice(chunk_begin.value(), time_step + 1));
+            chunk_begin.reset();
+            chunk_size = 0;
+        }
+    }
+    if (chunk_begin.has_value()) {
+        chunks.push_back(slice(chunk_begin.value(), first_time_step + get_num_rows()));
+    }
+    return chunks;
+}
@@ -0,0 +1,172 @@
+#include "cr_knowledge_extraction/env_model/shared_world_cache.hpp"
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace knowledge_extraction::env_model;
+
+namespace {
+constexpr std::array<char, 8> segment_magic{'C', 'R', 'K', 'E', 'S', 'H', 'M', 'W'};
+constexpr uint64_t segment_version = 1;
+
+template <typename Record> void append(std::string &content, const std::vector<Record> &records) {
+    static_assert(std::is_trivially_copyable_v<Record> && sizeof(Record) % sizeof(uint64_t) == 0);
+    content.append(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(Record));
+}
+
+// The segment is mapped at a page boundary and all records are multiples of 8 bytes, so each array is aligned
+template <typename Record>
+std::span<const Record> take_records(std::span<const char> &data, uint64_t num_records) {
+    if (num_records > data.size() / sizeof(Record)) {
+        throw std::runtime_error("Truncated shared world cache");
+    }
+    auto size = static_cast<size_t>(num_records) * sizeof(Record);
+    std::span<const Record> records{reinterpret_cast<const Record *>(data.data()), static_cast<size_t>(num_records)};
+    data = data.subspan(size);
+    return records;
+}
+
+template <typename Record, typename Key>
+const Record *find_record(std::span<const Record> records, Key Record::*key, uint64_t value) {
+    auto it = std::ranges::lower_bound(records, value, {}, key);
+    return it != records.end() && (*it).*key == value ? &*it : nullptr;
+}
+} // namespace
+
+struct SharedWorldCache::Segment {
+    boost::interprocess::shared_memory_object memory;
+    boost::interprocess::mapped_region region;
+};
+
+void SharedWorldCache::Builder::add_priority(size_t position, std::optional<int> priority) {
+    priorities.push_back({position, static_cast<int32_t>(priority.value_or(0)), priority.has_value() ? 1U : 0U});
+}
+
+void SharedWorldCache::Builder::add_lane_ids(size_t position, std::optional<std::span<const uint64_t>> ids) {
+    LaneIdsRecord record{position, lane_ids.size(), 0, ids.has_value() ? 1U : 0U};
+    if (ids.has_value()) {
+        lane_ids.insert(lane_ids.end(), ids->begin(), ids->end());
+        record.num_ids = ids->size();
+    }
+    lane_id_sets.push_back(record);
+}
+
+void SharedWorldCache::Builder::add_turning_directions(size_t obstacle_id, uint64_t directions) {
+    turning_directions.push_back({obstacle_id, directions});
+}
+
+std::string SharedWorldCache::Builder::build(uint64_t scenario_hash, uint64_t layout_hash) {
+    // Lookups use binary search
+    std::ranges::sort(priorities, {}, &PriorityRecord::position);
+    std::ranges::sort(lane_id_sets, {}, &LaneIdsRecord::position);
+    std::ranges::sort(turning_directions, {}, &TurningDirectionsRecord::obstacle_id);
+
+    Header header{segment_magic,         segment_version,     scenario_hash,   layout_hash,
+                  priorities.size(),     lane_id_sets.size(), lane_ids.size(), turning_directions.size()};
+    std::string content(reinterpret_cast<const char *>(&header), sizeof(Header));
+    append(content, priorities);
+    append(content, lane_id_sets);
+    append(content, lane_ids);
+    append(content, turning_directions);
+    return content;
+}
+
+SharedWorldCache::SharedWorldCache(std::string name, bool owner, std::unique_ptr<Segment> segment)
+    : name(std::move(name)), owner(owner), segment(std::move(segment)) {
+    std::span<const char> data{static_cast<const char *>(this->segment->region.get_address()),
+                               this->segment->region.get_size()};
+    if (data.size() < sizeof(Header)) {
+        throw std::runtime_error("Truncated shared world cache");
+    }
+    std::memcpy(&header, data.data(), sizeof(Header));
+    if (header.magic != segment_magic || header.version != segment_version) {
+        throw std::runtime_error("Not a shared world cache of this version: " + this->name);
+    }
+    data = data.subspan(sizeof(Header));
+    priorities = take_records<PriorityRecord>(data, header.num_priorities);
+    lane_id_sets = take_records<LaneIdsRecord>(data, header.num_lane_id_sets);
+    lane_ids = take_records<uint64_t>(data, header.num_lane_ids);
+    turning_directions = take_records<TurningDirectionsRecord>(data, header.num_turning_directions);
+    // Lookups trust the records, so the lanelet IDs of each set are checked once here
+    for (const auto &record : lane_id_sets) {
+        if (record.first_id > lane_ids.size() || record.num_ids > lane_ids.size() - record.first_id) {
+            throw std::runtime_error("Corrupt shared world cache: " + this->name);
+        }
+        auto ids = lane_ids.subspan(static_cast<size_t>(record.first_id), static_cast<size_t>(record.num_ids));
+        if (std::ranges::adjacent_find(ids, std::greater_equal{}) != ids.end()) {
+            throw std::runtime_error("Corrupt shared world cache: " + this->name);
+        }
+    }
+}
+
+SharedWorldCache::~SharedWorldCache() {
+    if (owner) {
+        boost::interprocess::shared_memory_object::remove(name.c_str());
+    }
+}
+
+std::shared_ptr<SharedWorldCache> SharedWorldCache::create(const std::string &name, const std::string &content) {
+    auto segment = std::make_unique<Segment>();
+    try {
+        segment->memory = boost::interprocess::shared_memory_object{boost::interprocess::create_only, name.c_str(),
+                                                                    boost::interprocess::read_write};
+    } catch (const boost::interprocess::interprocess_exception &e) {
+        throw std::runtime_error("Cannot create shared world cache " + name + ": " + e.what());
+    }
+    try {
+        segment->memory.truncate(static_cast<boost::interprocess::offset_t>(content.size()));
+        segment->region = boost::interprocess::mapped_region{segment->memory, boost::interprocess::read_write};
+        std::memcpy(segment->region.get_address(), content.data(), content.size());
+    } catch (const boost::interprocess::interprocess_exception &e) {
+        boost::interprocess::shared_memory_object::remove(name.c_str());
+        throw std::runtime_error("Cannot create shared world cache " + name + ": " + e.what());
+    }
+    try {
+        return std::shared_ptr<SharedWorldCache>{new SharedWorldCache{name, true, std::move(segment)}};
+    } catch (const std::runtime_error &) {
+        boost::interprocess::shared_memory_object::remove(name.c_str());
+        throw;
+    }
+}
+
+std::shared_ptr<SharedWorldCache> SharedWorldCache::open(const std::string &name) {
+    auto segment = std::make_unique<Segment>();
+    try {
+        segment->memory = boost::interprocess::shared_memory_object{boost::interprocess::open_only, name.c_str(),
+                                                                    boost::interprocess::read_only};
+        segment->region = boost::interprocess::mapped_region{segment->memory, boost::interprocess::read_only};
+    } catch (const boost::interprocess::interprocess_exception &e) {
+        throw std::runtime_error("Cannot open shared world cache " + name + ": " + e.what());
+    }
+    return std::shared_ptr<SharedWorldCache>{new SharedWorldCache{name, false, std::move(segment)}};
+}
+
+std::optional<std::optional<int>> SharedWorldCache::find_priority(size_t position) const {
+    const auto *record = find_record(priorities, &PriorityRecord::position, position);
+    if (record == nullptr) {
+        return std::nullopt;
+    }
+    return record->has_priority != 0 ? std::optional<int>{record->priority} : std::nullopt;
+}
+
+std::optional<std::optional<std::span<const uint64_t>>> SharedWorldCache::find_lane_ids(size_t position) const {
+    const auto *record = find_record(lane_id_sets, &LaneIdsRecord::position, position);
+    if (record == nullptr) {
+        return std::nullopt;
+    }
+    if (record->has_ids == 0) {
+        return std::optional<std::span<const uint64_t>>{};
+    }
+    return lane_ids.subspan(static_cast<size_t>(record->first_id), static_cast<size_t>(record->num_ids));
+}
+
+std::optional<uint64_t> SharedWorldCache::find_turning_directions(size_t obstacle_id) const {
+    const auto *record = find_record(turning_directions, &TurningDirectionsRecord::obstacle_id, obstacle_id);
+    return record != nullptr ? std::optional<uint64_t>{record->directions} : std::nullopt;
+}
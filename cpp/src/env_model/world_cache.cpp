@@ -0,0 +1,621 @@
+#include "cr_knowledge_extraction/env_model/world_cache.hpp"
+
+#include "cr_knowledge_extraction/env_model/cache_file.hpp"
+#include "cr_knowledge_extraction/tracing.hpp"
+
+#include <commonroad_cpp/obstacle/obstacle.h>
+#include <commonroad_cpp/predicates/lane/on_similar_oriented_lanelet_with_type_predicate.h>
+#include <commonroad_cpp/predicates/lane/on_similar_oriented_lanelet_without_type_predicate.h>
+#include <commonroad_cpp/roadNetwork/lanelet/lane.h>
+#include <commonroad_cpp/roadNetwork/regulatoryElements/regulatory_elements_utils.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+using namespace knowledge_extraction::env_model;
+
+namespace {
+constexpr std::array<char, 8> cache_magic{'C', 'R', 'K', 'E', 'W', 'C', 'A', 'C'};
+// Values are stored in native byte order, thus data written with another byte order has a foreign version as well
+constexpr uint32_t cache_format_version = 1;
+// Each section of the data is terminated by this position or obstacle ID
+constexpr uint64_t end_of_section = UINT64_MAX;
+
+constexpr uint8_t left_bit = 1;
+constexpr uint8_t straight_bit = 2;
+constexpr uint8_t right_bit = 4;
+
+uint8_t encode_directions(const std::unordered_set<Direction> &directions) {
+    uint8_t bits = 0;
+    bits |= directions.contains(Direction::left) ? left_bit : uint8_t{0};
+    bits |= directions.contains(Direction::straight) ? straight_bit : uint8_t{0};
+    bits |= directions.contains(Direction::right) ? right_bit : uint8_t{0};
+    return bits;
+}
+
+std::unordered_set<Direction> decode_directions(uint64_t bits) {
+    if ((bits & ~uint64_t{left_bit | straight_bit | right_bit}) != 0) {
+        throw std::runtime_error("Invalid turning directions in world cache");
+    }
+    std::unordered_set<Direction> directions;
+    if ((bits & left_bit) != 0) {
+        directions.insert(Direction::left);
+    }
+    if ((bits & straight_bit) != 0) {
+        directions.insert(Direction::straight);
+    }
+    if ((bits & right_bit) != 0) {
+        directions.insert(Direction::right);
+    }
+    return directions;
+}
+
+// The decoded sets of all valid bitmasks, so that directions read in place can be returned by reference
+const std::unordered_set<Direction> &get_direction_set(uint64_t bits) {
+    static const auto direction_sets = []() {
+        std::array<std::unordered_set<Direction>, size_t{left_bit | straight_bit | right_bit} + 1> sets;
+        for (size_t i = 0; i < sets.size(); ++i) {
+            sets[i] = decode_directions(i);
+        }
+        return sets;
+    }();
+    if (bits >= direction_sets.size()) {
+        throw std::runtime_error("Invalid turning directions in world cache");
+    }
+    return direction_sets[bits];
+}
+} // namespace
+
+WorldCache::WorldCache(std::shared_ptr<World> world)
+    : world(std::move(world)), statistics(std::make_shared<StatisticsCollector>()),
+      obstacle_time_index(
+          std::make_shared<const ObstacleTimeIndex>(ObstacleTimeIndex::from_obstacles(this->world->getObstacles()))),
+      obstacles_by_index(this->world->getObstacles()),
+      lanelet_attributes(
+          std::make_shared<const road_network::LaneletAttributeTable>(this->world->getRoadNetwork())),
+      obstacle_lane_ids_cache(obstacle_time_index),
+      reference_lane_intervals(obstacle_time_index->get_num_obstacles()), priority_cache(obstacle_time_index) {}
+
+std::vector<std::shared_ptr<Obstacle>> WorldCache::get_obstacles_by_index(std::vector<size_t> indices) const {
+    // Keep the order of the world, so that the extracted knowledge does not depend on the order of the IDs
+    std::ranges::sort(indices);
+    std::vector<std::shared_ptr<Obstacle>> obstacles;
+    obstacles.reserve(indices.size());
+    for (auto index : indices) {
+        obstacles.push_back(obstacles_by_index[index]);
+    }
+    return obstacles;
+}
+
+std::shared_ptr<Obstacle> WorldCache::get_obstacle(size_t obstacle_id) const {
+    auto index = obstacle_time_index->get_obstacle_index(obstacle_id);
+    return index.has_value() ? obstacles_by_index[index.value()] : nullptr;
+}
+
+std::vector<std::shared_ptr<Obstacle>>
+WorldCache::get_obstacles(const std::unordered_set<std::optional<size_t>> &obstacle_ids) const {
+    std::vector<size_t> indices;
+    indices.reserve(obstacle_ids.size());
+    for (const auto &obstacle_id : obstacle_ids) {
+        if (!obstacle_id.has_value()) {
+            continue;
+        }
+        if (auto index = obstacle_time_index->get_obstacle_index(obstacle_id.value()); index.has_value()) {
+            indices.push_back(index.value());
+        }
+    }
+    return get_obstacles_by_index(std::move(indices));
+}
+
+std::vector<std::shared_ptr<Obstacle>>
+WorldCache::get_obstacles(const std::unordered_set<size_t> &obstacle_ids) const {
+    std::vector<size_t> indices;
+    indices.reserve(obstacle_ids.size());
+    for (auto obstacle_id : obstacle_ids) {
+        if (auto index = obstacle_time_index->get_obstacle_index(obstacle_id); index.has_value()) {
+            indices.push_back(index.value());
+        }
+    }
+    return get_obstacles_by_index(std::move(indices));
+}
+
+const std::vector<uint64_t> *WorldCache::intern_lane_ids(std::vector<uint64_t> lane_ids) const {
+    return &*interned_lane_ids.insert(std::move(lane_ids)).first;
+}
+
+const std::vector<uint64_t> *
+WorldCache::get_obstacle_lane_ids_impl(size_t time_step, const std::shared_ptr<Obstacle> &obstacle) const {
+    try {
+        const auto &road_network = world->getRoadNetwork();
+        auto occupied_lanelets = obstacle->getOccupiedLaneletsDrivingDirectionByShape(road_network, time_step);
+
+        // The lanes through a set of lanelets are the lanes through each of them, so the lanes are not built again
+        std::vector<uint64_t> lanelet_ids;
+        for (const auto &lanelet : occupied_lanelets) {
+            auto index = lanelet_attributes->get_lanelet_index(lanelet->getId());
+            if (!index.has_value()) {
+                return nullptr;
+            }
+            auto lanelet_lane_ids = lanelet_attributes->get_lane_lanelet_ids(index.value());
+            lanelet_ids.insert(lanelet_ids.end(), lanelet_lane_ids.begin(), lanelet_lane_ids.end());
+        }
+        std::ranges::sort(lanelet_ids);
+        lanelet_ids.erase(std::ranges::unique(lanelet_ids).begin(), lanelet_ids.end());
+        return intern_lane_ids(std::move(lanelet_ids));
+    } catch (std::logic_error &e) {
+        return nullptr;
+    }
+}
+
+std::optional<std::optional<std::span<const uint64_t>>> WorldCache::find_shared_lane_ids(size_t time_step,
+                                                                                         size_t obstacle_id) const {
+    if (!shared_cache) {
+        return std::nullopt;
+    }
+    auto position = obstacle_lane_ids_cache.get_position(time_step, obstacle_id);
+    return position.has_value() ? shared_cache->find_lane_ids(position.value()) : std::nullopt;
+}
+
+std::optional<std::span<const uint64_t>> WorldCache::get_obstacle_lane_ids(size_t time_step,
+                                                                           const std::shared_ptr<Obstacle> &obstacle) {
+    if (auto shared_lane_ids = find_shared_lane_ids(time_step, obstacle->getId()); shared_lane_ids.has_value()) {
+        statistics->record_cache_access(CacheKind::OBSTACLE_LANE_IDS, true);
+        return shared_lane_ids.value();
+    }
+    auto hit = true;
+    const auto *result = obstacle_lane_ids_cache.get_or_compute(time_step, obstacle->getId(), [&]() {
+        hit = false;
+        auto lock = lock_world();
+        return get_obstacle_lane_ids_impl(time_step, obstacle);
+    });
+    statistics->record_cache_access(CacheKind::OBSTACLE_LANE_IDS, hit);
+    if (result == nullptr) {
+        return std::nullopt;
+    }
+    return std::span<const uint64_t>{*result};
+}
+
+bool WorldCache::ReferenceLaneInterval::is_valid_for(const std::optional<std::vector<uint64_t>> &lanelet_ids) const {
+    if (!lanelet_ids.has_value()) {
+        return false;
+    }
+    return lanelet_ids == occupied_lanelet_ids ||
+           (!lanelet_ids->empty() && std::ranges::includes(lane_lanelet_ids, lanelet_ids.value()));
+}
+
+std::optional<const ReferenceLaneLanelets *> WorldCache::find_reference_lane_lanelets(size_t time_step,
+                                                                                      size_t obstacle_index) const {
+    std::shared_lock lock{reference_lane_mutex};
+    const auto &intervals = reference_lane_intervals[obstacle_index];
+    auto next = std::ranges::upper_bound(intervals, time_step, {}, &ReferenceLaneInterval::first_time_step);
+    if (next == intervals.begin() || std::prev(next)->last_time_step < time_step) {
+        return std::nullopt;
+    }
+    return std::prev(next)->lanelets;
+}
+
+WorldCache::ReferenceLaneInterval
+WorldCache::compute_reference_lane_interval(size_t time_step, const std::shared_ptr<Obstacle> &obstacle,
+                                            std::optional<std::vector<uint64_t>> occupied_lanelet_ids) const {
+    ReferenceLaneInterval interval{time_step, time_step, nullptr, {}, std::move(occupied_lanelet_ids)};
+    std::shared_ptr<Lane> reference_lane;
+    try {
+        CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("Obstacle::getReferenceLane");
+        statistics->record_lane_construction();
+        reference_lane = obstacle->getReferenceLane(world->getRoadNetwork(), time_step);
+    } catch (const std::logic_error &e) {
+        return interval;
+    }
+
+    ReferenceLaneLanelets lanelets;
+    for (const auto &lanelet : reference_lane->getContainedLanelets()) {
+        interval.lane_lanelet_ids.push_back(lanelet->getId());
+        auto attributes = lanelet_attributes->get_attributes(lanelet);
+        if (attributes.has_type(LaneletType::intersection)) {
+            lanelets.intersection_lanelet_ids.push_back(lanelet->getId());
+        }
+        if (attributes.has_type(LaneletType::incoming)) {
+            lanelets.incoming_lanelet_ids.push_back(lanelet->getId());
+        }
+    }
+    std::ranges::sort(interval.lane_lanelet_ids);
+    interval.lane_lanelet_ids.erase(std::ranges::unique(interval.lane_lanelet_ids).begin(),
+                                    interval.lane_lanelet_ids.end());
+    std::ranges::sort(lanelets.intersection_lanelet_ids);
+    lanelets.intersection_lanelet_ids.erase(std::ranges::unique(lanelets.intersection_lanelet_ids).begin(),
+                                            lanelets.intersection_lanelet_ids.end());
+    std::ranges::sort(lanelets.incoming_lanelet_ids);
+    lanelets.incoming_lanelet_ids.erase(std::ranges::unique(lanelets.incoming_lanelet_ids).begin(),
+                                        lanelets.incoming_lanelet_ids.end());
+    interval.lanelets = &*interned_reference_lanes.insert(std::move(lanelets)).first;
+    return interval;
+}
+
+const ReferenceLaneLanelets *WorldCache::get_reference_lane_lanelets(size_t time_step,
+                                                                     const std::shared_ptr<Obstacle> &obstacle) {
+    auto obstacle_index = obstacle_time_index->get_obstacle_index(obstacle->getId());
+    if (!obstacle_index.has_value()) {
+        statistics->record_cache_access(CacheKind::REFERENCE_LANE, false);
+        auto lock = lock_world();
+        return compute_reference_lane_interval(time_step, obstacle, std::nullopt).lanelets;
+    }
+    if (auto lanelets = find_reference_lane_lanelets(time_step, obstacle_index.value()); lanelets.has_value()) {
+        statistics->record_cache_access(CacheKind::REFERENCE_LANE, true);
+        return lanelets.value();
+    }
+
+    auto lock = lock_world();
+    // Another thread may have covered the time step while waiting for the world
+    if (auto lanelets = find_reference_lane_lanelets(time_step, obstacle_index.value()); lanelets.has_value()) {
+        statistics->record_cache_access(CacheKind::REFERENCE_LANE, true);
+        return lanelets.value();
+    }
+    std::optional<std::vector<uint64_t>> occupied_lanelet_ids;
+    try {
+        occupied_lanelet_ids.emplace();
+        for (const auto &lanelet :
+             obstacle->getOccupiedLaneletsDrivingDirectionByShape(world->getRoadNetwork(), time_step)) {
+            occupied_lanelet_ids->push_back(lanelet->getId());
+        }
+        std::ranges::sort(occupied_lanelet_ids.value());
+    } catch (const std::logic_error &e) {
+        occupied_lanelet_ids.reset();
+    }
+
+    {
+        // Extend an adjacent interval if its reference lane is still valid
+        std::unique_lock intervals_lock{reference_lane_mutex};
+        auto &intervals = reference_lane_intervals[obstacle_index.value()];
+        auto next = std::ranges::upper_bound(intervals, time_step, {}, &ReferenceLaneInterval::first_time_step);
+        if (next != intervals.begin() && std::prev(next)->last_time_step + 1 == time_step &&
+            std::prev(next)->is_valid_for(occupied_lanelet_ids)) {
+            std::prev(next)->last_time_step = time_step;
+            statistics->record_cache_access(CacheKind::REFERENCE_LANE, true);
+            return std::prev(next)->lanelets;
+        }
+        if (next != intervals.end() && next->first_time_step == time_step + 1 &&
+            next->is_valid_for(occupied_lanelet_ids)) {
+            next->first_time_step = time_step;
+            statistics->record_cache_access(CacheKind::REFERENCE_LANE, true);
+            return next->lanelets;
+        }
+    }
+
+    auto interval = compute_reference_lane_interval(time_step, obstacle, std::move(occupied_lanelet_ids));
+    statistics->record_cache_access(CacheKind::REFERENCE_LANE, false);
+    const auto *lanelets = interval.lanelets;
+    std::unique_lock intervals_lock{reference_lane_mutex};
+    auto &intervals = reference_lane_intervals[obstacle_index.value()];
+    intervals.insert(std::ranges::upper_bound(intervals, time_step, {}, &ReferenceLaneInterval::first_time_step),
+                     std::move(interval));
+    return lanelets;
+}
+
+std::unordered_set<Direction> WorldCache::get_turning_directions_impl(const std::shared_ptr<Obstacle> &obstacle) {
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("WorldCache::get_turning_directions");
+    auto on_lanelet_with_type = OnSimilarOrientedLaneletWithTypePredicate{};
+    auto not_on_lanelet_with_type = OnSimilarOrientedLaneletWithoutTypePredicate{};
+
+    // State tracks:
+    // - Mode: 0 = Before incoming, 1 = On incoming, 2 = In intersection, 3 = Done
+    // - left, straight, right: Whether the respective direction is still possible
+    std::tuple<int, bool, bool, bool> state = {0, true, true, true};
+
+    // An obstacle turns (left/straight/right) if it leaves an incoming at some point and then
+    // stays on (left/straight/right) lanelets until it leaves the intersection (the until here is weak)
+    // cf. meta predicates in crmonitor
+    for (const auto &time_step : obstacle->getTimeSteps()) {
+        auto &[mode, left, straight, right] = state;
+        if (mode == 3) {
+            break;
+        }
+        auto on_incoming = [&]() {
+            return on_lanelet_with_type.booleanEvaluation(time_step, world, obstacle, {}, {"incoming"});
+        };
+        auto on_dir_lanelet = [&](std::string dir) {
+            return on_lanelet_with_type.booleanEvaluation(time_step, world, obstacle, {}, {std::move(dir)});
+        };
+        auto not_on_intersection = [&]() {
+            return not_on_lanelet_with_type.booleanEvaluation(time_step, world, obstacle, {}, {"intersection"});
+        };
+        switch (mode) {
+        case 0:
+            // Before incoming
+            if (on_incoming()) {
+                mode = 1;
+            }
+            break;
+        case 1:
+            // On incoming
+            if (on_incoming()) {
+                // We stay before the intersection
+                break;
+            }
+            // We have left the incoming and entered the intersection
+            mode = 2;
+            // Intentional fall-through to the next case
+            // we have to check on what kind of direction lanelet the obstacle is at this step
+            [[fallthrough]];
+        case 2:
+            // In intersection
+            if (not_on_intersection()) {
+                // We are done
+                mode = 3;
+            } else {
+                // If we leave a lanelet for a direction, that direction is no longer possible
+                if (right && !on_dir_lanelet("right")) {
+                    right = false;
+                }
+                if (straight && !on_dir_lanelet("straight")) {
+                    straight = false;
+                }
+                if (left && !on_dir_lanelet("left")) {
+                    left = false;
+                }
+                if (!left && !straight && !right) {
+                    // We are done
+                    mode = 3;
+                }
+            }
+            break;
+        default:
+            throw std::logic_error("Invalid mode in get_turning_directions_impl");
+        }
+    }
+
+    // We are done, directions that do not yet have a value are set to true, since we have a weak until
+    const auto &[mode, left, straight, right] = state;
+    std::unordered_set<Direction> directions;
+    if (mode >= 2) {
+        // In mode 0 or 1, we have not entered the intersection yet, so we did not fulfill the eventuality
+        if (left) {
+            directions.insert(Direction::left);
+        }
+        if (straight) {
+            directions.insert(Direction::straight);
+        }
+        if (right) {
+            directions.insert(Direction::right);
+        }
+    }
+
+    return directions;
+}
+
+const std::unordered_set<Direction> &WorldCache::get_turning_directions(const std::shared_ptr<Obstacle> &obstacle) {
+    if (shared_cache) {
+        if (auto directions = shared_cache->find_turning_directions(obstacle->getId()); directions.has_value()) {
+            statistics->record_cache_access(CacheKind::TURNING_DIRECTIONS, true);
+            return get_direction_set(directions.value());
+        }
+    }
+    auto hit = true;
+    const auto &result = turning_directions_cache.get_or_compute(obstacle->getId(), [&]() {
+        hit = false;
+        auto lock = lock_world();
+        return get_turning_directions_impl(obstacle);
+    });
+    statistics->record_cache_access(CacheKind::TURNING_DIRECTIONS, hit);
+    return result;
+}
+
+const knowledge_extraction::road_network::LaneletSet &
+WorldCache::get_lanelets_with_traffic_sign(TrafficSignTypes traffic_sign_type) {
+    return traffic_sign_lanelets_cache.get_or_compute(traffic_sign_type, [this, traffic_sign_type]() {
+        auto lock = lock_world();
+        std::vector<std::shared_ptr<Lanelet>> lanelets;
+        for (const auto &lanelet : world->getRoadNetwork()->getLaneletNetwork()) {
+            if (std::ranges::any_of(lanelet->getTrafficSigns(), [traffic_sign_type](const auto &sign) {
+                    return !sign->getTrafficSignElementsOfType(traffic_sign_type).empty();
+                })) {
+                lanelets.push_back(lanelet);
+            }
+        }
+        return lanelet_attributes->make_lanelet_set(lanelets);
+    });
+}
+
+std::optional<std::optional<int>> WorldCache::find_shared_priority(size_t time_step, size_t obstacle_id,
+                                                                   size_t sub_index) const {
+    if (!shared_cache) {
+        return std::nullopt;
+    }
+    auto position = priority_cache.get_position(time_step, obstacle_id, sub_index);
+    return position.has_value() ? shared_cache->find_priority(position.value()) : std::nullopt;
+}
+
+std::optional<int> WorldCache::get_priority(size_t time_step, const std::shared_ptr<Obstacle> &obstacle,
+                                            Direction dir) {
+    auto hit = true;
+    auto compute = [&]() -> std::optional<int> {
+        hit = false;
+        auto lock = lock_world();
+        return regulatory_elements_utils::getPriority(time_step, world->getRoadNetwork(), obstacle, dir);
+    };
+    std::optional<int> result;
+    auto sub_index = road_network::LaneletAttributeTable::get_priority_direction_index(dir);
+    if (!sub_index.has_value()) {
+        result = compute();
+    } else if (auto shared_priority = find_shared_priority(time_step, obstacle->getId(), sub_index.value());
+               shared_priority.has_value()) {
+        result = shared_priority.value();
+    } else {
+        result = priority_cache.get_or_compute(time_step, obstacle->getId(), sub_index.value(), compute);
+    }
+    statistics->record_cache_access(CacheKind::PRIORITY, hit);
+    return result;
+}
+
+uint64_t WorldCache::get_layout_hash() const {
+    CacheWriter layout;
+    layout.write(static_cast<uint64_t>(obstacle_time_index->get_first_time_step()));
+    layout.write(static_cast<uint64_t>(obstacle_time_index->get_num_time_steps()));
+    for (const auto &obstacle : obstacles_by_index) {
+        layout.write(static_cast<uint64_t>(obstacle->getId()));
+    }
+    return hash_bytes(layout.get_buffer());
+}
+
+std::string WorldCache::serialize(uint64_t scenario_hash) const {
+    CacheWriter writer;
+    writer.write(cache_magic);
+    writer.write(cache_format_version);
+    writer.write(scenario_hash);
+    writer.write(get_layout_hash());
+
+    obstacle_lane_ids_cache.for_each_value([&writer](size_t position, const std::vector<uint64_t> *ids) {
+        writer.write(static_cast<uint64_t>(position));
+        writer.write(static_cast<uint8_t>(ids != nullptr));
+        if (ids != nullptr) {
+            writer.write(static_cast<uint64_t>(ids->size()));
+            for (auto id : *ids) {
+                writer.write(id);
+            }
+        }
+    });
+    writer.write(end_of_section);
+
+    priority_cache.for_each_value([&writer](size_t position, const std::optional<int> &priority) {
+        writer.write(static_cast<uint64_t>(position));
+        writer.write(static_cast<uint8_t>(priority.has_value()));
+        writer.write(static_cast<int32_t>(priority.value_or(0)));
+    });
+    writer.write(end_of_section);
+
+    turning_directions_cache.for_each([&writer](size_t obstacle_id, const std::unordered_set<Direction> &directions) {
+        writer.write(static_cast<uint64_t>(obstacle_id));
+        writer.write(encode_directions(directions));
+    });
+    writer.write(end_of_section);
+
+    return writer.get_buffer();
+}
+
+bool WorldCache::deserialize(std::span<const char> data, uint64_t scenario_hash) {
+    CacheReader reader{data};
+    if (reader.read<std::array<char, 8>>() != cache_magic) {
+        throw std::runtime_error("Not a world cache");
+    }
+    if (reader.read<uint32_t>() != cache_format_version || reader.read<uint64_t>() != scenario_hash ||
+        reader.read<uint64_t>() != get_layout_hash()) {
+        return false;
+    }
+
+    // Parse everything before adding anything, so that corrupt data leaves the cache untouched
+    std::vector<std::pair<size_t, std::optional<std::vector<uint64_t>>>> lane_ids;
+    for (auto position = reader.read<uint64_t>(); position != end_of_section; position = reader.read<uint64_t>()) {
+        if (position >= obstacle_lane_ids_cache.get_num_values()) {
+            throw std::runtime_error("Invalid lanelet ID position in world cache");
+        }
+        std::optional<std::vector<uint64_t>> ids;
+        if (reader.read<uint8_t>() != 0) {
+            ids.emplace();
+            auto num_ids = reader.read<uint64_t>();
+            for (uint64_t i = 0; i < num_ids; ++i) {
+                ids->push_back(reader.read<uint64_t>());
+            }
+            if (std::ranges::adjacent_find(ids.value(), std::greater_equal{}) != ids->end()) {
+                throw std::runtime_error("Unsorted lanelet IDs in world cache");
+            }
+        }
+        lane_ids.emplace_back(static_cast<size_t>(position), std::move(ids));
+    }
+
+    std::vector<std::pair<size_t, std::optional<int>>> priorities;
+    for (auto position = reader.read<uint64_t>(); position != end_of_section; position = reader.read<uint64_t>()) {
+        if (position >= priority_cache.get_num_values()) {
+            throw std::runtime_error("Invalid priority position in world cache");
+        }
+        auto has_priority = reader.read<uint8_t>() != 0;
+        auto priority = static_cast<int>(reader.read<int32_t>());
+        priorities.emplace_back(static_cast<size_t>(position),
+                                has_priority ? std::optional<int>{priority} : std::nullopt);
+    }
+
+    std::vector<std::pair<size_t, std::unordered_set<Direction>>> turning_directions;
+    for (auto obstacle_id = reader.read<uint64_t>(); obstacle_id != end_of_section;
+         obstacle_id = reader.read<uint64_t>()) {
+        turning_directions.emplace_back(static_cast<size_t>(obstacle_id), decode_directions(reader.read<uint8_t>()));
+    }
+
+    if (reader.get_remaining() != 0) {
+        throw std::runtime_error("Trailing data in world cache");
+    }
+
+    {
+        auto lock = lock_world();
+        for (auto &[position, ids] : lane_ids) {
+            const auto *interned = ids.has_value() ? intern_lane_ids(std::move(ids.value())) : nullptr;
+            obstacle_lane_ids_cache.restore(position, interned);
+        }
+    }
+    for (auto &[position, priority] : priorities) {
+        priority_cache.restore(position, priority);
+    }
+    for (auto &[obstacle_id, directions] : turning_directions) {
+        turning_directions_cache.get_or_compute(obstacle_id, [&directions]() { return std::move(directions); });
+    }
+    return true;
+}
+
+void WorldCache::save(const std::filesystem::path &path, uint64_t scenario_hash) const {
+    write_file_atomically(path, serialize(scenario_hash));
+}
+
+bool WorldCache::load(const std::filesystem::path &path, uint64_t scenario_hash) {
+    auto loaded = false;
+    try {
+        read_mapped_file(path, [&](std::span<const char> data) { loaded = deserialize(data, scenario_hash); });
+    } catch (const std::runtime_error &e) {
+        spdlog::warn("Ignoring world cache file {}: {}", path.string(), e.what());
+        return false;
+    }
+    return loaded;
+}
+
+void WorldCache::precompute() {
+    for (const auto &obstacle : obstacles_by_index) {
+        try {
+            get_turning_directions(obstacle);
+        } catch (const std::exception &e) {
+            spdlog::warn("Cannot precompute the turning directions of obstacle {}: {}", obstacle->getId(), e.what());
+        }
+        for (auto time_step = obstacle->getFirstTimeStep(); time_step <= obstacle->getFinalTimeStep(); ++time_step) {
+            try {
+                get_obstacle_lane_ids(time_step, obstacle);
+                for (auto dir : {Direction::left, Direction::straight, Direction::right}) {
+                    get_priority(time_step, obstacle, dir);
+                }
+            } catch (const std::exception &e) {
+                spdlog::warn("Cannot precompute obstacle {} at time step {}: {}", obstacle->getId(), time_step,
+                             e.what());
+            }
+        }
+    }
+}
+
+std::shared_ptr<SharedWorldCache> WorldCache::publish(const std::string &name, uint64_t scenario_hash) const {
+    SharedWorldCache::Builder builder;
+    obstacle_lane_ids_cache.for_each_value([&builder](size_t position, const std::vector<uint64_t> *ids) {
+        builder.add_lane_ids(position, ids != nullptr ? std::optional<std::span<const uint64_t>>{*ids} : std::nullopt);
+    });
+    priority_cache.for_each_value(
+        [&builder](size_t position, std::optional<int> priority) { builder.add_priority(position, priority); });
+    turning_directions_cache.for_each([&builder](size_t obstacle_id, const std::unordered_set<Direction> &directions) {
+        builder.add_turning_directions(obstacle_id, encode_directions(directions));
+    });
+    return SharedWorldCache::create(name, builder.build(scenario_hash, get_layout_hash()));
+}
+
+bool WorldCache::attach(std::shared_ptr<const SharedWorldCache> shared_cache, uint64_t scenario_hash) {
+    if (shared_cache->get_scenario_hash() != scenario_hash || shared_cache->get_layout_hash() != get_layout_hash()) {
+        return false;
+    }
+    this->shared_cache = std::move(shared_cache);
+    return true;
+}
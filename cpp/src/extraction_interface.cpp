@@ -1,4 +1,5 @@
 #include "cr_knowledge_extraction/extraction_interface.hpp"
+#include "cr_knowledge_extraction/extraction_session.hpp"
 
 #include "cr_knowledge_extraction/kleene/braking/safe_distance_extractor.hpp"
 #include "cr_knowledge_extraction/kleene/ego_independent/ego_independent_extractor.hpp"
@@ -19,131 +20,354 @@
 #include "cr_knowledge_extraction/relationship/implication/in_front_of_impl_extractor.hpp"
 #include "cr_knowledge_extraction/relationship/implication/safe_distance_impl_extractor.hpp"
 #include "cr_knowledge_extraction/road_network/curvilinear_road_network.hpp"
+#include "cr_knowledge_extraction/tracing.hpp"
 
 #include <commonroad_cpp/predicates/lane/on_lanelet_with_type_predicate.h>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <ranges>
+#include <thread>
+#include <tuple>
 #include <unordered_set>
 
 using namespace knowledge_extraction;
 
+ExtractionInterface::ExtractionInterface(std::shared_ptr<World> world,
+                                         std::shared_ptr<geometry::CurvilinearCoordinateSystem> ego_ccs,
+                                         const ego_behavior::EgoParameters &ego_params, size_t num_threads)
+    : ExtractionInterface(std::make_shared<env_model::EnvironmentModel>(std::move(world), std::move(ego_ccs),
+                                                                        ego_params, PredicateParameters{}),
+                          make_pool(num_threads)) {}
+
+ExtractionInterface::ExtractionInterface(std::shared_ptr<env_model::EnvironmentModel> env_model,
+                                         std::shared_ptr<parallel::WorkStealingPool> pool)
+    : env_model(std::move(env_model)),
+      initial_time_step(this->env_model->get_ego_params().initial_state.getTimeStep()), pool(std::move(pool)) {}
+
+std::shared_ptr<parallel::WorkStealingPool> ExtractionInterface::make_pool(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    if (num_threads > 1) {
+        return std::make_shared<parallel::WorkStealingPool>(num_threads);
+    }
+    return nullptr;
+}
+
+void ExtractionInterface::advance(const State &new_initial_state) {
+    env_model->advance(new_initial_state);
+    initial_time_step = new_initial_state.getTimeStep();
+}
+
 std::unordered_map<time_step_t, ExtractionResult> ExtractionInterface::extract_all(
     const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
-    auto relevant_obstacles = compute_relevant_obstacles(relevant_propositions);
+    return extract_all_compact(relevant_propositions).render_all();
+}
 
-    std::unordered_map<time_step_t, ExtractionResult> result{};
-    // Kleene extraction
-    extract_kleene(relevant_obstacles, result);
-    // Relationship extraction
-    extract_relationships(relevant_obstacles, result);
+CompactExtractionResult ExtractionInterface::extract_all_compact(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    return ExtractionSession{*this, relevant_propositions}.extract_all();
+}
 
-    return result;
+AnytimeExtractionResult ExtractionInterface::extract_all_anytime(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions,
+    const parallel::Budget &budget) {
+    return ExtractionSession{*this, relevant_propositions}.extract_all_anytime(budget);
 }
 
 std::unordered_map<time_step_t, ExtractionResult> ExtractionInterface::extract_all_but_implications(
     const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
-    auto relevant_obstacles = compute_relevant_obstacles(relevant_propositions);
-
-    std::unordered_map<time_step_t, ExtractionResult> result{};
-    // Kleene extraction
-    extract_kleene(relevant_obstacles, result);
-    // Relationship extraction
-    extract_relationships(relevant_obstacles, result, relationship::RelationshipType::EQUIVALENCE);
+    return extract_all_but_implications_compact(relevant_propositions).render_all();
+}
 
-    return result;
+CompactExtractionResult ExtractionInterface::extract_all_but_implications_compact(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    return ExtractionSession{*this, relevant_propositions}.extract_all_but_implications();
 }
 
 std::unordered_map<time_step_t, ExtractionResult> ExtractionInterface::extract_kleene(
     const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
-    auto relevant_obstacles = compute_relevant_obstacles(relevant_propositions);
-    std::unordered_map<time_step_t, ExtractionResult> result{};
-    extract_kleene(relevant_obstacles, result);
-    return result;
+    return extract_kleene_compact(relevant_propositions).render_all();
+}
+
+CompactExtractionResult ExtractionInterface::extract_kleene_compact(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    return ExtractionSession{*this, relevant_propositions}.extract_kleene();
 }
 
 void ExtractionInterface::extract_kleene(const RelevantObstacles &relevant_obstacles,
-                                         std::unordered_map<time_step_t, ExtractionResult> &result) {
+                                         std::vector<KnowledgeRecord> &records) {
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("ExtractionInterface::extract_kleene");
+    precompute_ego_approximations(relevant_obstacles);
+
+    auto &statistics = get_statistics_collector();
+    auto start = statistics.start_timer();
+    auto num_records = records.size();
+
+    // Each task handles one chunk of time steps of one proposition and writes into its own partial result,
+    // the partial results are merged in task order afterwards so that the result does not depend on scheduling
+    std::vector<std::pair<const kleene::KleeneExtractor *, env_model::RelevanceMatrix>> chunks;
     for (const auto &[prop, relevant_obstacles_over_time] : relevant_obstacles) {
-        auto extractor = create_kleene_extractor(prop);
-        if (extractor.has_value()) {
-            auto kleene_values = extractor.value()->extract(relevant_obstacles_over_time);
-            for (auto &[time_step, positive_negative] : kleene_values) {
-                // The time steps for the knowledge start at initial_time_step
-                // but the formula always starts evaluation at time_step 0
-                // so we need to account for this offset here
-                auto formula_time_step = time_step - initial_time_step;
-                std::ranges::move(positive_negative.first | std::views::transform([&prop](const auto &obstacle_id) {
-                                      return proposition::to_string(prop, obstacle_id);
-                                  }),
-                                  std::back_inserter(result[formula_time_step].positive_propositions));
-                std::ranges::move(positive_negative.second | std::views::transform([&prop](const auto &obstacle_id) {
-                                      return proposition::to_string(prop, obstacle_id);
-                                  }),
-                                  std::back_inserter(result[formula_time_step].negative_propositions));
+        const auto *extractor = get_kleene_extractor(prop);
+        if (extractor != nullptr) {
+            for (auto &chunk : split_into_chunks(relevant_obstacles_over_time)) {
+                chunks.emplace_back(extractor, std::move(chunk));
             }
         }
     }
+
+    std::vector<std::vector<KnowledgeRecord>> partial_records(chunks.size());
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        tasks.emplace_back([this, &chunks, &partial_records, i]() {
+            const auto &[extractor, chunk] = chunks[i];
+            extract_kleene_records(*extractor, chunk, partial_records[i]);
+        });
+    }
+    run_tasks(std::move(tasks));
+
+    for (auto &partial : partial_records) {
+        std::ranges::move(partial, std::back_inserter(records));
+    }
+    statistics.record_phase(ExtractionPhase::KLEENE, start, records.size() - num_records);
 }
 
 std::unordered_map<time_step_t, ExtractionResult> ExtractionInterface::extract_relationships(
     const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
-    auto relevant_obstacles = compute_relevant_obstacles(relevant_propositions);
-    std::unordered_map<time_step_t, ExtractionResult> result{};
-    extract_relationships(relevant_obstacles, result);
-    return result;
+    return extract_relationships_compact(relevant_propositions).render_all();
+}
+
+CompactExtractionResult ExtractionInterface::extract_relationships_compact(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    return ExtractionSession{*this, relevant_propositions}.extract_relationships();
 }
 
 std::unordered_map<time_step_t, ExtractionResult> ExtractionInterface::extract_equivalences(
     const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
-    auto relevant_obstacles = compute_relevant_obstacles(relevant_propositions);
-    std::unordered_map<time_step_t, ExtractionResult> result{};
-    extract_relationships(relevant_obstacles, result, relationship::RelationshipType::EQUIVALENCE);
-    return result;
+    return extract_equivalences_compact(relevant_propositions).render_all();
+}
+
+CompactExtractionResult ExtractionInterface::extract_equivalences_compact(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    return ExtractionSession{*this, relevant_propositions}.extract_equivalences();
 }
 
 std::unordered_map<time_step_t, ExtractionResult> ExtractionInterface::extract_implications(
     const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
-    auto relevant_obstacles = compute_relevant_obstacles(relevant_propositions);
-    std::unordered_map<time_step_t, ExtractionResult> result{};
-    extract_relationships(relevant_obstacles, result, relationship::RelationshipType::IMPLICATION);
-    return result;
+    return extract_implications_compact(relevant_propositions).render_all();
+}
+
+CompactExtractionResult ExtractionInterface::extract_implications_compact(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    return ExtractionSession{*this, relevant_propositions}.extract_implications();
 }
 
 void ExtractionInterface::extract_relationships(const ExtractionInterface::RelevantObstacles &relevant_obstacles,
-                                                std::unordered_map<time_step_t, ExtractionResult> &result,
+                                                std::vector<KnowledgeRecord> &records,
                                                 std::optional<relationship::RelationshipType> type) {
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("ExtractionInterface::extract_relationships");
+    precompute_ego_approximations(relevant_obstacles);
+
+    auto &statistics = get_statistics_collector();
+    auto start = statistics.start_timer();
+    auto num_records = records.size();
+
+    // Same task structure as for the Kleene extraction
+    std::vector<std::pair<const relationship::RelationshipExtractor *, env_model::RelevanceMatrix>> chunks;
     for (const auto &[prop, relevant_obstacles_over_time] : relevant_obstacles) {
-        auto extractor = create_relationship_extractor(prop);
-        if (extractor.has_value()) {
-            if (type.has_value() && extractor.value()->get_dominant_relationship() != type.value()) {
+        const auto *extractor = get_relationship_extractor(prop);
+        if (extractor != nullptr) {
+            if (type.has_value() && extractor->get_dominant_relationship() != type.value()) {
                 continue;
             }
-            auto [lhs, rhs] = extractor.value()->get_propositions();
-            auto relationships = extractor.value()->extract(relevant_obstacles_over_time);
-            for (auto &[time_step, relations] : relationships) {
-                // The time steps for the knowledge start at initial_time_step
-                // but the formula always starts evaluation at time_step 0
-                // so we need to account for this offset here
-                auto formula_time_step = time_step - initial_time_step;
-                for (const auto &rel : relations) {
-                    switch (std::get<0>(rel)) {
-                    case relationship::RelationshipType::IMPLICATION:
-                        result[formula_time_step].implications.emplace_back(
-                            proposition::to_string(lhs, std::get<1>(rel)),
-                            proposition::to_string(rhs, std::get<2>(rel)));
-                        break;
-                    case relationship::RelationshipType::EQUIVALENCE:
-                        result[formula_time_step].equivalences.emplace_back(
-                            proposition::to_string(lhs, std::get<1>(rel)),
-                            proposition::to_string(rhs, std::get<2>(rel)));
-                        break;
-                    default:
-                        break;
-                    }
-                }
+            for (auto &chunk : split_into_chunks(relevant_obstacles_over_time)) {
+                chunks.emplace_back(extractor, std::move(chunk));
+            }
+        }
+    }
+
+    std::vector<std::vector<KnowledgeRecord>> partial_records(chunks.size());
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        tasks.emplace_back([this, &chunks, &partial_records, i]() {
+            const auto &[extractor, chunk] = chunks[i];
+            extract_relationship_records(*extractor, chunk, partial_records[i]);
+        });
+    }
+    run_tasks(std::move(tasks));
+
+    for (auto &partial : partial_records) {
+        std::ranges::move(partial, std::back_inserter(records));
+    }
+    statistics.record_phase(ExtractionPhase::RELATIONSHIP, start, records.size() - num_records);
+}
+
+void ExtractionInterface::extract_kleene_records(const kleene::KleeneExtractor &extractor,
+                                                 const env_model::RelevanceMatrix &relevant_obstacles_over_time,
+                                                 std::vector<KnowledgeRecord> &records) const {
+    auto prop = extractor.get_proposition();
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE_DETAIL("KleeneExtractor::extract",
+                                              proposition::proposition_to_string.at(prop).c_str());
+    auto &statistics = get_statistics_collector();
+    auto start = statistics.start_timer();
+    auto num_records = records.size();
+    auto kleene_values = extractor.extract(relevant_obstacles_over_time);
+    for (const auto &[time_step, positive_negative] : kleene_values) {
+        // The time steps for the knowledge start at initial_time_step
+        // but the formula always starts evaluation at time_step 0
+        // so we need to account for this offset here
+        auto formula_time_step = time_step - initial_time_step;
+        for (const auto &obstacle_id : positive_negative.first) {
+            records.push_back({formula_time_step, KnowledgeKind::POSITIVE, prop, obstacle_id});
+        }
+        for (const auto &obstacle_id : positive_negative.second) {
+            records.push_back({formula_time_step, KnowledgeKind::NEGATIVE, prop, obstacle_id});
+        }
+    }
+    statistics.record_extraction(ExtractorKind::KLEENE, prop, start, records.size() - num_records);
+}
+
+void ExtractionInterface::extract_relationship_records(const relationship::RelationshipExtractor &extractor,
+                                                       const env_model::RelevanceMatrix &relevant_obstacles_over_time,
+                                                       std::vector<KnowledgeRecord> &records) const {
+    auto [lhs, rhs] = extractor.get_propositions();
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE_DETAIL("RelationshipExtractor::extract",
+                                              proposition::proposition_to_string.at(lhs).c_str());
+    auto &statistics = get_statistics_collector();
+    auto start = statistics.start_timer();
+    auto num_records = records.size();
+    auto relationships = extractor.extract(relevant_obstacles_over_time);
+    for (const auto &[time_step, relations] : relationships) {
+        // Same time step offset as for the Kleene knowledge
+        auto formula_time_step = time_step - initial_time_step;
+        for (const auto &rel : relations) {
+            switch (std::get<0>(rel)) {
+            case relationship::RelationshipType::IMPLICATION:
+                records.push_back(
+                    {formula_time_step, KnowledgeKind::IMPLICATION, lhs, std::get<1>(rel), rhs, std::get<2>(rel)});
+                break;
+            case relationship::RelationshipType::EQUIVALENCE:
+                records.push_back(
+                    {formula_time_step, KnowledgeKind::EQUIVALENCE, lhs, std::get<1>(rel), rhs, std::get<2>(rel)});
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    statistics.record_extraction(ExtractorKind::RELATIONSHIP, lhs, start, records.size() - num_records);
+}
+
+AnytimeExtractionResult ExtractionInterface::extract_anytime(const RelevantObstacles &relevant_obstacles,
+                                                             const parallel::Budget &budget) {
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("ExtractionInterface::extract_anytime");
+    precompute_ego_approximations(relevant_obstacles);
+
+    auto &statistics = get_statistics_collector();
+    auto start = statistics.start_timer();
+
+    // Units of a single time step keep the time between two checks of the budget short
+    struct Unit {
+        ExtractionCost cost;
+        time_step_t time_step;
+        ExtractorKind kind;
+        Proposition prop;
+        const kleene::KleeneExtractor *kleene_extractor;
+        const relationship::RelationshipExtractor *relationship_extractor;
+        env_model::RelevanceMatrix relevant_obstacles;
+    };
+    std::vector<Unit> units;
+    for (const auto &[prop, relevant_obstacles_over_time] : relevant_obstacles) {
+        const auto *kleene_extractor = get_kleene_extractor(prop);
+        const auto *relationship_extractor = get_relationship_extractor(prop);
+        for (const auto &[time_step, _] : relevant_obstacles_over_time) {
+            if (kleene_extractor != nullptr) {
+                units.push_back({anytime::estimate_cost(prop, ExtractorKind::KLEENE), time_step, ExtractorKind::KLEENE,
+                                 prop, kleene_extractor, nullptr,
+                                 relevant_obstacles_over_time.slice(time_step, time_step + 1)});
+            }
+            if (relationship_extractor != nullptr) {
+                units.push_back({anytime::estimate_cost(prop, ExtractorKind::RELATIONSHIP), time_step,
+                                 ExtractorKind::RELATIONSHIP, prop, nullptr, relationship_extractor,
+                                 relevant_obstacles_over_time.slice(time_step, time_step + 1)});
+            }
+        }
+    }
+    std::ranges::sort(units, {},
+                      [](const Unit &unit) { return std::tuple{unit.cost, unit.time_step, unit.kind, unit.prop}; });
+
+    // Workers take the units in schedule order, so the cheapest remaining unit is always started next
+    std::vector<std::vector<KnowledgeRecord>> partial_records(units.size());
+    std::vector<uint8_t> finished(units.size(), 0);
+    std::atomic<size_t> next_unit{0};
+    auto worker = [this, &units, &partial_records, &finished, &next_unit, &budget]() {
+        for (auto i = next_unit.fetch_add(1, std::memory_order_relaxed); i < units.size();
+             i = next_unit.fetch_add(1, std::memory_order_relaxed)) {
+            if (budget.is_expired()) {
+                return;
             }
+            const auto &unit = units[i];
+            if (unit.kind == ExtractorKind::KLEENE) {
+                extract_kleene_records(*unit.kleene_extractor, unit.relevant_obstacles, partial_records[i]);
+            } else {
+                extract_relationship_records(*unit.relationship_extractor, unit.relevant_obstacles, partial_records[i]);
+            }
+            finished[i] = 1;
+        }
+    };
+    std::vector<std::function<void()>> tasks(pool ? pool->get_num_threads() : 1, worker);
+    run_tasks(std::move(tasks));
+
+    AnytimeExtractionResult result;
+    std::vector<KnowledgeRecord> records;
+    for (size_t i = 0; i < units.size(); ++i) {
+        if (finished[i] != 0) {
+            std::ranges::move(partial_records[i], std::back_inserter(records));
+            ++result.report.num_completed;
+        } else {
+            result.report.skipped.push_back({units[i].kind, units[i].prop, units[i].time_step - initial_time_step});
+        }
+    }
+    result.report.complete = result.report.skipped.empty();
+    statistics.record_phase(ExtractionPhase::ANYTIME, start, records.size());
+    result.knowledge = CompactExtractionResult{std::move(records)};
+    return result;
+}
+
+std::vector<env_model::RelevanceMatrix>
+ExtractionInterface::split_into_chunks(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
+    if (!pool) {
+        return {relevant_obstacles_over_time};
+    }
+    return relevant_obstacles_over_time.split(time_steps_per_task);
+}
+
+void ExtractionInterface::precompute_ego_approximations(const RelevantObstacles &relevant_obstacles) const {
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("ExtractionInterface::precompute_ego_approximations");
+    time_step_t final_time_step = initial_time_step;
+    for (const auto &[_, relevant_obstacles_over_time] : relevant_obstacles) {
+        final_time_step =
+            std::max(final_time_step, relevant_obstacles_over_time.get_last_time_step().value_or(initial_time_step));
+    }
+    // Filling the table once up front keeps the tasks from contending for it
+    auto &statistics = get_statistics_collector();
+    auto start = statistics.start_timer();
+    env_model->get_ego_approximations()->precompute(final_time_step - initial_time_step);
+    statistics.record_phase(ExtractionPhase::PRECOMPUTATION, start, 0);
+}
+
+void ExtractionInterface::run_tasks(std::vector<std::function<void()>> tasks) {
+    if (pool) {
+        pool->run(std::move(tasks));
+    } else {
+        for (const auto &task : tasks) {
+            task();
         }
     }
 }
@@ -154,6 +378,35 @@ auto lanelet_type_to_string(LaneletType lanelet_type) {
         ->first;
 }
 
+const kleene::KleeneExtractor *ExtractionInterface::get_kleene_extractor(Proposition prop) {
+    auto it = kleene_extractors.find(prop);
+    if (it == kleene_extractors.end()) {
+        auto &statistics = get_statistics_collector();
+        auto start = statistics.start_timer();
+        auto extractor = create_kleene_extractor(prop);
+        if (extractor.has_value()) {
+            statistics.record_extractor_creation(ExtractorKind::KLEENE, prop, start);
+        }
+        it = kleene_extractors.emplace(prop, extractor.has_value() ? std::move(extractor.value()) : nullptr).first;
+    }
+    return it->second.get();
+}
+
+const relationship::RelationshipExtractor *ExtractionInterface::get_relationship_extractor(Proposition prop) {
+    auto it = relationship_extractors.find(prop);
+    if (it == relationship_extractors.end()) {
+        auto &statistics = get_statistics_collector();
+        auto start = statistics.start_timer();
+        auto extractor = create_relationship_extractor(prop);
+        if (extractor.has_value()) {
+            statistics.record_extractor_creation(ExtractorKind::RELATIONSHIP, prop, start);
+        }
+        it = relationship_extractors.emplace(prop, extractor.has_value() ? std::move(extractor.value()) : nullptr)
+                 .first;
+    }
+    return it->second.get();
+}
+
 std::optional<std::unique_ptr<kleene::KleeneExtractor>> ExtractionInterface::create_kleene_extractor(Proposition prop) {
     switch (prop) {
     case Proposition::ON_MAIN_CARRIAGEWAY:
@@ -327,24 +580,19 @@ ExtractionInterface::create_relationship_extractor(Proposition prop) {
     }
 }
 
-ExtractionInterface::RelevantObstacles ExtractionInterface::compute_relevant_obstacles(
-    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) const {
-    RelevantObstacles relevant_obstacles_over_time_per_prop{};
-    for (const auto &[time_step, propositions] : relevant_propositions) {
-        // The time steps for the relevant propositions always start at 0 (since LTL evaluation starts at 0),
-        // but we might have an initial time step in the scenario that is different from 0
-        // so we need to account for this offset here
-        auto scenario_time_step = initial_time_step + time_step;
-        for (const auto &prop : propositions) {
-            try {
-                auto [prop_enum, param] = proposition::from_string(prop);
-                relevant_obstacles_over_time_per_prop[prop_enum][scenario_time_step].insert(param);
-            } catch (const std::logic_error &e) {
-                // Unknown propositions are simply ignored with a warning
-                spdlog::warn("Unknown proposition: {}. No knowledge will be extracted for this proposition!", prop);
-                continue;
-            }
-        }
+const std::optional<std::pair<Proposition, std::optional<size_t>>> &
+ExtractionInterface::parse_proposition(const std::string &prop) {
+    auto it = parsed_propositions.find(prop);
+    if (it != parsed_propositions.end()) {
+        return it->second;
+    }
+
+    std::optional<std::pair<Proposition, std::optional<size_t>>> parsed;
+    try {
+        parsed = proposition::from_string(prop);
+    } catch (const std::logic_error &e) {
+        // Unknown propositions are simply ignored with a warning
+        spdlog::warn("Unknown proposition: {}. No knowledge will be extracted for this proposition!", prop);
     }
-    return relevant_obstacles_over_time_per_prop;
+    return parsed_propositions.emplace(prop, parsed).first->second;
 }
@@ -0,0 +1,68 @@
+#include "cr_knowledge_extraction/extraction_result.hpp"
+
+#include <algorithm>
+
+using namespace knowledge_extraction;
+
+CompactExtractionResult::CompactExtractionResult(std::vector<KnowledgeRecord> records) {
+    if (records.empty()) {
+        return;
+    }
+
+    // Counting sort by time step, which is stable and linear since formula time steps are small and dense
+    auto max_time_step = std::ranges::max(records, {}, &KnowledgeRecord::time_step).time_step;
+    offsets.assign(max_time_step + 2, 0);
+    for (const auto &record : records) {
+        ++offsets[record.time_step + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    auto positions = offsets;
+    this->records.resize(records.size());
+    for (auto &record : records) {
+        this->records[positions[record.time_step]++] = std::move(record);
+    }
+}
+
+std::vector<time_step_t> CompactExtractionResult::get_time_steps() const {
+    std::vector<time_step_t> time_steps;
+    for (time_step_t time_step = 0; time_step + 1 < offsets.size(); ++time_step) {
+        if (offsets[time_step] != offsets[time_step + 1]) {
+            time_steps.push_back(time_step);
+        }
+    }
+    return time_steps;
+}
+
+ExtractionResult CompactExtractionResult::render(time_step_t time_step) const {
+    ExtractionResult result;
+    for (const auto &record : get_records(time_step)) {
+        switch (record.kind) {
+        case KnowledgeKind::POSITIVE:
+            result.positive_propositions.push_back(proposition::to_string(record.lhs, record.lhs_parameter));
+            break;
+        case KnowledgeKind::NEGATIVE:
+            result.negative_propositions.push_back(proposition::to_string(record.lhs, record.lhs_parameter));
+            break;
+        case KnowledgeKind::IMPLICATION:
+            result.implications.emplace_back(proposition::to_string(record.lhs, record.lhs_parameter),
+                                             proposition::to_string(record.rhs, record.rhs_parameter));
+            break;
+        case KnowledgeKind::EQUIVALENCE:
+            result.equivalences.emplace_back(proposition::to_string(record.lhs, record.lhs_parameter),
+                                             proposition::to_string(record.rhs, record.rhs_parameter));
+            break;
+        }
+    }
+    return result;
+}
+
+std::unordered_map<time_step_t, ExtractionResult> CompactExtractionResult::render_all() const {
+    std::unordered_map<time_step_t, ExtractionResult> result;
+    for (auto time_step : get_time_steps()) {
+        result.emplace(time_step, render(time_step));
+    }
+    return result;
+}
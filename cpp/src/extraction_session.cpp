@@ -0,0 +1,149 @@
+#include "cr_knowledge_extraction/extraction_session.hpp"
+
+#include "cr_knowledge_extraction/tracing.hpp"
+
+using namespace knowledge_extraction;
+
+ExtractionSession::ExtractionSession(
+    ExtractionInterface &extraction_interface,
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions)
+    : extraction_interface(extraction_interface), initial_time_step(extraction_interface.initial_time_step) {
+    update(relevant_propositions);
+}
+
+void ExtractionSession::update(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &new_relevant_propositions) {
+    CR_KNOWLEDGE_EXTRACTION_TRACE_ZONE("ExtractionSession::update");
+    sync_initial_time_step();
+
+    // Drop time steps that are no longer relevant at all
+    for (auto it = relevant_propositions.begin(); it != relevant_propositions.end();) {
+        if (new_relevant_propositions.contains(it->first)) {
+            ++it;
+            continue;
+        }
+        for (const auto &prop : it->second) {
+            remove_relevant_proposition(it->first, prop);
+        }
+        it = relevant_propositions.erase(it);
+    }
+
+    for (const auto &[time_step, propositions] : new_relevant_propositions) {
+        std::unordered_set<std::string> new_propositions{propositions.begin(), propositions.end()};
+        auto &old_propositions = relevant_propositions[time_step];
+        for (const auto &prop : old_propositions) {
+            if (!new_propositions.contains(prop)) {
+                remove_relevant_proposition(time_step, prop);
+            }
+        }
+        for (const auto &prop : new_propositions) {
+            if (!old_propositions.contains(prop)) {
+                add_relevant_proposition(time_step, prop);
+            }
+        }
+        old_propositions = std::move(new_propositions);
+    }
+}
+
+void ExtractionSession::sync_initial_time_step() {
+    if (initial_time_step == extraction_interface.initial_time_step) {
+        return;
+    }
+    // Formula time steps stay the same, so every scenario time step moves by the difference of the initial time steps
+    for (auto &[_, relevant_obstacles_over_time] : relevant_obstacles) {
+        relevant_obstacles_over_time.move_time_steps(initial_time_step, extraction_interface.initial_time_step);
+    }
+    initial_time_step = extraction_interface.initial_time_step;
+}
+
+void ExtractionSession::add_relevant_proposition(time_step_t time_step, const std::string &prop) {
+    const auto &parsed = extraction_interface.parse_proposition(prop);
+    if (!parsed.has_value()) {
+        return;
+    }
+    // The time steps for the relevant propositions always start at 0 (since LTL evaluation starts at 0),
+    // but we might have an initial time step in the scenario that is different from 0
+    // so we need to account for this offset here
+    auto scenario_time_step = initial_time_step + time_step;
+    const auto &[prop_enum, param] = parsed.value();
+    const auto &index = extraction_interface.env_model->get_world_cache()->get_obstacle_time_index();
+    auto [prop_it, _] = relevant_obstacles.try_emplace(prop_enum, index);
+    // Obstacles that do not exist in the world cannot be marked, the extractors would skip them anyway
+    if (!prop_it->second.insert(scenario_time_step, param) && prop_it->second.empty()) {
+        relevant_obstacles.erase(prop_it);
+    }
+}
+
+void ExtractionSession::remove_relevant_proposition(time_step_t time_step, const std::string &prop) {
+    const auto &parsed = extraction_interface.parse_proposition(prop);
+    if (!parsed.has_value()) {
+        return;
+    }
+    auto scenario_time_step = initial_time_step + time_step;
+    const auto &[prop_enum, param] = parsed.value();
+    auto prop_it = relevant_obstacles.find(prop_enum);
+    if (prop_it == relevant_obstacles.end()) {
+        return;
+    }
+    prop_it->second.erase(scenario_time_step, param);
+    // Empty time steps are skipped by the extractors, but empty propositions would still create tasks
+    if (prop_it->second.empty()) {
+        relevant_obstacles.erase(prop_it);
+    }
+}
+
+CompactExtractionResult ExtractionSession::extract_all() {
+    sync_initial_time_step();
+    std::vector<KnowledgeRecord> records;
+    // Kleene extraction
+    extraction_interface.extract_kleene(relevant_obstacles, records);
+    // Relationship extraction
+    extraction_interface.extract_relationships(relevant_obstacles, records);
+    return CompactExtractionResult{std::move(records)};
+}
+
+AnytimeExtractionResult ExtractionSession::extract_all_anytime(const parallel::Budget &budget) {
+    sync_initial_time_step();
+    return extraction_interface.extract_anytime(relevant_obstacles, budget);
+}
+
+CompactExtractionResult ExtractionSession::extract_all_but_implications() {
+    sync_initial_time_step();
+    std::vector<KnowledgeRecord> records;
+    // Kleene extraction
+    extraction_interface.extract_kleene(relevant_obstacles, records);
+    // Relationship extraction
+    extraction_interface.extract_relationships(relevant_obstacles, records,
+                                               relationship::RelationshipType::EQUIVALENCE);
+    return CompactExtractionResult{std::move(records)};
+}
+
+CompactExtractionResult ExtractionSession::extract_kleene() {
+    sync_initial_time_step();
+    std::vector<KnowledgeRecord> records;
+    extraction_interface.extract_kleene(relevant_obstacles, records);
+    return CompactExtractionResult{std::move(records)};
+}
+
+CompactExtractionResult ExtractionSession::extract_relationships() {
+    sync_initial_time_step();
+    std::vector<KnowledgeRecord> records;
+    extraction_interface.extract_relationships(relevant_obstacles, records);
+    return CompactExtractionResult{std::move(records)};
+}
+
+CompactExtractionResult ExtractionSession::extract_equivalences() {
+    sync_initial_time_step();
+    std::vector<KnowledgeRecord> records;
+    extraction_interface.extract_relationships(relevant_obstacles, records,
+                                               relationship::RelationshipType::EQUIVALENCE);
+    return CompactExtractionResult{std::move(records)};
+}
+
+CompactExtractionResult ExtractionSession::extract_implications() {
+    sync_initial_time_step();
+    std::vector<KnowledgeRecord> records;
+    extraction_interface.extract_relationships(relevant_obstacles, records,
+                                               relationship::RelationshipType::IMPLICATION);
+    return CompactExtractionResult{std::move(records)};
+}
@@ -0,0 +1,64 @@
+#include "cr_knowledge_extraction/hypothesis_batch.hpp"
+
+#include "cr_knowledge_extraction/env_model/curvilinear_cache.hpp"
+#include "cr_knowledge_extraction/env_model/env_model.hpp"
+
+#include <algorithm>
+
+using namespace knowledge_extraction;
+
+HypothesisBatch::HypothesisBatch(std::shared_ptr<World> world, const std::vector<EgoHypothesis> &hypotheses,
+                                 size_t num_threads)
+    : world_cache(std::make_shared<env_model::WorldCache>(std::move(world))),
+      pool(ExtractionInterface::make_pool(num_threads)) {
+    std::unordered_map<const geometry::CurvilinearCoordinateSystem *, std::shared_ptr<env_model::CurvilinearCache>>
+        ccs_caches;
+    extraction_interfaces.reserve(hypotheses.size());
+    for (const auto &hypothesis : hypotheses) {
+        auto &ccs_cache = ccs_caches[hypothesis.ego_ccs.get()];
+        if (!ccs_cache) {
+            ccs_cache = std::make_shared<env_model::CurvilinearCache>(world_cache, hypothesis.ego_ccs);
+        }
+        auto env_model =
+            std::make_shared<env_model::EnvironmentModel>(ccs_cache, hypothesis.ego_params, PredicateParameters{});
+        extraction_interfaces.emplace_back(std::make_unique<ExtractionInterface>(std::move(env_model), pool));
+    }
+}
+
+void HypothesisBatch::precompute_ego_approximations(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    // Relevant propositions use formula time steps, which are relative to the initial time step of each hypothesis
+    time_step_t horizon = 0;
+    for (const auto &[time_step, _] : relevant_propositions) {
+        horizon = std::max(horizon, time_step);
+    }
+    std::vector<ego_behavior::BehaviorOverapproximation *> approximations;
+    approximations.reserve(extraction_interfaces.size());
+    for (const auto &extraction_interface : extraction_interfaces) {
+        approximations.push_back(extraction_interface->get_env_model()->get_ego_approximations().get());
+    }
+    ego_behavior::BehaviorOverapproximation::precompute_batch(approximations, horizon, pool.get());
+}
+
+std::vector<std::unordered_map<time_step_t, ExtractionResult>>
+HypothesisBatch::extract_all(const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    std::vector<std::unordered_map<time_step_t, ExtractionResult>> results;
+    results.reserve(extraction_interfaces.size());
+    for (const auto &result : extract_all_compact(relevant_propositions)) {
+        results.push_back(result.render_all());
+    }
+    return results;
+}
+
+std::vector<CompactExtractionResult> HypothesisBatch::extract_all_compact(
+    const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions) {
+    precompute_ego_approximations(relevant_propositions);
+
+    // The hypotheses share one pool, so they are extracted one after another with all threads working on each
+    std::vector<CompactExtractionResult> results;
+    results.reserve(extraction_interfaces.size());
+    for (const auto &extraction_interface : extraction_interfaces) {
+        results.push_back(extraction_interface->extract_all_compact(relevant_propositions));
+    }
+    return results;
+}
@@ -0,0 +1,37 @@
+#include "cr_knowledge_extraction/id_index.hpp"
+
+#include <stdexcept>
+#include <string>
+
+using namespace knowledge_extraction;
+
+IdIndex::IdIndex(const std::vector<size_t> &ids) : num_ids(ids.size()) {
+    if (ids.empty()) {
+        return;
+    }
+
+    auto [min_element, max_element] = std::ranges::minmax_element(ids);
+    min_id = *min_element;
+    auto id_range = *max_element - *min_element + 1;
+    if (id_range <= max_lookup_table_size) {
+        lookup_table.assign(id_range, no_index);
+        for (uint32_t i = 0; i < ids.size(); ++i) {
+            auto &entry = lookup_table[ids[i] - min_id];
+            if (entry != no_index) {
+                throw std::invalid_argument("Duplicate ID " + std::to_string(ids[i]));
+            }
+            entry = i;
+        }
+    } else {
+        sorted_ids.reserve(ids.size());
+        for (uint32_t i = 0; i < ids.size(); ++i) {
+            sorted_ids.emplace_back(ids[i], i);
+        }
+        std::ranges::sort(sorted_ids);
+        auto duplicate = std::ranges::adjacent_find(
+            sorted_ids, [](const auto &lhs, const auto &rhs) { return lhs.first == rhs.first; });
+        if (duplicate != sorted_ids.end()) {
+            throw std::invalid_argument("Duplicate ID " + std::to_string(duplicate->first));
+        }
+    }
+}
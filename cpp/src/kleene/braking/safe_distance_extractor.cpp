@@ -6,17 +6,14 @@
 
 using namespace knowledge_extraction::kleene::braking;
 
-std::unordered_map<time_step_t, SafeDistanceExtractor::TrueFalseObstacleIds> SafeDistanceExtractor::extract(
-    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
-    const {
+std::unordered_map<time_step_t, SafeDistanceExtractor::TrueFalseObstacleIds>
+SafeDistanceExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
     std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
     auto a_min_ego = env_model->get_ego_params().a_lon_min;
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
+        auto relevant_obstacles = env_model->get_obstacles(row);
         auto relevant_obstacle_stopping_s =
-            env_model->get_world()->getObstacles() | std::views::filter([&obstacle_ids](const auto &obstacle) {
-                return obstacle_ids.contains(obstacle->getId());
-            }) |
-            std::views::transform([this, &time_step, &a_min_ego](const auto &obstacle) {
+            relevant_obstacles | std::views::transform([this, &time_step, &a_min_ego](const auto &obstacle) {
                 assert(obstacle->getAminLong() < a_min_ego);
                 return std::make_pair(obstacle->getId(), env_model->get_stopping_s(time_step, obstacle));
             }) |
@@ -1,30 +1,35 @@
 #include "cr_knowledge_extraction/kleene/intersection/on_incoming_left_of_extractor.hpp"
 
 #include <commonroad_cpp/obstacle/obstacle.h>
-#include <commonroad_cpp/roadNetwork/intersection/incoming_group.h>
-#include <commonroad_cpp/roadNetwork/lanelet/lane.h>
 
-#include <ranges>
+#include <algorithm>
+#include <utility>
 
 using namespace knowledge_extraction::kleene::intersection;
 
-std::unordered_map<time_step_t, OnIncomingLeftOfExtractor::TrueFalseObstacleIds> OnIncomingLeftOfExtractor::extract(
-    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
-    const {
-    const auto &road_network = env_model->get_world()->getRoadNetwork();
+std::unordered_map<time_step_t, OnIncomingLeftOfExtractor::TrueFalseObstacleIds>
+OnIncomingLeftOfExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
+    const auto &lanelet_attributes = env_model->get_lanelet_attributes();
 
     std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
-        auto relevant_obstacles =
-            env_model->get_world()->getObstacles() | std::views::filter([&obstacle_ids](const auto &obstacle) {
-                return obstacle_ids.contains(obstacle->getId());
-            });
-
-        auto left_of_incomings_could = get_incoming_left_of_ids_from_lanelets(
-            env_model->get_ego_approximations()->get_covered_lanelets(time_step), road_network);
-
-        auto left_of_incomings_must = get_incoming_left_of_ids_from_lanelets(
-            env_model->get_ego_approximations()->get_intersected_lanelets(time_step), road_network);
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
+        auto relevant_obstacles = env_model->get_obstacles(row);
+
+        const auto &ego_covered_lanelets = env_model->get_ego_approximations()->get_covered_lanelets(time_step);
+        const auto &ego_intersected_lanelets =
+            env_model->get_ego_approximations()->get_intersected_lanelets(time_step);
+
+        // Table lookups only, the world does not need to be locked
+        auto left_of_incomings_could =
+            get_incoming_left_of_ids_from_lanelets(ego_covered_lanelets, lanelet_attributes).first;
+        // If the ego vehicle might be on an incoming lanelet that is left of no group, no obstacle is surely on the
+        // incoming left of it
+        std::optional<std::unordered_set<size_t>> left_of_incomings_must;
+        if (auto [left_of_ids, is_complete] =
+                get_incoming_left_of_ids_from_lanelets(ego_intersected_lanelets, lanelet_attributes);
+            is_complete) {
+            left_of_incomings_must = std::move(left_of_ids);
+        }
 
         for (const auto &obstacle : relevant_obstacles) {
             auto is_left_of =
@@ -41,47 +46,53 @@ std::unordered_map<time_step_t, OnIncomingLeftOfExtractor::TrueFalseObstacleIds>
     return true_false_obstacle_ids;
 }
 
-std::optional<bool>
-OnIncomingLeftOfExtractor::is_on_incoming_left_of(const time_step_t &time_step,
-                                                  const std::shared_ptr<Obstacle> &obstacle,
-                                                  const std::unordered_set<size_t> &left_of_incomings_could,
-                                                  const std::unordered_set<size_t> &left_of_incomings_must) const {
+std::optional<bool> OnIncomingLeftOfExtractor::is_on_incoming_left_of(
+    const time_step_t &time_step, const std::shared_ptr<Obstacle> &obstacle,
+    const std::unordered_set<size_t> &left_of_incomings_could,
+    const std::optional<std::unordered_set<size_t>> &left_of_incomings_must) const {
     if (left_of_incomings_could.empty()) {
         return false;
     }
 
-    const auto &road_network = env_model->get_world()->getRoadNetwork();
+    const auto &lanelet_attributes = env_model->get_lanelet_attributes();
+    {
+        const auto &road_network = env_model->get_world()->getRoadNetwork();
+        auto lock = env_model->lock_world();
+        std::vector<std::shared_ptr<Lanelet>> obs_lanelets;
+        try {
+            obs_lanelets = obstacle->getOccupiedLaneletsByShape(road_network, time_step);
+        } catch (const std::logic_error &e) {
+            return std::nullopt;
+        }
+        if (std::ranges::none_of(obs_lanelets, [&lanelet_attributes](const auto &lanelet) {
+                return lanelet_attributes.get_attributes(lanelet).has_type(LaneletType::incoming);
+            })) {
+            return false;
+        }
+    }
 
-    std::vector<std::shared_ptr<Lanelet>> obs_lanelets;
-    try {
-        obs_lanelets = obstacle->getOccupiedLaneletsByShape(road_network, time_step);
-    } catch (const std::logic_error &e) {
+    const auto *reference_lane_lanelets = env_model->get_reference_lane_lanelets(time_step, obstacle);
+    if (reference_lane_lanelets == nullptr) {
         return std::nullopt;
     }
-    if (std::ranges::none_of(obs_lanelets,
-                             [](const auto &lanelet) { return lanelet->hasLaneletType(LaneletType::incoming); })) {
-        return false;
+    std::unordered_set<size_t> obs_incomings;
+    for (auto lanelet_id : reference_lane_lanelets->incoming_lanelet_ids) {
+        auto incoming_id = lanelet_attributes.get_incoming_group_id(lanelet_id);
+        if (!incoming_id.has_value()) {
+            // The incoming group is missing, which was reported when the lanelet attributes were computed
+            return std::nullopt;
+        }
+        obs_incomings.insert(incoming_id.value());
     }
 
-    auto obs_incomings_ =
-        obstacle->getReferenceLane(road_network, time_step)->getContainedLanelets() |
-        std::views::filter([](const auto &lanelet) { return lanelet->hasLaneletType(LaneletType::incoming); }) |
-        std::views::transform([&road_network](const auto &lanelet) {
-            auto incoming = road_network->findIncomingGroupByLanelet(lanelet);
-            if (!incoming) {
-                throw std::runtime_error{"missing incoming (obstacle)"};
-            }
-            return incoming->getId();
-        });
-    std::unordered_set<size_t> obs_incomings{obs_incomings_.begin(), obs_incomings_.end()};
-
     if (std::ranges::none_of(left_of_incomings_could, [&obs_incomings](const auto &left_of_incoming_id) {
             return obs_incomings.contains(left_of_incoming_id);
         })) {
         return false;
     }
 
-    if (std::ranges::all_of(left_of_incomings_must, [&obs_incomings](const auto &left_of_incoming_id) {
+    if (left_of_incomings_must.has_value() &&
+        std::ranges::all_of(*left_of_incomings_must, [&obs_incomings](const auto &left_of_incoming_id) {
             return obs_incomings.contains(left_of_incoming_id);
         })) {
         return true;
@@ -90,21 +101,22 @@ OnIncomingLeftOfExtractor::is_on_incoming_left_of(const time_step_t &time_step,
     return std::nullopt;
 }
 
-std::unordered_set<size_t>
-OnIncomingLeftOfExtractor::get_incoming_left_of_ids_from_lanelets(const std::vector<std::shared_ptr<Lanelet>> &lanelets,
-                                                                  const std::shared_ptr<RoadNetwork> &road_network) {
-    auto left_of_ids =
-        lanelets |
-        std::views::filter([](const auto &lanelet) { return lanelet->hasLaneletType(LaneletType::incoming); }) |
-        std::views::transform([&road_network](const auto &lanelet) {
-            auto incoming = road_network->findIncomingGroupByLanelet(lanelet);
-            if (!incoming) {
-                throw std::runtime_error{"missing incoming (ego)"};
-            }
-            if (!incoming->getIsLeftOf()) {
-                throw std::runtime_error{"missing 'left of' incoming"};
-            }
-            return incoming->getIsLeftOf()->getId();
-        });
-    return {left_of_ids.begin(), left_of_ids.end()};
+std::pair<std::unordered_set<size_t>, bool> OnIncomingLeftOfExtractor::get_incoming_left_of_ids_from_lanelets(
+    const std::vector<std::shared_ptr<Lanelet>> &lanelets,
+    const road_network::LaneletAttributeTable &lanelet_attributes) {
+    std::unordered_set<size_t> left_of_ids;
+    auto is_complete = true;
+    for (const auto &lanelet : lanelets) {
+        if (!lanelet_attributes.get_attributes(lanelet).has_type(LaneletType::incoming)) {
+            continue;
+        }
+        // A missing group was reported when the lanelet attributes were computed
+        auto left_of_id = lanelet_attributes.get_left_of_incoming_group_id(lanelet->getId());
+        if (!left_of_id.has_value()) {
+            is_complete = false;
+            continue;
+        }
+        left_of_ids.insert(left_of_id.value());
+    }
+    return {std::move(left_of_ids), is_complete};
 }
@@ -1,31 +1,20 @@
 #include "cr_knowledge_extraction/kleene/position/at_traffic_sign_extractor.hpp"
 
-#include <commonroad_cpp/roadNetwork/regulatoryElements/traffic_sign.h>
-#include <commonroad_cpp/roadNetwork/road_network.h>
-
 #include <ranges>
 
 using namespace knowledge_extraction::kleene::position;
 
-std::unordered_map<time_step_t, AtTrafficSignExtractor::TrueFalseObstacleIds> AtTrafficSignExtractor::extract(
-    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
-    const {
-
-    auto relevant_lanelet_ids_ = env_model->get_world()->getRoadNetwork()->getLaneletNetwork() |
-                                 std::views::filter([this](const auto &lanelet) {
-                                     return std::ranges::any_of(lanelet->getTrafficSigns(), [this](const auto &sign) {
-                                         return !sign->getTrafficSignElementsOfType(traffic_sign_type).empty();
-                                     });
-                                 }) |
-                                 std::views::transform([](const auto &lanelet) { return lanelet->getId(); });
-    std::unordered_set<size_t> relevant_lanelet_ids{relevant_lanelet_ids_.begin(), relevant_lanelet_ids_.end()};
+std::unordered_map<time_step_t, AtTrafficSignExtractor::TrueFalseObstacleIds>
+AtTrafficSignExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
+    const auto &lanelet_attributes = env_model->get_lanelet_attributes();
+    const auto &relevant_lanelets = env_model->get_lanelets_with_traffic_sign(traffic_sign_type);
 
     std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
-        // Should only contain std::nullopt as this predicate does not have parameters
-        assert(obstacle_ids.size() == 1);
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
+        // Should only contain the ego vehicle as this predicate does not have parameters
+        assert(row.size() == 1 && row.contains_ego());
 
-        if (relevant_lanelet_ids.empty()) {
+        if (relevant_lanelets.empty()) {
             true_false_obstacle_ids[time_step].second.insert(std::nullopt);
             continue;
         }
@@ -34,7 +23,7 @@ std::unordered_map<time_step_t, AtTrafficSignExtractor::TrueFalseObstacleIds> At
 
         auto cannot_be_true = std::ranges::none_of(
             approximations->get_covered_lanelets(time_step),
-            [&relevant_lanelet_ids](const auto &lanelet) { return relevant_lanelet_ids.contains(lanelet->getId()); });
+            [&](const auto &lanelet) { return lanelet_attributes.contains(relevant_lanelets, lanelet); });
         if (cannot_be_true) {
             true_false_obstacle_ids[time_step].second.insert(std::nullopt);
             continue;
@@ -42,7 +31,7 @@ std::unordered_map<time_step_t, AtTrafficSignExtractor::TrueFalseObstacleIds> At
 
         auto must_be_true = std::ranges::all_of(
             approximations->get_intersected_lanelets(time_step),
-            [&relevant_lanelet_ids](const auto &lanelet) { return relevant_lanelet_ids.contains(lanelet->getId()); });
+            [&](const auto &lanelet) { return lanelet_attributes.contains(relevant_lanelets, lanelet); });
         if (must_be_true) {
             true_false_obstacle_ids[time_step].first.insert(std::nullopt);
             continue;
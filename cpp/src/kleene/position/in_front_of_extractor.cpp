@@ -6,16 +6,13 @@
 
 using namespace knowledge_extraction::kleene::position;
 
-std::unordered_map<time_step_t, InFrontOfExtractor::TrueFalseObstacleIds> InFrontOfExtractor::extract(
-    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
-    const {
+std::unordered_map<time_step_t, InFrontOfExtractor::TrueFalseObstacleIds>
+InFrontOfExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
     std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
+        auto relevant_obstacles = env_model->get_obstacles(row);
         auto relevant_obstacle_rears =
-            env_model->get_world()->getObstacles() | std::views::filter([&obstacle_ids](const auto &obstacle) {
-                return obstacle_ids.contains(obstacle->getId());
-            }) |
-            std::views::transform([this, &time_step](const auto &obstacle) {
+            relevant_obstacles | std::views::transform([this, &time_step](const auto &obstacle) {
                 return std::make_pair(obstacle->getId(), env_model->get_obstacle_rear(time_step, obstacle));
             }) |
             std::views::filter([](const auto &pair) { return pair.second.has_value(); }) |
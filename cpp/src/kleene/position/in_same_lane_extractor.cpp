@@ -2,43 +2,61 @@
 
 #include <commonroad_cpp/obstacle/obstacle.h>
 
-#include <ranges>
+#include <algorithm>
+#include <span>
 
 using namespace knowledge_extraction::kleene::position;
 
-std::unordered_map<time_step_t, InSameLaneExtractor::TrueFalseObstacleIds> InSameLaneExtractor::extract(
-    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
-    const {
-    std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
-        auto relevant_obstacle_lanes =
-            env_model->get_world()->getObstacles() | std::views::filter([&obstacle_ids](const auto &obstacle) {
-                return obstacle_ids.contains(obstacle->getId());
-            }) |
-            std::views::transform([this, &time_step](const auto &obstacle) {
-                return std::make_pair(obstacle->getId(), env_model->get_obstacle_lane_ids(time_step, obstacle));
-            }) |
-            std::views::filter([](const auto &pair) { return pair.second.has_value(); }) |
-            std::views::transform([](const auto &pair) { return std::make_pair(pair.first, pair.second.value()); });
+namespace {
+std::vector<uint64_t> get_sorted_ids(const std::vector<std::shared_ptr<Lanelet>> &lanelets) {
+    std::vector<uint64_t> ids;
+    ids.reserve(lanelets.size());
+    for (const auto &lanelet : lanelets) {
+        ids.push_back(lanelet->getId());
+    }
+    std::ranges::sort(ids);
+    ids.erase(std::ranges::unique(ids).begin(), ids.end());
+    return ids;
+}
+
+// Whether two ranges in ascending order have a common element
+bool intersects(std::span<const uint64_t> first, std::span<const uint64_t> second) {
+    auto first_it = first.begin();
+    auto second_it = second.begin();
+    while (first_it != first.end() && second_it != second.end()) {
+        if (*first_it < *second_it) {
+            ++first_it;
+        } else if (*second_it < *first_it) {
+            ++second_it;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
 
+std::unordered_map<time_step_t, InSameLaneExtractor::TrueFalseObstacleIds>
+InSameLaneExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
+    std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
         const auto &approximations = env_model->get_ego_approximations();
-        const auto &ego_covered_lanelets = approximations->get_covered_lanelets(time_step);
-        const auto &ego_intersected_lanelets = approximations->get_intersected_lanelets(time_step);
-
-        for (const auto &[obstacle_id, lanelet_ids] : relevant_obstacle_lanes) {
-            auto cannot_be_true = std::ranges::none_of(ego_covered_lanelets, [&lanelet_ids](const auto &lanelet) {
-                return lanelet_ids.contains(lanelet->getId());
-            });
-            if (cannot_be_true) {
-                true_false_obstacle_ids[time_step].second.emplace(obstacle_id);
+        auto ego_covered_ids = get_sorted_ids(approximations->get_covered_lanelets(time_step));
+        auto ego_intersected_ids = get_sorted_ids(approximations->get_intersected_lanelets(time_step));
+
+        for (const auto &obstacle : env_model->get_obstacles(row)) {
+            auto lanelet_ids = env_model->get_obstacle_lane_ids(time_step, obstacle);
+            if (!lanelet_ids.has_value()) {
+                continue;
+            }
+
+            if (!intersects(ego_covered_ids, lanelet_ids.value())) {
+                true_false_obstacle_ids[time_step].second.emplace(obstacle->getId());
                 continue;
             }
 
-            auto must_be_true = std::ranges::all_of(ego_intersected_lanelets, [&lanelet_ids](const auto &lanelet) {
-                return lanelet_ids.contains(lanelet->getId());
-            });
-            if (must_be_true) {
-                true_false_obstacle_ids[time_step].first.emplace(obstacle_id);
+            if (std::ranges::includes(lanelet_ids.value(), ego_intersected_ids)) {
+                true_false_obstacle_ids[time_step].first.emplace(obstacle->getId());
                 continue;
             }
         }
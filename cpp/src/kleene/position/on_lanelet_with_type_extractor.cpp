@@ -1,32 +1,28 @@
 #include "cr_knowledge_extraction/kleene/position/on_lanelet_with_type_extractor.hpp"
 
-#include <ranges>
-
 using namespace knowledge_extraction::kleene::position;
 
-std::unordered_map<time_step_t, OnLaneletWithTypeExtractor::TrueFalseObstacleIds> OnLaneletWithTypeExtractor::extract(
-    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
-    const {
+std::unordered_map<time_step_t, OnLaneletWithTypeExtractor::TrueFalseObstacleIds>
+OnLaneletWithTypeExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
+    const auto type_bit = road_network::LaneletAttributes::type_bit(lanelet_type);
+
     std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
-        // Should only contain std::nullopt as this predicate does not have parameters
-        assert(obstacle_ids.size() == 1);
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
+        // Should only contain the ego vehicle as this predicate does not have parameters
+        assert(row.size() == 1 && row.contains_ego());
 
         const auto &approximations = env_model->get_ego_approximations();
+        const auto &lanelet_attributes = env_model->get_lanelet_attributes();
 
         auto cannot_be_true =
-            std::ranges::none_of(approximations->get_covered_lanelets(time_step), [this](const auto &lanelet) {
-                return lanelet->getLaneletTypes().contains(lanelet_type);
-            });
+            (lanelet_attributes.get_types_of_any(approximations->get_covered_lanelets(time_step)) & type_bit) == 0;
         if (cannot_be_true) {
             true_false_obstacle_ids[time_step].second.insert(std::nullopt);
             continue;
         }
 
         auto must_be_true =
-            std::ranges::all_of(approximations->get_intersected_lanelets(time_step), [this](const auto &lanelet) {
-                return lanelet->getLaneletTypes().contains(lanelet_type);
-            });
+            (lanelet_attributes.get_types_of_all(approximations->get_intersected_lanelets(time_step)) & type_bit) != 0;
         if (must_be_true) {
             true_false_obstacle_ids[time_step].first.insert(std::nullopt);
             continue;
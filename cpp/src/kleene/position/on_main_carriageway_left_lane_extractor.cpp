@@ -5,26 +5,31 @@
 using namespace knowledge_extraction::kleene::position;
 
 std::unordered_map<time_step_t, OnMainCarriagewayLeftLaneExtractor::TrueFalseObstacleIds>
-OnMainCarriagewayLeftLaneExtractor::extract(
-    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
-    const {
+OnMainCarriagewayLeftLaneExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
+    // The leftmost lane of a road, or a lane whose left neighbour belongs to the oncoming traffic
+    constexpr uint8_t outer_lane_flags = road_network::LaneletAttributes::leftmost |
+                                         road_network::LaneletAttributes::left_neighbour_opposite;
+    const auto mcw_bit = road_network::LaneletAttributes::type_bit(LaneletType::mainCarriageWay);
+
     std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
-        // Should only contain std::nullopt as this predicate does not have parameters
-        assert(obstacle_ids.size() == 1);
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
+        // Should only contain the ego vehicle as this predicate does not have parameters
+        assert(row.size() == 1 && row.contains_ego());
 
         const auto &approximations = env_model->get_ego_approximations();
+        const auto &lanelet_attributes = env_model->get_lanelet_attributes();
 
-        auto cannot_be_true = std::ranges::all_of(approximations->get_covered_lanelets(time_step),
-                                                  [](const auto &lanelet) { return !is_mcw(lanelet); });
+        auto cannot_be_true =
+            (lanelet_attributes.get_types_of_any(approximations->get_covered_lanelets(time_step)) & mcw_bit) == 0;
         if (cannot_be_true) {
             true_false_obstacle_ids[time_step].second.insert(std::nullopt);
             continue;
         }
 
-        auto must_be_true =
-            std::ranges::all_of(approximations->get_intersected_lanelets(time_step), [](const auto &lanelet) {
-                return is_mcw(lanelet) && (is_leftmost(lanelet) || is_neighbour_opposite(lanelet));
+        auto must_be_true = std::ranges::all_of(
+            approximations->get_intersected_lanelets(time_step), [&lanelet_attributes, mcw_bit](const auto &lanelet) {
+                auto attributes = lanelet_attributes.get_attributes(lanelet);
+                return (attributes.types & mcw_bit) != 0 && attributes.has_any_flag(outer_lane_flags);
             });
         if (must_be_true) {
             true_false_obstacle_ids[time_step].first.insert(std::nullopt);
@@ -33,16 +38,3 @@ OnMainCarriagewayLeftLaneExtractor::extract(
     }
     return true_false_obstacle_ids;
 }
-
-bool OnMainCarriagewayLeftLaneExtractor::is_mcw(const std::shared_ptr<Lanelet> &lanelet) {
-    return lanelet->hasLaneletType(LaneletType::mainCarriageWay);
-}
-
-bool OnMainCarriagewayLeftLaneExtractor::is_leftmost(const std::shared_ptr<Lanelet> &lanelet) {
-    return lanelet->getAdjacentLeft().adj == nullptr ||
-           lanelet->getAdjacentLeft().oppositeDir != lanelet->getAdjacentLeft().adj->getAdjacentRight().oppositeDir;
-}
-
-bool OnMainCarriagewayLeftLaneExtractor::is_neighbour_opposite(const std::shared_ptr<Lanelet> &lanelet) {
-    return lanelet->getAdjacentLeft().oppositeDir;
-}
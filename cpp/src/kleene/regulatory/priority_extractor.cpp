@@ -4,20 +4,14 @@
 #include "commonroad_cpp/roadNetwork/intersection/intersection.h"
 #include "commonroad_cpp/roadNetwork/lanelet/lane.h"
 
-#include <ranges>
-
 using namespace knowledge_extraction::kleene::regulatory;
 
-std::unordered_map<time_step_t, PriorityExtractor::TrueFalseObstacleIds> PriorityExtractor::extract(
-    const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> &relevant_obstacle_ids_over_time)
-    const {
+std::unordered_map<time_step_t, PriorityExtractor::TrueFalseObstacleIds>
+PriorityExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
 
     std::unordered_map<time_step_t, TrueFalseObstacleIds> true_false_obstacle_ids;
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
-        auto relevant_obstacles =
-            env_model->get_world()->getObstacles() | std::views::filter([&obstacle_ids](const auto &obstacle) {
-                return obstacle_ids.contains(obstacle->getId());
-            });
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
+        auto relevant_obstacles = env_model->get_obstacles(row);
         const auto &[ego_prio_min, ego_prio_max] =
             env_model->get_ego_approximations()->get_priority_range(time_step, ego_turn);
         for (const auto &obstacle : relevant_obstacles) {
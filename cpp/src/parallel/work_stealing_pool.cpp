@@ -0,0 +1,128 @@
+#include "cr_knowledge_extraction/parallel/work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace knowledge_extraction::parallel;
+
+WorkStealingPool::WorkStealingPool(size_t num_threads) {
+    if (num_threads == 0) {
+        throw std::invalid_argument("A work-stealing pool needs at least one worker");
+    }
+    queues.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    // Worker 0 is the thread calling run()
+    workers.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; ++i) {
+        workers.emplace_back([this, i]() { worker_loop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::scoped_lock lock{state_mutex};
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::run(std::vector<Task> tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    {
+        std::scoped_lock lock{state_mutex};
+        current_tasks = &tasks;
+        current_errors.assign(tasks.size(), nullptr);
+        remaining_tasks = tasks.size();
+        // The queues are filled before the workers are woken up, so no task is added while anyone is stealing
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            auto &queue = *queues[i % queues.size()];
+            std::scoped_lock queue_lock{queue.mutex};
+            queue.task_indices.push_back(i);
+        }
+        ++generation;
+    }
+    work_available.notify_all();
+
+    drain(0);
+
+    std::vector<std::exception_ptr> errors;
+    {
+        std::unique_lock lock{state_mutex};
+        work_done.wait(lock, [this]() { return remaining_tasks == 0; });
+        current_tasks = nullptr;
+        errors = std::move(current_errors);
+    }
+
+    auto first_error = std::ranges::find_if(errors, [](const auto &error) { return error != nullptr; });
+    if (first_error != errors.end()) {
+        std::rethrow_exception(*first_error);
+    }
+}
+
+std::optional<size_t> WorkStealingPool::pop_or_steal(size_t worker) {
+    {
+        // Own tasks are taken from the back ...
+        auto &own = *queues[worker];
+        std::scoped_lock lock{own.mutex};
+        if (!own.task_indices.empty()) {
+            auto index = own.task_indices.back();
+            own.task_indices.pop_back();
+            return index;
+        }
+    }
+    // ... while stolen tasks are taken from the front of the other queues
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        auto &victim = *queues[(worker + offset) % queues.size()];
+        std::scoped_lock lock{victim.mutex};
+        if (!victim.task_indices.empty()) {
+            auto index = victim.task_indices.front();
+            victim.task_indices.pop_front();
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+void WorkStealingPool::drain(size_t worker) {
+    while (auto index = pop_or_steal(worker)) {
+        std::exception_ptr error;
+        try {
+            (*current_tasks)[index.value()]();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        bool all_done;
+        {
+            std::scoped_lock lock{state_mutex};
+            current_errors[index.value()] = error;
+            all_done = --remaining_tasks == 0;
+        }
+        if (all_done) {
+            work_done.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::worker_loop(size_t worker) {
+    size_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock lock{state_mutex};
+            work_available.wait(lock, [this, &seen_generation]() { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+        }
+        drain(worker);
+    }
+}
@@ -8,16 +8,13 @@
 using namespace knowledge_extraction::relationship::implication;
 
 std::unordered_map<time_step_t, std::vector<SafeDistanceImplExtractor::Relationship>>
-SafeDistanceImplExtractor::extract(const std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>>
-                                       &relevant_obstacle_ids_over_time) const {
+SafeDistanceImplExtractor::extract(const env_model::RelevanceMatrix &relevant_obstacles_over_time) const {
     std::unordered_map<time_step_t, std::vector<Relationship>> result;
 
-    for (const auto &[time_step, obstacle_ids] : relevant_obstacle_ids_over_time) {
+    for (const auto &[time_step, row] : relevant_obstacles_over_time) {
+        auto relevant_obstacles = env_model->get_obstacles(row);
         auto relevant_obstacle_stopping_s_ =
-            env_model->get_world()->getObstacles() | std::views::filter([&obstacle_ids](const auto &obstacle) {
-                return obstacle_ids.contains(obstacle->getId());
-            }) |
-            std::views::transform([this, &time_step](const auto &obstacle) {
+            relevant_obstacles | std::views::transform([this, &time_step](const auto &obstacle) {
                 return std::make_pair(obstacle->getId(), env_model->get_stopping_s(time_step, obstacle));
             }) |
             std::views::filter([](const auto &pair) { return pair.second.has_value(); }) |
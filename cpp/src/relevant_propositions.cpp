@@ -0,0 +1,41 @@
+#include "cr_knowledge_extraction/relevant_propositions.hpp"
+
+#include <commonroad_cpp/obstacle/obstacle.h>
+
+#include <unordered_set>
+
+using namespace knowledge_extraction;
+
+namespace {
+// Propositions of predicates that only refer to the ego vehicle
+const std::unordered_set<Proposition> ego_propositions{
+    Proposition::ON_MAIN_CARRIAGEWAY,
+    Proposition::IN_INTERSECTION,
+    Proposition::ON_MAIN_CARRIAGEWAY_RIGHT_LANE,
+    Proposition::ON_MAIN_CARRIAGEWAY_LEFT_LANE,
+    Proposition::RELEVANT_TRAFFIC_LIGHT,
+    Proposition::AT_STOP_SIGN,
+};
+} // namespace
+
+std::unordered_map<time_step_t, std::vector<std::string>>
+knowledge_extraction::make_relevant_propositions(const World &world, const std::vector<Proposition> &propositions,
+                                                 time_step_t initial_time_step, time_step_t horizon) {
+    std::unordered_map<time_step_t, std::vector<std::string>> relevant_propositions;
+    for (time_step_t time_step = 0; time_step < horizon; ++time_step) {
+        auto &time_step_propositions = relevant_propositions[time_step];
+        for (const auto &prop : propositions) {
+            if (ego_propositions.contains(prop)) {
+                time_step_propositions.push_back(proposition::to_string(prop, std::nullopt));
+                continue;
+            }
+            // The extraction interface adds the initial time step to the formula time step
+            for (const auto &obstacle : world.getObstacles()) {
+                if (obstacle->timeStepExists(initial_time_step + time_step)) {
+                    time_step_propositions.push_back(proposition::to_string(prop, obstacle->getId()));
+                }
+            }
+        }
+    }
+    return relevant_propositions;
+}
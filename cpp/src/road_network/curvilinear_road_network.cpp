@@ -1,35 +1,93 @@
 #include "cr_knowledge_extraction/road_network/curvilinear_road_network.hpp"
 
+#include <boost/geometry/algorithms/convex_hull.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
+
+#include <algorithm>
+#include <ranges>
+
 using namespace knowledge_extraction::road_network;
 
 knowledge_extraction::road_network::CurvilinearRoadNetwork::CurvilinearRoadNetwork(
     const std::shared_ptr<RoadNetwork> &road_network,
     const std::shared_ptr<geometry::CurvilinearCoordinateSystem> &ego_ccs)
-    : road_network(road_network), ego_ccs(ego_ccs) {}
+    : road_network(road_network), ego_ccs(ego_ccs) {
+    std::vector<rtree_value_type> tree_values;
+    curvilinear_lanelets.reserve(road_network->getLaneletNetwork().size());
+    for (const auto &lanelet : road_network->getLaneletNetwork()) {
+        auto polygon = project_lanelet(*lanelet);
+        if (!polygon.has_value()) {
+            unprojectable_lanelets.push_back(lanelet);
+            continue;
+        }
+        tree_values.emplace_back(boost::geometry::return_envelope<box_type>(polygon.value()),
+                                 curvilinear_lanelets.size());
+        curvilinear_lanelets.emplace_back(CurvilinearLanelet{lanelet, std::move(polygon.value())});
+    }
+    // Bulk loading results in a better tree than inserting one by one
+    lanelet_tree = decltype(lanelet_tree){tree_values};
+}
+
+std::optional<polygon_type>
+knowledge_extraction::road_network::CurvilinearRoadNetwork::project_lanelet(const Lanelet &lanelet) const {
+    const auto &left_border = lanelet.getLeftBorderVertices();
+    const auto &right_border = lanelet.getRightBorderVertices();
+
+    polygon_type polygon;
+    auto &outer = polygon.outer();
+    outer.reserve(left_border.size() + right_border.size() + 1);
+    try {
+        for (const auto &vertex : left_border) {
+            auto ccs_pos = ego_ccs->convertToCurvilinearCoords(vertex.x, vertex.y);
+            outer.emplace_back(ccs_pos.x(), ccs_pos.y());
+        }
+        for (const auto &vertex : std::ranges::reverse_view(right_border)) {
+            auto ccs_pos = ego_ccs->convertToCurvilinearCoords(vertex.x, vertex.y);
+            outer.emplace_back(ccs_pos.x(), ccs_pos.y());
+        }
+    } catch (const geometry::CurvilinearProjectionDomainError &e) {
+        return std::nullopt;
+    }
+    if (outer.size() < 3) {
+        return std::nullopt;
+    }
+    boost::geometry::correct(polygon);
+
+    // Strongly curved reference paths may fold the projected border onto itself, intersection tests are not reliable
+    // for such polygons, so we fall back to the convex hull which contains all projected vertices
+    if (!boost::geometry::is_valid(polygon)) {
+        polygon_type hull;
+        boost::geometry::convex_hull(polygon, hull);
+        return hull;
+    }
+    return polygon;
+}
 
 std::vector<std::shared_ptr<Lanelet>>
 knowledge_extraction::road_network::CurvilinearRoadNetwork::get_overlapping_lanelets(
     const knowledge_extraction::ego_behavior::sets::Box2D &ccs_bounding_box) const {
     auto [min, max] = ccs_bounding_box.bounds();
+    auto query_box = box_type{{min(0) - query_margin, min(1) - query_margin},
+                              {max(0) + query_margin, max(1) + query_margin}};
 
-    try {
-        // Convert the bounding box back to the Cartesian coordinate system
-        [[maybe_unused]] std::vector<geometry::EigenPolyline> _triangle_mesh;
-        auto cart_polygon = ego_ccs->convertRectangleToCartesianCoords(min(0), max(0), min(1), max(1), _triangle_mesh);
-
-        // Convert the drivability checker polygon into a boost::geometry polygon
-        polygon_type bg_polygon;
-        bg_polygon.outer().reserve(cart_polygon.size());
-        for (const auto &point : cart_polygon) {
-            bg_polygon.outer().emplace_back(point.x(), point.y());
-        }
+    std::vector<size_t> indices;
+    lanelet_tree.query(boost::geometry::index::intersects(query_box),
+                       boost::make_function_output_iterator([this, &query_box, &indices](const auto &value) {
+                           // The tree only compares bounding boxes, so refine using the actual polygon
+                           if (boost::geometry::intersects(query_box,
+                                                           curvilinear_lanelets[value.second].curvilinear_polygon)) {
+                               indices.push_back(value.second);
+                           }
+                       }));
+    // Return the lanelets in the order of the lanelet network independent of the tree layout
+    std::ranges::sort(indices);
 
-        // Query the Cartesian road network using the polygon
-        multi_polygon_type bg_multi_polygon;
-        bg_multi_polygon.push_back(bg_polygon);
-        return road_network->findOccupiedLaneletsByShape(bg_multi_polygon);
-    } catch (const geometry::CurvilinearProjectionDomainError &e) {
-        // If we cannot convert from the CCS, be conservative and return all lanelets
-        return road_network->getLaneletNetwork();
+    std::vector<std::shared_ptr<Lanelet>> lanelets;
+    lanelets.reserve(indices.size() + unprojectable_lanelets.size());
+    for (auto index : indices) {
+        lanelets.push_back(curvilinear_lanelets[index].lanelet);
     }
+    // If we cannot project a lanelet into the CCS, be conservative and consider it as overlapping
+    std::ranges::copy(unprojectable_lanelets, std::back_inserter(lanelets));
+    return lanelets;
 }
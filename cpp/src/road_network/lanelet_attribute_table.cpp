@@ -0,0 +1,171 @@
+#include "cr_knowledge_extraction/road_network/lanelet_attribute_table.hpp"
+
+#include <commonroad_cpp/roadNetwork/intersection/incoming_group.h>
+#include <commonroad_cpp/roadNetwork/lanelet/lane.h>
+#include <commonroad_cpp/roadNetwork/lanelet/lane_operations.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace knowledge_extraction::road_network;
+
+namespace {
+// In the order of the direction indices of the priority table
+constexpr std::array<Direction, 3> priority_directions{Direction::left, Direction::straight, Direction::right};
+} // namespace
+
+uint64_t LaneletAttributes::type_bit(LaneletType type) {
+    auto bit = static_cast<size_t>(type);
+    if (bit >= std::numeric_limits<uint64_t>::digits) {
+        throw std::logic_error("Lanelet type " + std::to_string(bit) + " does not fit into the type mask");
+    }
+    return uint64_t{1} << bit;
+}
+
+LaneletAttributeTable::LaneletAttributeTable(const std::shared_ptr<RoadNetwork> &road_network) {
+    const auto &lanelets = road_network->getLaneletNetwork();
+    std::vector<size_t> lanelet_ids;
+    lanelet_ids.reserve(lanelets.size());
+    attributes.reserve(lanelets.size());
+    incoming_group_ids.reserve(lanelets.size());
+    left_of_incoming_group_ids.reserve(lanelets.size());
+    priorities.reserve(lanelets.size() * num_priority_directions);
+    lane_lanelet_offsets.reserve(lanelets.size() + 1);
+    for (const auto &lanelet : lanelets) {
+        lanelet_ids.push_back(lanelet->getId());
+        attributes.push_back(compute_attributes(*lanelet));
+
+        auto incoming_group_id = no_incoming_group;
+        auto left_of_incoming_group_id = no_incoming_group;
+        if (attributes.back().has_type(LaneletType::incoming)) {
+            auto incoming_group = road_network->findIncomingGroupByLanelet(lanelet);
+            if (!incoming_group) {
+                spdlog::warn("Incoming lanelet {} does not belong to an incoming group", lanelet->getId());
+            } else if (!incoming_group->getIsLeftOf()) {
+                incoming_group_id = incoming_group->getId();
+                spdlog::warn("Incoming group {} is not left of another incoming group", incoming_group_id);
+            } else {
+                incoming_group_id = incoming_group->getId();
+                left_of_incoming_group_id = incoming_group->getIsLeftOf()->getId();
+            }
+        }
+        incoming_group_ids.push_back(incoming_group_id);
+        left_of_incoming_group_ids.push_back(left_of_incoming_group_id);
+
+        for (auto dir : priority_directions) {
+            priorities.push_back(regulatory_elements_utils::extractPriorityTrafficSign({lanelet}, dir));
+        }
+
+        auto first = lane_lanelet_ids.size();
+        for (const auto &lane : lane_operations::createLanesBySingleLanelets({lanelet}, road_network)) {
+            auto ids = lane->getContainedLaneletIDs();
+            lane_lanelet_ids.insert(lane_lanelet_ids.end(), ids.begin(), ids.end());
+        }
+        auto lanelet_lane_ids = std::ranges::subrange(lane_lanelet_ids.begin() + static_cast<std::ptrdiff_t>(first),
+                                                      lane_lanelet_ids.end());
+        std::ranges::sort(lanelet_lane_ids);
+        lane_lanelet_ids.erase(std::ranges::unique(lanelet_lane_ids).begin(), lane_lanelet_ids.end());
+        lane_lanelet_offsets.push_back(lane_lanelet_ids.size());
+    }
+    lanelet_index = IdIndex{lanelet_ids};
+}
+
+std::optional<size_t> LaneletAttributeTable::get_priority_direction_index(Direction dir) {
+    auto it = std::ranges::find(priority_directions, dir);
+    if (it == priority_directions.end()) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(it - priority_directions.begin());
+}
+
+LaneletAttributes LaneletAttributeTable::compute_attributes(const Lanelet &lanelet) {
+    LaneletAttributes result;
+    for (auto type : lanelet.getLaneletTypes()) {
+        result.types |= LaneletAttributes::type_bit(type);
+    }
+
+    const auto &left = lanelet.getAdjacentLeft();
+    if (left.adj == nullptr || left.oppositeDir != left.adj->getAdjacentRight().oppositeDir) {
+        result.flags |= LaneletAttributes::leftmost;
+    }
+    if (left.oppositeDir) {
+        result.flags |= LaneletAttributes::left_neighbour_opposite;
+    }
+    const auto &right = lanelet.getAdjacentRight();
+    if (right.adj == nullptr || right.oppositeDir != right.adj->getAdjacentLeft().oppositeDir) {
+        result.flags |= LaneletAttributes::rightmost;
+    }
+    if (right.oppositeDir) {
+        result.flags |= LaneletAttributes::right_neighbour_opposite;
+    }
+    return result;
+}
+
+LaneletAttributes LaneletAttributeTable::get_attributes(const std::shared_ptr<Lanelet> &lanelet) const {
+    auto index = lanelet_index.find(lanelet->getId());
+    return index.has_value() ? attributes[index.value()] : compute_attributes(*lanelet);
+}
+
+uint64_t LaneletAttributeTable::get_types_of_any(const std::vector<std::shared_ptr<Lanelet>> &lanelets) const {
+    uint64_t types = 0;
+    for (const auto &lanelet : lanelets) {
+        types |= get_attributes(lanelet).types;
+    }
+    return types;
+}
+
+uint64_t LaneletAttributeTable::get_types_of_all(const std::vector<std::shared_ptr<Lanelet>> &lanelets) const {
+    auto types = std::numeric_limits<uint64_t>::max();
+    for (const auto &lanelet : lanelets) {
+        types &= get_attributes(lanelet).types;
+    }
+    return types;
+}
+
+LaneletSet LaneletAttributeTable::make_lanelet_set(const std::vector<std::shared_ptr<Lanelet>> &lanelets) const {
+    LaneletSet lanelet_set{size()};
+    for (const auto &lanelet : lanelets) {
+        auto index = lanelet_index.find(lanelet->getId());
+        if (index.has_value()) {
+            lanelet_set.insert(index.value());
+        }
+    }
+    return lanelet_set;
+}
+
+int LaneletAttributeTable::get_priority(const std::shared_ptr<Lanelet> &lanelet, Direction dir) const {
+    auto index = lanelet_index.find(lanelet->getId());
+    auto direction_index = get_priority_direction_index(dir);
+    if (!index.has_value() || !direction_index.has_value()) {
+        return regulatory_elements_utils::extractPriorityTrafficSign({lanelet}, dir);
+    }
+    return priorities[(index.value() * num_priority_directions) + direction_index.value()];
+}
+
+std::pair<int, int> LaneletAttributeTable::get_priority_range(const std::vector<std::shared_ptr<Lanelet>> &lanelets,
+                                                              Direction dir) const {
+    if (lanelets.empty()) {
+        throw std::invalid_argument("Priority range of no lanelets");
+    }
+    auto min = std::numeric_limits<int>::max();
+    auto max = std::numeric_limits<int>::min();
+    for (const auto &lanelet : lanelets) {
+        auto priority = get_priority(lanelet, dir);
+        min = std::min(min, priority);
+        max = std::max(max, priority);
+    }
+    return {min, max};
+}
+
+std::optional<size_t> LaneletAttributeTable::get_incoming_group_value(const std::vector<size_t> &group_ids,
+                                                                      size_t lanelet_id) const {
+    auto index = lanelet_index.find(lanelet_id);
+    if (!index.has_value() || group_ids[index.value()] == no_incoming_group) {
+        return std::nullopt;
+    }
+    return group_ids[index.value()];
+}
@@ -0,0 +1,64 @@
+#include "cr_knowledge_extraction/statistics.hpp"
+
+using namespace knowledge_extraction;
+
+namespace {
+double to_seconds(uint64_t nanoseconds) { return static_cast<double>(nanoseconds) * 1e-9; }
+} // namespace
+
+void StatisticsCollector::reset() {
+    for (auto &counters : extractor_counters) {
+        counters.num_calls.store(0, std::memory_order_relaxed);
+        counters.creation_ns.store(0, std::memory_order_relaxed);
+        counters.extraction_ns.store(0, std::memory_order_relaxed);
+        counters.num_decided.store(0, std::memory_order_relaxed);
+    }
+    for (auto &counters : cache_counters) {
+        counters.hits.store(0, std::memory_order_relaxed);
+        counters.misses.store(0, std::memory_order_relaxed);
+    }
+    for (auto &counters : phase_counters) {
+        counters.num_runs.store(0, std::memory_order_relaxed);
+        counters.wall_ns.store(0, std::memory_order_relaxed);
+        counters.num_decided.store(0, std::memory_order_relaxed);
+    }
+    num_overlapping_lanelet_queries.store(0, std::memory_order_relaxed);
+    num_lane_constructions.store(0, std::memory_order_relaxed);
+}
+
+ExtractionStatistics StatisticsCollector::get_statistics() const {
+    ExtractionStatistics statistics;
+    for (size_t kind = 0; kind < num_extractor_kinds; ++kind) {
+        for (size_t prop = 0; prop < num_propositions; ++prop) {
+            const auto &counters = extractor_counters[(kind * num_propositions) + prop];
+            auto num_calls = counters.num_calls.load(std::memory_order_relaxed);
+            auto creation_ns = counters.creation_ns.load(std::memory_order_relaxed);
+            // Extractors are created once and reused, so an extractor may have been created in an earlier call
+            if (num_calls == 0 && creation_ns == 0) {
+                continue;
+            }
+            statistics.extractors.push_back({static_cast<ExtractorKind>(kind), static_cast<Proposition>(prop),
+                                             num_calls, to_seconds(creation_ns),
+                                             to_seconds(counters.extraction_ns.load(std::memory_order_relaxed)),
+                                             counters.num_decided.load(std::memory_order_relaxed)});
+        }
+    }
+    for (size_t cache = 0; cache < num_caches; ++cache) {
+        const auto &counters = cache_counters[cache];
+        statistics.caches.push_back({static_cast<CacheKind>(cache), counters.hits.load(std::memory_order_relaxed),
+                                     counters.misses.load(std::memory_order_relaxed)});
+    }
+    for (size_t phase = 0; phase < num_phases; ++phase) {
+        const auto &counters = phase_counters[phase];
+        auto num_runs = counters.num_runs.load(std::memory_order_relaxed);
+        if (num_runs == 0) {
+            continue;
+        }
+        statistics.phases.push_back({static_cast<ExtractionPhase>(phase), num_runs,
+                                     to_seconds(counters.wall_ns.load(std::memory_order_relaxed)),
+                                     counters.num_decided.load(std::memory_order_relaxed)});
+    }
+    statistics.num_overlapping_lanelet_queries = num_overlapping_lanelet_queries.load(std::memory_order_relaxed);
+    statistics.num_lane_constructions = num_lane_constructions.load(std::memory_order_relaxed);
+    return statistics;
+}
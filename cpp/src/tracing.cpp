@@ -0,0 +1,152 @@
+#include "cr_knowledge_extraction/tracing.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace knowledge_extraction::tracing;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    const char *name;
+    const char *detail;
+    Clock::time_point start;
+    Clock::time_point end;
+};
+
+// Each thread appends to its own buffer, the lock is only contended while the trace is written
+struct ThreadBuffer {
+    std::mutex mutex;
+    size_t thread_index{0};
+    std::vector<Event> events;
+};
+
+struct Recorder {
+    std::atomic<bool> active{false};
+    Clock::time_point origin;
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+Recorder &get_recorder() {
+    static Recorder recorder;
+    return recorder;
+}
+
+ThreadBuffer &get_thread_buffer() {
+    thread_local auto buffer = []() {
+        auto &recorder = get_recorder();
+        std::scoped_lock lock{recorder.mutex};
+        auto new_buffer = std::make_shared<ThreadBuffer>();
+        new_buffer->thread_index = recorder.buffers.size();
+        recorder.buffers.push_back(new_buffer);
+        return new_buffer;
+    }();
+    return *buffer;
+}
+
+void write_escaped(std::ostream &out, const char *str) {
+    out << '"';
+    for (const char *c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+double to_microseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>{duration}.count();
+}
+} // namespace
+
+bool knowledge_extraction::tracing::is_active() {
+    if constexpr (!is_available()) {
+        return false;
+    }
+    return get_recorder().active.load(std::memory_order_acquire);
+}
+
+void knowledge_extraction::tracing::start() {
+    if constexpr (!is_available()) {
+        spdlog::warn("Tracing is not available, build with CR_KNOWLEDGE_EXTRACTION_TRACING to record traces!");
+        return;
+    }
+    auto &recorder = get_recorder();
+    std::scoped_lock lock{recorder.mutex};
+    for (const auto &buffer : recorder.buffers) {
+        std::scoped_lock buffer_lock{buffer->mutex};
+        buffer->events.clear();
+    }
+    recorder.origin = Clock::now();
+    recorder.active.store(true, std::memory_order_release);
+}
+
+void knowledge_extraction::tracing::stop(const std::string &path) {
+    if constexpr (!is_available()) {
+        return;
+    }
+    auto &recorder = get_recorder();
+    recorder.active.store(false, std::memory_order_release);
+
+    std::ofstream out{path};
+    if (!out) {
+        throw std::runtime_error("Cannot write trace to " + path);
+    }
+    out << R"({"displayTimeUnit":"ms","traceEvents":[)";
+    auto first = true;
+    std::scoped_lock lock{recorder.mutex};
+    for (const auto &buffer : recorder.buffers) {
+        std::scoped_lock buffer_lock{buffer->mutex};
+        if (buffer->events.empty()) {
+            continue;
+        }
+        out << (first ? "" : ",") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->thread_index
+            << R"(,"args":{"name":"thread )" << buffer->thread_index << R"("}})";
+        first = false;
+        for (const auto &event : buffer->events) {
+            out << R"(,{"name":)";
+            write_escaped(out, event.name);
+            out << R"(,"cat":"extraction","ph":"X","pid":1,"tid":)" << buffer->thread_index
+                << R"(,"ts":)" << to_microseconds(event.start - recorder.origin)
+                << R"(,"dur":)" << to_microseconds(event.end - event.start);
+            if (event.detail != nullptr) {
+                out << R"(,"args":{"detail":)";
+                write_escaped(out, event.detail);
+                out << '}';
+            }
+            out << '}';
+        }
+        buffer->events.clear();
+    }
+    out << "]}\n";
+    if (!out) {
+        throw std::runtime_error("Cannot write trace to " + path);
+    }
+}
+
+Zone::Zone(const char *name, const char *detail) : name(name), detail(detail) {
+    if (is_active()) {
+        start = Clock::now();
+    }
+}
+
+Zone::~Zone() {
+    // Zones that were opened before tracing started are dropped, as they have no start time
+    if (start == Clock::time_point{} || !is_active()) {
+        return;
+    }
+    auto end = Clock::now();
+    auto &buffer = get_thread_buffer();
+    std::scoped_lock lock{buffer.mutex};
+    buffer.events.push_back({name, detail, start, end});
+}
@@ -0,0 +1,91 @@
+#include "test_behavior_overapproximation.hpp"
+
+using knowledge_extraction::ego_behavior::BehaviorOverapproximation;
+using knowledge_extraction::ego_behavior::EgoParameters;
+using knowledge_extraction::ego_behavior::sets::Box2D;
+using knowledge_extraction::ego_behavior::sets::Box4D;
+using knowledge_extraction::parallel::WorkStealingPool;
+
+TEST_F(BehaviorOverapproximationTest, MatchesBoxPropagation) {
+    const auto &approximations = test_envs.interstate_simple->get_ego_approximations();
+    auto dt = test_envs.interstate_simple->get_world()->getDt();
+    auto ego_params = EgoParameters{};
+
+    // Reference: propagate the state box through the double integrator step by step
+    auto system_matrix = Eigen::Matrix4d{
+        {1, dt, 0, 0},
+        {0, 1, 0, 0},
+        {0, 0, 1, dt},
+        {0, 0, 0, 1},
+    };
+    auto half_dt_square = (dt * dt) / 2;
+    auto input_matrix = Eigen::Matrix<double, 4, 2>{
+        {half_dt_square, 0},
+        {dt, 0},
+        {0, half_dt_square},
+        {0, dt},
+    };
+    auto input_state_update = Box2D::from_bounds(Eigen::Vector2d{ego_params.a_lon_min, ego_params.a_lat_min},
+                                                 Eigen::Vector2d{ego_params.a_lon_max, ego_params.a_lat_max})
+                                  .linear_map_positive(input_matrix);
+    constexpr double big_m = 10e9;
+    auto admissible_states =
+        Box4D::from_bounds(Eigen::Vector4d{-big_m, ego_params.v_lon_min, -big_m, ego_params.v_lat_min},
+                           Eigen::Vector4d{big_m, ego_params.v_lon_max, big_m, ego_params.v_lat_max});
+
+    approximations->precompute(100);
+    std::vector<Box4D> expected{approximations->get_center_approximation(0)};
+    for (time_step_t time_step = 1; time_step <= 100; ++time_step) {
+        expected.emplace_back(
+            expected.back().linear_map_positive(system_matrix).sum(input_state_update).intersect(admissible_states));
+        auto [min, max] = expected.back().bounds();
+
+        EXPECT_NEAR(approximations->p_lon_min(time_step), min(0), 1e-9);
+        EXPECT_NEAR(approximations->p_lon_max(time_step), max(0), 1e-9);
+        EXPECT_NEAR(approximations->v_lon_min(time_step), min(1), 1e-9);
+        EXPECT_NEAR(approximations->v_lon_max(time_step), max(1), 1e-9);
+        EXPECT_NEAR(approximations->p_lat_min(time_step), min(2), 1e-9);
+        EXPECT_NEAR(approximations->p_lat_max(time_step), max(2), 1e-9);
+        EXPECT_NEAR(approximations->v_lat_min(time_step), min(3), 1e-9);
+        EXPECT_NEAR(approximations->v_lat_max(time_step), max(3), 1e-9);
+        EXPECT_LE(approximations->v_min(time_step), approximations->v_max(time_step));
+    }
+    // The velocity bounds saturate at the admissible states
+    EXPECT_DOUBLE_EQ(approximations->v_lon_min(100), ego_params.v_lon_min);
+    EXPECT_DOUBLE_EQ(approximations->v_lat_max(100), ego_params.v_lat_max);
+}
+
+TEST_F(BehaviorOverapproximationTest, ExtendsPrecomputedHorizonOnDemand) {
+    const auto &approximations = test_envs.interstate_simple->get_ego_approximations();
+    EXPECT_EQ(approximations->get_precomputed_horizon(), 0);
+
+    approximations->precompute(10);
+    EXPECT_EQ(approximations->get_precomputed_horizon(), 10);
+
+    // Crosses the boundary of the first table segment
+    auto p_lon_max = approximations->p_lon_max(300);
+    EXPECT_EQ(approximations->get_precomputed_horizon(), 300);
+    EXPECT_GT(p_lon_max, approximations->p_lon_max(299));
+
+    approximations->precompute(5);
+    EXPECT_EQ(approximations->get_precomputed_horizon(), 300);
+}
+
+TEST_F(BehaviorOverapproximationTest, PrecomputesBatchOnPool) {
+    const auto &first = test_envs.interstate_simple->get_ego_approximations();
+    const auto &second = test_envs.two_lanes->get_ego_approximations();
+    std::vector<BehaviorOverapproximation *> approximations{first.get(), second.get(), first.get()};
+    WorkStealingPool pool{2};
+    BehaviorOverapproximation::precompute_batch(approximations, 50, &pool);
+    EXPECT_EQ(first->get_precomputed_horizon(), 50);
+    EXPECT_EQ(second->get_precomputed_horizon(), 50);
+
+    auto reference = TestEnvironments::setup_interstate_simple()->get_ego_approximations();
+    reference->precompute(50);
+    for (time_step_t time_step = 0; time_step <= 50; ++time_step) {
+        EXPECT_EQ(first->p_lon_max(time_step), reference->p_lon_max(time_step));
+        EXPECT_EQ(first->v_lat_min(time_step), reference->v_lat_min(time_step));
+        EXPECT_EQ(second->p_lon_max(time_step), reference->p_lon_max(time_step));
+        EXPECT_EQ(second->v_lat_min(time_step), reference->v_lat_min(time_step));
+    }
+}
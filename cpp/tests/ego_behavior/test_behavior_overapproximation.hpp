@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../test_envs/test_envs.hpp"
+
+#include <gtest/gtest.h>
+
+class BehaviorOverapproximationTest : public testing::Test {
+  protected:
+    TestEnvironments test_envs;
+};
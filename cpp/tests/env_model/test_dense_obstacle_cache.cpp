@@ -0,0 +1,112 @@
+#include "test_dense_obstacle_cache.hpp"
+
+#include <stdexcept>
+
+using namespace knowledge_extraction::env_model;
+
+TEST_F(DenseObstacleCacheTest, IndexMapsToUniqueSlots) {
+    EXPECT_EQ(index->get_num_slots(), 60);
+    EXPECT_EQ(index->get_obstacle_index(100), 0);
+    EXPECT_EQ(index->get_obstacle_index(105), 1);
+    EXPECT_EQ(index->get_obstacle_index(42), 2);
+
+    EXPECT_EQ(index->get_slot(10, 100), 0);
+    EXPECT_EQ(index->get_slot(29, 100), 19);
+    EXPECT_EQ(index->get_slot(10, 105), 20);
+    EXPECT_EQ(index->get_slot(15, 42), 45);
+
+    EXPECT_FALSE(index->get_slot(9, 100).has_value());
+    EXPECT_FALSE(index->get_slot(30, 100).has_value());
+    EXPECT_FALSE(index->get_slot(10, 101).has_value());
+    EXPECT_FALSE(index->get_slot(10, 0).has_value());
+}
+
+TEST_F(DenseObstacleCacheTest, SparseIdsUseBinarySearch) {
+    auto sparse_index = ObstacleTimeIndex{{3, size_t{1} << 40, 17}, 0, 1};
+    EXPECT_EQ(sparse_index.get_obstacle_index(size_t{1} << 40), 1);
+    EXPECT_EQ(sparse_index.get_obstacle_index(17), 2);
+    EXPECT_FALSE(sparse_index.get_obstacle_index(4).has_value());
+}
+
+TEST_F(DenseObstacleCacheTest, RejectsDuplicateIds) {
+    EXPECT_THROW((ObstacleTimeIndex{{1, 2, 1}, 0, 1}), std::invalid_argument);
+}
+
+TEST_F(DenseObstacleCacheTest, ComputesCachedValuesOnce) {
+    auto cache = DenseObstacleCache<std::optional<double>, 3>{index};
+    int computations = 0;
+    auto compute = [&computations]() {
+        ++computations;
+        return std::optional<double>{1.5};
+    };
+
+    EXPECT_EQ(cache.get_or_compute(12, 105, 2, compute), 1.5);
+    EXPECT_EQ(cache.get_or_compute(12, 105, 2, compute), 1.5);
+    EXPECT_EQ(computations, 1);
+
+    // Other values within the same slot are independent
+    EXPECT_EQ(cache.get_or_compute(12, 105, 1, []() { return std::optional<double>{}; }), std::nullopt);
+    EXPECT_EQ(cache.get_or_compute(12, 105, 2, compute), 1.5);
+    EXPECT_EQ(computations, 1);
+}
+
+TEST_F(DenseObstacleCacheTest, ComputesUnknownKeysWithoutCaching) {
+    auto cache = DenseObstacleCache<int>{index};
+    int computations = 0;
+    auto compute = [&computations]() { return ++computations; };
+
+    EXPECT_EQ(cache.get_or_compute(50, 100, compute), 1);
+    EXPECT_EQ(cache.get_or_compute(50, 100, compute), 2);
+    EXPECT_EQ(cache.get_or_compute(10, 7, compute), 3);
+}
+
+TEST_F(DenseObstacleCacheTest, RetriesAfterError) {
+    auto cache = DenseObstacleCache<int>{index};
+    EXPECT_THROW(cache.get_or_compute(10, 42, []() -> int { throw std::runtime_error{"failed"}; }), std::runtime_error);
+    EXPECT_EQ(cache.get_or_compute(10, 42, []() { return 3; }), 3);
+}
+
+TEST_F(DenseObstacleCacheTest, RestoresVisitedValuesInOtherCache) {
+    auto cache = DenseObstacleCache<int, 2>{index};
+    cache.get_or_compute(11, 105, 1, []() { return 4; });
+    cache.get_or_compute(10, 100, 0, []() { return 7; });
+
+    std::vector<std::pair<size_t, int>> visited;
+    cache.for_each_value([&visited](size_t position, int value) { visited.emplace_back(position, value); });
+    ASSERT_EQ(visited.size(), 2);
+    EXPECT_EQ(visited[0].second, 7);
+    EXPECT_EQ(visited[1].second, 4);
+
+    auto restored = DenseObstacleCache<int, 2>{index};
+    EXPECT_TRUE(restored.restore(visited[1].first, visited[1].second));
+    // Cached values are kept and positions outside of the index are rejected
+    EXPECT_FALSE(restored.restore(visited[1].first, 5));
+    EXPECT_FALSE(restored.restore(restored.get_num_values(), 5));
+    EXPECT_EQ(restored.get_or_compute(11, 105, 1, []() -> int { throw std::runtime_error{"not restored"}; }), 4);
+}
+
+TEST_F(DenseObstacleCacheTest, AllocatesObstaclesOnFirstInsertion) {
+    auto cache = DenseObstacleCache<int, 3>{index};
+    EXPECT_EQ(cache.get_num_values(), 180);
+    EXPECT_EQ(cache.get_or_compute(50, 100, []() { return 1; }), 1);
+    EXPECT_FALSE(cache.restore(cache.get_num_values(), 2));
+    size_t visited = 0;
+    cache.for_each_value([&visited](size_t, int) { ++visited; });
+    EXPECT_EQ(visited, 0);
+    EXPECT_EQ(cache.get_num_allocated_columns(), 0);
+
+    // Only the values of the obstacles with an inserted value are allocated
+    EXPECT_EQ(cache.get_or_compute(10, 42, 2, []() { return 3; }), 3);
+    EXPECT_EQ(cache.get_or_compute(29, 42, 0, []() { return 4; }), 4);
+    EXPECT_EQ(cache.get_num_allocated_columns(), 1);
+    EXPECT_EQ(cache.get_or_compute(10, 42, 2, []() -> int { throw std::runtime_error{"not cached"}; }), 3);
+    EXPECT_EQ(cache.get_num_allocated_columns(), 1);
+    EXPECT_TRUE(cache.restore(cache.get_position(15, 105).value(), 5));
+    EXPECT_EQ(cache.get_num_allocated_columns(), 2);
+
+    std::vector<std::pair<size_t, int>> values;
+    cache.for_each_value([&values](size_t position, int value) { values.emplace_back(position, value); });
+    EXPECT_EQ(values, (std::vector<std::pair<size_t, int>>{{cache.get_position(15, 105).value(), 5},
+                                                           {cache.get_position(10, 42, 2).value(), 3},
+                                                           {cache.get_position(29, 42, 0).value(), 4}}));
+}
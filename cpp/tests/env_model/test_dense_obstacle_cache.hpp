@@ -0,0 +1,12 @@
+#pragma once
+
+#include "cr_knowledge_extraction/env_model/dense_obstacle_cache.hpp"
+
+#include <gtest/gtest.h>
+
+class DenseObstacleCacheTest : public testing::Test {
+  protected:
+    std::shared_ptr<const knowledge_extraction::env_model::ObstacleTimeIndex> index =
+        std::make_shared<const knowledge_extraction::env_model::ObstacleTimeIndex>(std::vector<size_t>{100, 105, 42},
+                                                                                  10, 20);
+};
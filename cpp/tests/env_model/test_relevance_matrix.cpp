@@ -0,0 +1,74 @@
+#include "test_relevance_matrix.hpp"
+
+using namespace knowledge_extraction::env_model;
+
+TEST_F(RelevanceMatrixTest, IteratesNonEmptyTimeStepsInOrder) {
+    // Time steps need not be within the horizon of the index, unknown obstacles are skipped
+    auto matrix = RelevanceMatrix{index, {{5, {100, std::nullopt}}, {3, {42, 999}}, {4, {999}}, {70, {105}}}};
+
+    std::vector<time_step_t> time_steps;
+    std::vector<std::vector<size_t>> obstacle_indices;
+    std::vector<bool> ego;
+    for (const auto &[time_step, row] : matrix) {
+        time_steps.push_back(time_step);
+        obstacle_indices.push_back(row.get_obstacle_indices());
+        ego.push_back(row.contains_ego());
+    }
+    EXPECT_EQ(time_steps, (std::vector<time_step_t>{3, 5, 70}));
+    EXPECT_EQ(obstacle_indices, (std::vector<std::vector<size_t>>{{2}, {0}, {1}}));
+    EXPECT_EQ(ego, (std::vector<bool>{false, true, false}));
+
+    EXPECT_EQ(matrix.count_time_steps(), 3);
+    EXPECT_EQ(matrix.get_last_time_step(), 70);
+    EXPECT_EQ(matrix.get_obstacle_indices(), (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ((*matrix.begin()).second.size(), 1);
+}
+
+TEST_F(RelevanceMatrixTest, InsertsAndErases) {
+    auto matrix = RelevanceMatrix{index};
+    EXPECT_TRUE(matrix.empty());
+    EXPECT_FALSE(matrix.get_last_time_step().has_value());
+
+    EXPECT_TRUE(matrix.insert(12, 105));
+    EXPECT_TRUE(matrix.insert(8, std::nullopt));
+    EXPECT_FALSE(matrix.insert(8, 7));
+    EXPECT_TRUE(matrix.contains(12, 105));
+    EXPECT_TRUE(matrix.contains(8, std::nullopt));
+    EXPECT_FALSE(matrix.contains(12, std::nullopt));
+    EXPECT_FALSE(matrix.contains(8, 7));
+    EXPECT_FALSE(matrix.contains(100, 105));
+
+    matrix.erase(12, 105);
+    EXPECT_EQ(matrix.count_time_steps(), 1);
+    matrix.erase(8, std::nullopt);
+    EXPECT_TRUE(matrix.empty());
+}
+
+TEST_F(RelevanceMatrixTest, MovesTimeSteps) {
+    auto matrix = RelevanceMatrix{index, {{2, {100}}, {4, {std::nullopt}}}};
+    matrix.move_time_steps(2, 7);
+    EXPECT_TRUE(matrix.contains(7, 100));
+    EXPECT_TRUE(matrix.contains(9, std::nullopt));
+    EXPECT_FALSE(matrix.contains(2, 100));
+}
+
+TEST_F(RelevanceMatrixTest, SplitsIntoChunks) {
+    auto matrix = RelevanceMatrix{index, {{0, {100}}, {1, {105}}, {5, {42}}, {6, {std::nullopt}}, {9, {100}}}};
+
+    auto chunks = matrix.split(2);
+    ASSERT_EQ(chunks.size(), 3);
+    EXPECT_EQ(chunks[0].count_time_steps(), 2);
+    EXPECT_TRUE(chunks[0].contains(1, 105));
+    EXPECT_EQ(chunks[1].count_time_steps(), 2);
+    EXPECT_TRUE(chunks[1].contains(5, 42));
+    EXPECT_TRUE(chunks[1].contains(6, std::nullopt));
+    EXPECT_FALSE(chunks[1].contains(9, 100));
+    EXPECT_EQ(chunks[2].count_time_steps(), 1);
+    EXPECT_EQ(chunks[2].get_last_time_step(), 9);
+
+    auto slice = matrix.slice(5, 6);
+    EXPECT_EQ(slice.count_time_steps(), 1);
+    EXPECT_TRUE(slice.contains(5, 42));
+    EXPECT_TRUE(matrix.slice(2, 5).empty());
+    EXPECT_TRUE(RelevanceMatrix{index}.split(8).empty());
+}
@@ -0,0 +1,242 @@
+#include "test_world_cache.hpp"
+
+#include "cr_knowledge_extraction/env_model/cache_file.hpp"
+
+#include <commonroad_cpp/obstacle/obstacle.h>
+#include <commonroad_cpp/roadNetwork/lanelet/lane.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <span>
+
+using knowledge_extraction::CacheKind;
+using knowledge_extraction::env_model::RelevanceMatrix;
+using knowledge_extraction::env_model::SharedWorldCache;
+using knowledge_extraction::env_model::WorldCache;
+
+namespace {
+std::vector<size_t> get_ids(const std::vector<std::shared_ptr<Obstacle>> &obstacles) {
+    std::vector<size_t> ids;
+    std::ranges::transform(obstacles, std::back_inserter(ids), [](const auto &obstacle) { return obstacle->getId(); });
+    return ids;
+}
+
+// Copy lanelet IDs that are read in place, so that they can be compared
+std::optional<std::vector<uint64_t>> to_vector(const std::optional<std::span<const uint64_t>> &lanelet_ids) {
+    if (!lanelet_ids.has_value()) {
+        return std::nullopt;
+    }
+    return std::vector<uint64_t>{lanelet_ids->begin(), lanelet_ids->end()};
+}
+
+// Query every cached result of the first time steps of all obstacles that exist from the start
+void query_all(WorldCache &world_cache) {
+    for (const auto &obstacle : world_cache.get_world()->getObstacles()) {
+        world_cache.get_turning_directions(obstacle);
+        for (time_step_t time_step = 0; time_step < 5 && obstacle->timeStepExists(time_step); ++time_step) {
+            world_cache.get_obstacle_lane_ids(time_step, obstacle);
+            for (auto dir : {Direction::left, Direction::straight, Direction::right}) {
+                world_cache.get_priority(time_step, obstacle, dir);
+            }
+        }
+    }
+}
+} // namespace
+
+TEST_F(WorldCacheTest, GetsObstacleById) {
+    auto obstacle = world_cache->get_obstacle(102);
+    ASSERT_NE(obstacle, nullptr);
+    EXPECT_EQ(obstacle->getId(), 102);
+    EXPECT_EQ(world_cache->get_obstacle(999), nullptr);
+}
+
+TEST_F(WorldCacheTest, GetsObstaclesInWorldOrder) {
+    // The ego vehicle and unknown IDs are skipped
+    std::unordered_set<std::optional<size_t>> obstacle_ids{105, std::nullopt, 101, 999, 103};
+    EXPECT_EQ(get_ids(world_cache->get_obstacles(obstacle_ids)), (std::vector<size_t>{101, 103, 105}));
+
+    std::unordered_set<size_t> plain_obstacle_ids{104, 100};
+    EXPECT_EQ(get_ids(world_cache->get_obstacles(plain_obstacle_ids)), (std::vector<size_t>{100, 104}));
+
+    EXPECT_TRUE(world_cache->get_obstacles(std::unordered_set<size_t>{}).empty());
+}
+
+TEST_F(WorldCacheTest, GetsObstaclesOfRelevanceMatrixRow) {
+    auto matrix = RelevanceMatrix{world_cache->get_obstacle_time_index(), {{3, {105, std::nullopt, 101}}}};
+    auto [time_step, row] = *matrix.begin();
+    EXPECT_EQ(time_step, 3);
+    EXPECT_EQ(get_ids(world_cache->get_obstacles(row)), (std::vector<size_t>{101, 105}));
+}
+
+TEST_F(WorldCacheTest, LoadsSavedResultsWithoutRecomputing) {
+    auto scenario_hash = knowledge_extraction::env_model::hash_file(TestEnvironments::test_scenario_dir +
+                                                                   "interstate_simple.xml");
+    auto path = std::filesystem::temp_directory_path() / "cr_knowledge_extraction_test_world_cache.bin";
+    query_all(*world_cache);
+    world_cache->save(path, scenario_hash);
+
+    WorldCache loaded{world_cache->get_world()};
+    ASSERT_TRUE(loaded.load(path, scenario_hash));
+    loaded.get_statistics()->set_enabled(true);
+    query_all(loaded);
+    for (const auto &cache : loaded.get_statistics()->get_statistics().caches) {
+        if (cache.cache == CacheKind::OBSTACLE_LANE_IDS || cache.cache == CacheKind::TURNING_DIRECTIONS ||
+            cache.cache == CacheKind::PRIORITY) {
+            EXPECT_GT(cache.hits, 0);
+            EXPECT_EQ(cache.misses, 0);
+        }
+    }
+
+    for (const auto &obstacle : world_cache->get_world()->getObstacles()) {
+        EXPECT_EQ(loaded.get_turning_directions(obstacle), world_cache->get_turning_directions(obstacle));
+        EXPECT_EQ(to_vector(loaded.get_obstacle_lane_ids(2, obstacle)),
+                  to_vector(world_cache->get_obstacle_lane_ids(2, obstacle)));
+        EXPECT_EQ(loaded.get_priority(2, obstacle, Direction::left),
+                  world_cache->get_priority(2, obstacle, Direction::left));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(WorldCacheTest, IgnoresForeignOrCorruptCacheFiles) {
+    auto path = std::filesystem::temp_directory_path() / "cr_knowledge_extraction_test_corrupt_cache.bin";
+    query_all(*world_cache);
+    world_cache->save(path, 1);
+
+    WorldCache other{world_cache->get_world()};
+    EXPECT_FALSE(other.load(path, 2));
+    EXPECT_FALSE(other.load(path.string() + ".missing", 1));
+
+    auto data = world_cache->serialize(1);
+    EXPECT_THROW(other.deserialize(std::span{data}.first(data.size() - 1), 1), std::runtime_error);
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << "not a cache";
+    }
+    EXPECT_FALSE(other.load(path, 1));
+    // Nothing was loaded
+    EXPECT_EQ(other.serialize(1), WorldCache{world_cache->get_world()}.serialize(1));
+    std::filesystem::remove(path);
+}
+
+TEST_F(WorldCacheTest, AttachesToPublishedSegment) {
+    world_cache->precompute();
+    auto published = world_cache->publish("cr_knowledge_extraction_test_world_cache", 1);
+    EXPECT_THROW(world_cache->publish("cr_knowledge_extraction_test_world_cache", 1), std::runtime_error);
+
+    WorldCache attached{world_cache->get_world()};
+    auto segment = SharedWorldCache::open("cr_knowledge_extraction_test_world_cache");
+    EXPECT_FALSE(attached.attach(segment, 2));
+    ASSERT_TRUE(attached.attach(segment, 1));
+    attached.get_statistics()->set_enabled(true);
+    query_all(attached);
+    for (const auto &cache : attached.get_statistics()->get_statistics().caches) {
+        if (cache.cache == CacheKind::OBSTACLE_LANE_IDS || cache.cache == CacheKind::TURNING_DIRECTIONS ||
+            cache.cache == CacheKind::PRIORITY) {
+            EXPECT_EQ(cache.misses, 0);
+        }
+    }
+    // All values were read in place, thus nothing is cached locally
+    EXPECT_EQ(attached.serialize(1), WorldCache{world_cache->get_world()}.serialize(1));
+    for (const auto &obstacle : world_cache->get_world()->getObstacles()) {
+        EXPECT_EQ(to_vector(attached.get_obstacle_lane_ids(3, obstacle)),
+                  to_vector(world_cache->get_obstacle_lane_ids(3, obstacle)));
+        EXPECT_EQ(attached.get_priority(3, obstacle, Direction::straight),
+                  world_cache->get_priority(3, obstacle, Direction::straight));
+    }
+
+    // The segment is removed with the last reference of the publisher, attached caches keep their mapping
+    published.reset();
+    EXPECT_THROW(SharedWorldCache::open("cr_knowledge_extraction_test_world_cache"), std::runtime_error);
+    EXPECT_EQ(attached.get_turning_directions(world_cache->get_world()->getObstacles().front()),
+              world_cache->get_turning_directions(world_cache->get_world()->getObstacles().front()));
+}
+
+TEST_F(WorldCacheTest, LaneIdsMatchOccupiedLanes) {
+    // Obstacle 300 changes from the right lane of lanelets 3 and 4 to the left lane of lanelets 1 and 2
+    std::ifstream file{TestEnvironments::test_scenario_dir + "two_lanes.xml"};
+    std::string xml{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    WorldCache lane_change_cache{
+        TestEnvironments::load_world(xml, TestEnvironments::make_obstacle_xml(300, 5, 2, 0.1, 10, 40))};
+    lane_change_cache.get_statistics()->set_enabled(true);
+    auto obstacle = lane_change_cache.get_obstacle(300);
+    std::vector<std::optional<std::vector<uint64_t>>> lane_ids;
+    for (auto time_step : obstacle->getTimeSteps()) {
+        lane_ids.push_back(to_vector(lane_change_cache.get_obstacle_lane_ids(time_step, obstacle)));
+    }
+    // The lanes through the occupied lanelets are known from the lanelet attribute table
+    EXPECT_EQ(lane_change_cache.get_statistics()->get_statistics().num_lane_constructions, 0);
+
+    const auto &road_network = lane_change_cache.get_world()->getRoadNetwork();
+    size_t num_straddling = 0;
+    for (auto time_step : obstacle->getTimeSteps()) {
+        if (obstacle->getOccupiedLaneletsDrivingDirectionByShape(road_network, time_step).size() == 2) {
+            ++num_straddling;
+            EXPECT_EQ(lane_ids[time_step], (std::vector<uint64_t>{1, 2, 3, 4})) << "time step " << time_step;
+        }
+        std::set<size_t> lanelet_ids;
+        for (const auto &lane : obstacle->getOccupiedLanesDrivingDirection(road_network, time_step)) {
+            auto lane_lanelet_ids = lane->getContainedLaneletIDs();
+            lanelet_ids.insert(lane_lanelet_ids.begin(), lane_lanelet_ids.end());
+        }
+        EXPECT_EQ(lane_ids[time_step], std::vector<uint64_t>(lanelet_ids.begin(), lanelet_ids.end()))
+            << "time step " << time_step;
+    }
+    EXPECT_GT(num_straddling, 0);
+    EXPECT_EQ(lane_ids.front(), (std::vector<uint64_t>{3, 4}));
+    EXPECT_EQ(lane_ids.back(), (std::vector<uint64_t>{1, 2}));
+}
+
+TEST_F(WorldCacheTest, ReferenceLaneLaneletsOfIntersection) {
+    // Obstacle 202 drives straight from incoming lanelet 1 over intersection lanelet 14
+    WorldCache intersection_cache{TestEnvironments::load_world(TestEnvironments::generate_intersections_xml(1),
+                                                               TestEnvironments::make_obstacle_xml(202, -20, -1.75, 0,
+                                                                                                   10, 40))};
+    auto obstacle = intersection_cache.get_obstacle(202);
+    const auto *lanelets = intersection_cache.get_reference_lane_lanelets(0, obstacle);
+    ASSERT_NE(lanelets, nullptr);
+    EXPECT_EQ(lanelets->intersection_lanelet_ids, std::vector<size_t>{14});
+    EXPECT_EQ(lanelets->incoming_lanelet_ids, std::vector<size_t>{1});
+    // Repeated queries are answered from the cache
+    EXPECT_EQ(intersection_cache.get_reference_lane_lanelets(0, obstacle), lanelets);
+}
+
+TEST_F(WorldCacheTest, ReferenceLaneIsKeptWhileOnItsLanelets) {
+    // Obstacle 202 drives straight from incoming lanelet 1 over intersection lanelet 14 to outgoing lanelet 6
+    WorldCache intersection_cache{TestEnvironments::load_world(TestEnvironments::generate_intersections_xml(1),
+                                                               TestEnvironments::make_obstacle_xml(202, -40, -1.75, 0,
+                                                                                                   10, 60))};
+    intersection_cache.get_statistics()->set_enabled(true);
+    auto obstacle = intersection_cache.get_obstacle(202);
+    const auto &road_network = intersection_cache.get_world()->getRoadNetwork();
+    std::vector<std::vector<size_t>> occupied_lanelet_ids;
+    for (auto time_step : obstacle->getTimeSteps()) {
+        EXPECT_NE(intersection_cache.get_reference_lane_lanelets(time_step, obstacle), nullptr);
+        occupied_lanelet_ids.emplace_back();
+        for (const auto &lanelet : obstacle->getOccupiedLaneletsDrivingDirectionByShape(road_network, time_step)) {
+            occupied_lanelet_ids.back().push_back(lanelet->getId());
+        }
+        std::ranges::sort(occupied_lanelet_ids.back());
+    }
+
+    // The reference lane is only built again when the occupied lanelets change
+    size_t num_changes = 0;
+    for (size_t i = 1; i < occupied_lanelet_ids.size(); ++i) {
+        num_changes += occupied_lanelet_ids[i] != occupied_lanelet_ids[i - 1] ? 1 : 0;
+    }
+    auto statistics = intersection_cache.get_statistics()->get_statistics();
+    auto reference_lane = std::ranges::find_if(
+        statistics.caches, [](const auto &cache) { return cache.cache == CacheKind::REFERENCE_LANE; });
+    ASSERT_NE(reference_lane, statistics.caches.end());
+    EXPECT_EQ(reference_lane->misses, statistics.num_lane_constructions);
+    EXPECT_LE(reference_lane->misses, num_changes + 1);
+    EXPECT_LT(num_changes + 1, occupied_lanelet_ids.size());
+    EXPECT_EQ(reference_lane->hits + reference_lane->misses, occupied_lanelet_ids.size());
+
+    // Repeated queries are answered from the intervals
+    intersection_cache.get_reference_lane_lanelets(30, obstacle);
+    EXPECT_EQ(intersection_cache.get_statistics()->get_statistics().num_lane_constructions,
+              statistics.num_lane_constructions);
+}
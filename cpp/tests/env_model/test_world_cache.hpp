@@ -0,0 +1,13 @@
+#pragma once
+
+#include "cr_knowledge_extraction/env_model/env_model.hpp"
+#include "test_envs/test_envs.hpp"
+
+#include <gtest/gtest.h>
+
+class WorldCacheTest : public testing::Test {
+  protected:
+    TestEnvironments test_envs;
+    std::shared_ptr<knowledge_extraction::env_model::WorldCache> world_cache =
+        test_envs.interstate_simple->get_world_cache();
+};
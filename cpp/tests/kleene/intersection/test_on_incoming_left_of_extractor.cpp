@@ -0,0 +1,76 @@
+#include "test_on_incoming_left_of_extractor.hpp"
+
+#include "cr_knowledge_extraction/kleene/intersection/on_incoming_left_of_extractor.hpp"
+
+#include <gmock/gmock.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <numbers>
+#include <sstream>
+
+using namespace knowledge_extraction::kleene::intersection;
+using knowledge_extraction::ego_behavior::EgoParameters;
+using knowledge_extraction::env_model::EnvironmentModel;
+using knowledge_extraction::env_model::RelevanceMatrix;
+
+using testing::IsEmpty;
+using testing::UnorderedElementsAre;
+
+std::shared_ptr<EnvironmentModel> OnIncomingLeftOfExtractorTest::setup_intersection(std::string xml) {
+    auto world = TestEnvironments::load_world(
+        std::move(xml), TestEnvironments::make_obstacle_xml(200, 1.75, -50, std::numbers::pi / 2, 0, 10) +
+                            TestEnvironments::make_obstacle_xml(201, -50, 1.75, std::numbers::pi, 0, 10));
+
+    // The main road of the intersection in positive x direction
+    geometry::EigenPolyline reference_path{{-250, -1.75}, {0, -1.75}, {250, -1.75}};
+    auto ccs = std::make_shared<geometry::CurvilinearCoordinateSystem>(reference_path, 100);
+    EgoParameters ego_params;
+    ego_params.initial_state = State{0, -50, -1.75, 0, 0, 0};
+    return std::make_shared<EnvironmentModel>(world, ccs, ego_params, PredicateParameters{});
+}
+
+TEST_F(OnIncomingLeftOfExtractorTest, Intersection) {
+    auto env_model = setup_intersection(TestEnvironments::generate_intersections_xml(1));
+    auto extractor = OnIncomingLeftOfExtractor{env_model};
+    auto true_false_obstacle_ids = extractor.extract(
+        RelevanceMatrix{env_model->get_world_cache()->get_obstacle_time_index(), {{0, {200, 201}}}});
+
+    EXPECT_THAT(true_false_obstacle_ids.at(0).first, UnorderedElementsAre(size_t{200}));
+    EXPECT_THAT(true_false_obstacle_ids.at(0).second, UnorderedElementsAre(size_t{201}));
+}
+
+TEST_F(OnIncomingLeftOfExtractorTest, MissingLeftOfGroupIsLeftOfNoGroup) {
+    auto xml = TestEnvironments::generate_intersections_xml(1);
+    std::string is_left_of = "<isLeftOf ref=\"10\"/>";
+    auto position = xml.find(is_left_of);
+    ASSERT_NE(position, std::string::npos);
+    xml.erase(position, is_left_of.size());
+
+    std::ostringstream log;
+    auto default_logger = spdlog::default_logger();
+    spdlog::set_default_logger(
+        std::make_shared<spdlog::logger>("test", std::make_shared<spdlog::sinks::ostream_sink_mt>(log)));
+
+    auto env_model = setup_intersection(xml);
+    auto extractor = OnIncomingLeftOfExtractor{env_model};
+    auto relevant_obstacles_over_time =
+        RelevanceMatrix{env_model->get_world_cache()->get_obstacle_time_index(), {{0, {200, 201}}, {1, {200}}}};
+    std::unordered_map<time_step_t, OnIncomingLeftOfExtractor::TrueFalseObstacleIds> true_false_obstacle_ids;
+    EXPECT_NO_THROW(true_false_obstacle_ids = extractor.extract(relevant_obstacles_over_time));
+    EXPECT_NO_THROW(extractor.extract(relevant_obstacles_over_time));
+    spdlog::set_default_logger(default_logger);
+
+    // The incoming group 9 of the ego vehicle is not left of any other group, thus no obstacle is on the incoming left
+    // of the ego vehicle, including obstacle 200 on the incoming group 10 that group 9 was left of
+    EXPECT_THAT(true_false_obstacle_ids.at(0).first, IsEmpty());
+    EXPECT_THAT(true_false_obstacle_ids.at(0).second, UnorderedElementsAre(size_t{200}, size_t{201}));
+    EXPECT_THAT(true_false_obstacle_ids.at(1).first, IsEmpty());
+    EXPECT_THAT(true_false_obstacle_ids.at(1).second, UnorderedElementsAre(size_t{200}));
+
+    // Reported once when the lanelet attributes are computed, not for every time step or extraction
+    auto message = log.str();
+    auto first_warning = message.find("Incoming group 9 is not left of another incoming group");
+    ASSERT_NE(first_warning, std::string::npos);
+    EXPECT_EQ(message.find("Incoming group 9", first_warning + 1), std::string::npos);
+}
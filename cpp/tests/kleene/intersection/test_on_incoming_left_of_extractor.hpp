@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../../test_envs/test_envs.hpp"
+
+#include <gtest/gtest.h>
+
+class OnIncomingLeftOfExtractorTest : public testing::Test {
+  protected:
+    /**
+     * Set up the first of the generated intersections, see TestEnvironments::generate_intersections_xml for the IDs.
+     *
+     * The ego vehicle stands on the western incoming lanelet 1. Obstacle 200 stands on the southern incoming lanelet 3,
+     * whose incoming group 10 is the one that the incoming group 9 of the ego vehicle is left of. Obstacle 201 stands
+     * on the western outgoing lanelet 2.
+     *
+     * @param xml The road network in CommonRoad XML, possibly modified.
+     * @return The environment model.
+     */
+    static std::shared_ptr<knowledge_extraction::env_model::EnvironmentModel> setup_intersection(std::string xml);
+};
@@ -0,0 +1,66 @@
+#include "test_at_traffic_sign_extractor.hpp"
+
+#include "cr_knowledge_extraction/kleene/position/at_traffic_sign_extractor.hpp"
+
+#include <commonroad_cpp/roadNetwork/regulatoryElements/traffic_sign.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <numbers>
+
+using namespace knowledge_extraction::kleene::position;
+using knowledge_extraction::ego_behavior::EgoParameters;
+using knowledge_extraction::env_model::EnvironmentModel;
+using knowledge_extraction::env_model::RelevanceMatrix;
+
+using testing::UnorderedElementsAre;
+
+std::shared_ptr<EnvironmentModel> AtTrafficSignExtractorTest::setup_env_model(const std::shared_ptr<World> &world) {
+    geometry::EigenPolyline reference_path{{116.75, -250}, {116.75, 0}, {116.75, 250}};
+    auto ccs = std::make_shared<geometry::CurvilinearCoordinateSystem>(reference_path, 100);
+    EgoParameters ego_params;
+    ego_params.initial_state = State{0, 116.75, -60, 10, 0, std::numbers::pi / 2};
+    return std::make_shared<EnvironmentModel>(world, ccs, ego_params, PredicateParameters{});
+}
+
+TEST_F(AtTrafficSignExtractorTest, MatchesFullScanOfLanelets) {
+    std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>> relevant_obstacle_ids_over_time;
+    for (time_step_t time_step = 0; time_step < 10; ++time_step) {
+        relevant_obstacle_ids_over_time[time_step] = {std::nullopt};
+    }
+    auto extractor = AtTrafficSignExtractor{env_model, Proposition::AT_STOP_SIGN, TrafficSignTypes::STOP};
+    auto true_false_obstacle_ids = extractor.extract(
+        RelevanceMatrix{env_model->get_world_cache()->get_obstacle_time_index(), relevant_obstacle_ids_over_time});
+
+    // The ego vehicle starts in the middle of the lanelet with the stop sign
+    EXPECT_THAT(true_false_obstacle_ids.at(0).first, UnorderedElementsAre(std::nullopt));
+
+    // The previous implementation scanned all lanelets and signs on each call
+    std::unordered_set<size_t> stop_lanelet_ids;
+    for (const auto &lanelet : world->getRoadNetwork()->getLaneletNetwork()) {
+        if (std::ranges::any_of(lanelet->getTrafficSigns(), [](const auto &sign) {
+                return !sign->getTrafficSignElementsOfType(TrafficSignTypes::STOP).empty();
+            })) {
+            stop_lanelet_ids.insert(lanelet->getId());
+        }
+    }
+    EXPECT_THAT(stop_lanelet_ids, UnorderedElementsAre(size_t{30}, size_t{34}));
+
+    const auto &approximations = env_model->get_ego_approximations();
+    auto is_stop_lanelet = [&stop_lanelet_ids](const auto &lanelet) {
+        return stop_lanelet_ids.contains(lanelet->getId());
+    };
+    for (time_step_t time_step = 0; time_step < 10; ++time_step) {
+        AtTrafficSignExtractor::TrueFalseObstacleIds expected;
+        if (std::ranges::none_of(approximations->get_covered_lanelets(time_step), is_stop_lanelet)) {
+            expected.second.insert(std::nullopt);
+        } else if (std::ranges::all_of(approximations->get_intersected_lanelets(time_step), is_stop_lanelet)) {
+            expected.first.insert(std::nullopt);
+        }
+        auto result = true_false_obstacle_ids.find(time_step);
+        EXPECT_EQ(result == true_false_obstacle_ids.end() ? AtTrafficSignExtractor::TrueFalseObstacleIds{}
+                                                          : result->second,
+                  expected)
+            << "Time step " << time_step;
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../../test_envs/test_envs.hpp"
+
+#include <gtest/gtest.h>
+
+class AtTrafficSignExtractorTest : public testing::Test {
+  protected:
+    // The ego vehicle drives north on the southern incoming lanelet 30 of the second generated intersection, which
+    // has a stop sign, see TestEnvironments::generate_intersections_xml for the IDs
+    std::shared_ptr<World> world = TestEnvironments::load_world(TestEnvironments::generate_intersections_xml(2));
+    std::shared_ptr<knowledge_extraction::env_model::EnvironmentModel> env_model = setup_env_model(world);
+
+    static std::shared_ptr<knowledge_extraction::env_model::EnvironmentModel>
+    setup_env_model(const std::shared_ptr<World> &world);
+};
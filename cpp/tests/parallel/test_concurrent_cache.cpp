@@ -0,0 +1,42 @@
+#include "test_concurrent_cache.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+using knowledge_extraction::parallel::WorkStealingPool;
+
+TEST_F(ConcurrentCacheTest, ComputesEachEntryOnce) {
+    std::vector<std::atomic<int>> computations(50);
+    std::vector<WorkStealingPool::Task> tasks;
+    for (size_t i = 0; i < 1000; ++i) {
+        tasks.emplace_back([this, &computations, i]() {
+            auto key = i % computations.size();
+            auto value = cache.get_or_compute(key, [&computations, key]() {
+                ++computations[key];
+                return key * key;
+            });
+            EXPECT_EQ(value, key * key);
+        });
+    }
+    pool.run(std::move(tasks));
+
+    EXPECT_EQ(cache.size(), computations.size());
+    for (const auto &count : computations) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST_F(ConcurrentCacheTest, ReferencesStayValid) {
+    const auto &first = cache.get_or_compute(0, []() { return size_t{42}; });
+    for (size_t i = 1; i < 1000; ++i) {
+        cache.get_or_compute(i, [i]() { return i; });
+    }
+    EXPECT_EQ(&first, &cache.get_or_compute(0, []() { return size_t{0}; }));
+    EXPECT_EQ(first, 42);
+}
+
+TEST_F(ConcurrentCacheTest, RetriesAfterError) {
+    EXPECT_THROW(cache.get_or_compute(1, []() -> size_t { throw std::runtime_error{"failed"}; }), std::runtime_error);
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.get_or_compute(1, []() { return size_t{2}; }), 2);
+}
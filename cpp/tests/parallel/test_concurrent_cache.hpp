@@ -0,0 +1,12 @@
+#pragma once
+
+#include "cr_knowledge_extraction/parallel/concurrent_cache.hpp"
+#include "cr_knowledge_extraction/parallel/work_stealing_pool.hpp"
+
+#include <gtest/gtest.h>
+
+class ConcurrentCacheTest : public testing::Test {
+  protected:
+    knowledge_extraction::parallel::ConcurrentCache<size_t, size_t> cache;
+    knowledge_extraction::parallel::WorkStealingPool pool{4};
+};
@@ -0,0 +1,53 @@
+#include "test_work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+using knowledge_extraction::parallel::WorkStealingPool;
+
+TEST_F(WorkStealingPoolTest, RunsEveryTaskOnce) {
+    std::vector<int> counts(1000, 0);
+    std::vector<WorkStealingPool::Task> tasks;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        tasks.emplace_back([&counts, i]() { ++counts[i]; });
+    }
+    pool.run(std::move(tasks));
+
+    EXPECT_EQ(std::accumulate(counts.begin(), counts.end(), 0), 1000);
+    EXPECT_TRUE(std::ranges::all_of(counts, [](int count) { return count == 1; }));
+}
+
+TEST_F(WorkStealingPoolTest, ReusableAcrossRuns) {
+    std::atomic<int> sum{0};
+    for (int run = 0; run < 10; ++run) {
+        std::vector<WorkStealingPool::Task> tasks;
+        for (int i = 1; i <= 10; ++i) {
+            tasks.emplace_back([&sum, i]() { sum += i; });
+        }
+        pool.run(std::move(tasks));
+    }
+    EXPECT_EQ(sum, 550);
+}
+
+TEST_F(WorkStealingPoolTest, RethrowsFirstError) {
+    std::atomic<int> finished{0};
+    std::vector<WorkStealingPool::Task> tasks;
+    for (int i = 0; i < 20; ++i) {
+        tasks.emplace_back([&finished, i]() {
+            if (i == 7 || i == 13) {
+                throw std::runtime_error{std::to_string(i)};
+            }
+            ++finished;
+        });
+    }
+    try {
+        pool.run(std::move(tasks));
+        FAIL() << "Expected an exception";
+    } catch (const std::runtime_error &e) {
+        EXPECT_STREQ(e.what(), "7");
+    }
+    // All other tasks still ran
+    EXPECT_EQ(finished, 18);
+}
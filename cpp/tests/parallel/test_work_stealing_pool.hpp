@@ -0,0 +1,10 @@
+#pragma once
+
+#include "cr_knowledge_extraction/parallel/work_stealing_pool.hpp"
+
+#include <gtest/gtest.h>
+
+class WorkStealingPoolTest : public testing::Test {
+  protected:
+    knowledge_extraction::parallel::WorkStealingPool pool{4};
+};
@@ -5,18 +5,21 @@
 #include <gmock/gmock.h>
 
 using namespace knowledge_extraction::relationship::implication;
+using knowledge_extraction::env_model::RelevanceMatrix;
 using knowledge_extraction::relationship::RelationshipType;
 
 using testing::UnorderedElementsAreArray;
 
 TEST_F(InFrontOfImplExtractorTest, InterstateSimple) {
     auto extractor = InFrontOfImplExtractor{test_envs.interstate_simple};
-    auto relevant_obstacle_ids_over_time = std::unordered_map<time_step_t, std::unordered_set<std::optional<size_t>>>{
-        {0, {100, 101, 102, 103, 104, 105}},
-        {1, {100, 101, 102, 104, 105}},
-        {39, {100, 101, 102, 103, 104, 105}},
-    };
-    auto implications_over_time = extractor.extract(relevant_obstacle_ids_over_time);
+    auto relevant_obstacles_over_time =
+        RelevanceMatrix{test_envs.interstate_simple->get_world_cache()->get_obstacle_time_index(),
+                        {
+                            {0, {100, 101, 102, 103, 104, 105}},
+                            {1, {100, 101, 102, 104, 105}},
+                            {39, {100, 101, 102, 103, 104, 105}},
+                        }};
+    auto implications_over_time = extractor.extract(relevant_obstacles_over_time);
 
     EXPECT_THAT(implications_over_time.at(0), UnorderedElementsAreArray({
                                                   std::tuple{RelationshipType::IMPLICATION, 100, 101},
@@ -0,0 +1,27 @@
+#include "test_curvilinear_road_network.hpp"
+
+#include <gmock/gmock.h>
+
+using knowledge_extraction::ego_behavior::sets::Box2D;
+
+using testing::IsEmpty;
+using testing::UnorderedElementsAre;
+
+TEST_F(CurvilinearRoadNetworkTest, ProjectsAllLanelets) {
+    EXPECT_EQ(two_lanes.get_curvilinear_lanelets().size(), 4);
+}
+
+TEST_F(CurvilinearRoadNetworkTest, SingleLanelet) {
+    auto box = Box2D::from_bounds({10, 5}, {20, 6});
+    EXPECT_THAT(get_overlapping_lanelet_ids(box), UnorderedElementsAre(1));
+}
+
+TEST_F(CurvilinearRoadNetworkTest, AcrossLaneletBorders) {
+    auto box = Box2D::from_bounds({35, 3}, {45, 5});
+    EXPECT_THAT(get_overlapping_lanelet_ids(box), UnorderedElementsAre(1, 2, 3, 4));
+}
+
+TEST_F(CurvilinearRoadNetworkTest, OutsideOfRoadNetwork) {
+    EXPECT_THAT(get_overlapping_lanelet_ids(Box2D::from_bounds({100, 0}, {110, 8})), IsEmpty());
+    EXPECT_THAT(get_overlapping_lanelet_ids(Box2D::from_bounds({10, 9}, {20, 10})), IsEmpty());
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../test_envs/test_envs.hpp"
+
+#include "cr_knowledge_extraction/road_network/curvilinear_road_network.hpp"
+
+#include <gtest/gtest.h>
+
+class CurvilinearRoadNetworkTest : public testing::Test {
+  protected:
+    TestEnvironments test_envs;
+    knowledge_extraction::road_network::CurvilinearRoadNetwork two_lanes{
+        test_envs.two_lanes->get_world()->getRoadNetwork(), test_envs.two_lanes->get_ego_ccs()};
+
+    std::vector<size_t> get_overlapping_lanelet_ids(const knowledge_extraction::ego_behavior::sets::Box2D &box) const {
+        std::vector<size_t> ids;
+        for (const auto &lanelet : two_lanes.get_overlapping_lanelets(box)) {
+            ids.push_back(lanelet->getId());
+        }
+        return ids;
+    }
+};
@@ -0,0 +1,143 @@
+#include "test_lanelet_attribute_table.hpp"
+
+#include "cr_knowledge_extraction/env_model/world_cache.hpp"
+
+#include <limits>
+#include <tuple>
+
+using knowledge_extraction::env_model::WorldCache;
+using knowledge_extraction::road_network::LaneletAttributes;
+
+TEST_F(LaneletAttributeTableTest, ContainsAllLanelets) {
+    const auto &lanelets = test_envs.interstate_simple->get_world()->getRoadNetwork()->getLaneletNetwork();
+    EXPECT_EQ(interstate_simple.size(), lanelets.size());
+    for (const auto &lanelet : lanelets) {
+        EXPECT_TRUE(interstate_simple.get_lanelet_index(lanelet->getId()).has_value());
+    }
+    EXPECT_FALSE(interstate_simple.get_lanelet_index(1).has_value());
+}
+
+TEST_F(LaneletAttributeTableTest, Types) {
+    EXPECT_TRUE(get_attributes(48951).has_type(LaneletType::mainCarriageWay));
+    EXPECT_FALSE(get_attributes(48951).has_type(LaneletType::accessRamp));
+    EXPECT_TRUE(get_attributes(48959).has_type(LaneletType::accessRamp));
+    EXPECT_FALSE(get_attributes(48959).has_type(LaneletType::mainCarriageWay));
+}
+
+TEST_F(LaneletAttributeTableTest, AdjacencyFlags) {
+    EXPECT_EQ(get_attributes(48951).flags, LaneletAttributes::leftmost);
+    EXPECT_EQ(get_attributes(48953).flags, 0);
+    EXPECT_EQ(get_attributes(48957).flags, LaneletAttributes::rightmost);
+    EXPECT_EQ(get_attributes(48959).flags, LaneletAttributes::leftmost | LaneletAttributes::rightmost);
+}
+
+TEST_F(LaneletAttributeTableTest, CombinesTypesOfLanelets) {
+    auto mcw_bit = LaneletAttributes::type_bit(LaneletType::mainCarriageWay);
+    auto ramp_bit = LaneletAttributes::type_bit(LaneletType::accessRamp);
+    std::vector lanelets{get_lanelet(48957), get_lanelet(48959)};
+
+    EXPECT_EQ(interstate_simple.get_types_of_any(lanelets), mcw_bit | ramp_bit);
+    EXPECT_EQ(interstate_simple.get_types_of_all(lanelets), 0);
+    EXPECT_EQ(interstate_simple.get_types_of_all({get_lanelet(48951), get_lanelet(48953)}), mcw_bit);
+
+    EXPECT_EQ(interstate_simple.get_types_of_any({}), 0);
+    EXPECT_EQ(interstate_simple.get_types_of_all({}) & mcw_bit, mcw_bit);
+}
+
+TEST_F(LaneletAttributeTableTest, NoIncomingGroupsOutsideOfIntersections) {
+    for (const auto &lanelet : test_envs.interstate_simple->get_world()->getRoadNetwork()->getLaneletNetwork()) {
+        EXPECT_FALSE(interstate_simple.get_incoming_group_id(lanelet->getId()).has_value());
+        EXPECT_FALSE(interstate_simple.get_left_of_incoming_group_id(lanelet->getId()).has_value());
+    }
+}
+
+TEST_F(LaneletAttributeTableTest, IncomingGroupsOfIntersections) {
+    // The incoming lanelets with their incoming group and the incoming group that it is left of
+    std::vector<std::tuple<size_t, size_t, size_t>> incomings{{1, 9, 10},  {3, 10, 11}, {5, 11, 12},  {7, 12, 9},
+                                                              {6, 36, 37}, {30, 37, 38}, {32, 38, 39}, {34, 39, 36}};
+    for (const auto &[lanelet_id, incoming_group_id, left_of_incoming_group_id] : incomings) {
+        EXPECT_EQ(intersections.get_incoming_group_id(lanelet_id), incoming_group_id);
+        EXPECT_EQ(intersections.get_left_of_incoming_group_id(lanelet_id), left_of_incoming_group_id);
+    }
+
+    // Outgoing and intersection lanelets
+    for (size_t lanelet_id : {2, 4, 8, 14, 15, 16, 31, 41}) {
+        EXPECT_FALSE(intersections.get_incoming_group_id(lanelet_id).has_value());
+        EXPECT_FALSE(intersections.get_left_of_incoming_group_id(lanelet_id).has_value());
+    }
+}
+
+TEST_F(LaneletAttributeTableTest, LaneletSets) {
+    auto lanelet_set = interstate_simple.make_lanelet_set({get_lanelet(48951), get_lanelet(48959), get_lanelet(48951)});
+    EXPECT_EQ(lanelet_set.size(), 2);
+    EXPECT_TRUE(interstate_simple.contains(lanelet_set, get_lanelet(48951)));
+    EXPECT_TRUE(interstate_simple.contains(lanelet_set, get_lanelet(48959)));
+    EXPECT_FALSE(interstate_simple.contains(lanelet_set, get_lanelet(48953)));
+    EXPECT_TRUE(interstate_simple.make_lanelet_set({}).empty());
+}
+
+TEST_F(LaneletAttributeTableTest, NoLaneletsWithTrafficSignsWithoutSigns) {
+    EXPECT_TRUE(test_envs.interstate_simple->get_lanelets_with_traffic_sign(TrafficSignTypes::STOP).empty());
+}
+
+TEST_F(LaneletAttributeTableTest, LaneletsWithStopSigns) {
+    WorldCache world_cache{intersections_world};
+    const auto &stop_lanelets = world_cache.get_lanelets_with_traffic_sign(TrafficSignTypes::STOP);
+    const auto &lanelet_attributes = *world_cache.get_lanelet_attributes();
+
+    // The side roads of the second intersection
+    EXPECT_EQ(stop_lanelets.size(), 2);
+    EXPECT_TRUE(lanelet_attributes.contains(stop_lanelets, get_intersections_lanelet(30)));
+    EXPECT_TRUE(lanelet_attributes.contains(stop_lanelets, get_intersections_lanelet(34)));
+    // Incoming lanelets with priority road and yield signs, and lanelets without signs
+    for (size_t lanelet_id : {1, 3, 6, 32, 31, 45}) {
+        EXPECT_FALSE(lanelet_attributes.contains(stop_lanelets, get_intersections_lanelet(lanelet_id)));
+    }
+    // The set is computed once
+    EXPECT_EQ(&world_cache.get_lanelets_with_traffic_sign(TrafficSignTypes::STOP), &stop_lanelets);
+}
+
+TEST_F(LaneletAttributeTableTest, PrioritiesMatchTrafficSigns) {
+    constexpr auto no_priority = std::numeric_limits<int>::min();
+    auto get_priority = [this](size_t lanelet_id, Direction dir) {
+        return intersections.get_priority(get_intersections_lanelet(lanelet_id), dir);
+    };
+
+    for (auto dir : {Direction::left, Direction::straight, Direction::right}) {
+        // The incoming lanelets with a priority road, yield, and stop sign
+        auto priority_road = get_priority(1, dir);
+        auto yield = get_priority(3, dir);
+        auto stop = get_priority(30, dir);
+        EXPECT_EQ(get_priority(5, dir), priority_road);
+        EXPECT_EQ(get_priority(6, dir), priority_road);
+        EXPECT_EQ(get_priority(7, dir), yield);
+        EXPECT_EQ(get_priority(34, dir), stop);
+        EXPECT_GT(yield, no_priority);
+        EXPECT_GT(stop, no_priority);
+        EXPECT_GT(priority_road, yield);
+        EXPECT_GT(priority_road, stop);
+
+        // Outgoing and intersection lanelets have no sign
+        for (size_t lanelet_id : {2, 4, 14, 15, 16, 31, 41}) {
+            EXPECT_EQ(get_priority(lanelet_id, dir), no_priority);
+        }
+
+        for (const auto &lanelet : intersections_world->getRoadNetwork()->getLaneletNetwork()) {
+            EXPECT_EQ(intersections.get_priority(lanelet, dir),
+                      regulatory_elements_utils::extractPriorityTrafficSign({lanelet}, dir));
+        }
+    }
+
+    auto priority_road = get_priority(1, Direction::left);
+    auto yield = get_priority(3, Direction::left);
+    EXPECT_EQ(intersections.get_priority_range({get_intersections_lanelet(3)}, Direction::left),
+              std::make_pair(yield, yield));
+    EXPECT_EQ(intersections.get_priority_range({get_intersections_lanelet(1), get_intersections_lanelet(3)},
+                                               Direction::left),
+              std::make_pair(yield, priority_road));
+    EXPECT_EQ(intersections.get_priority_range(
+                  {get_intersections_lanelet(3), get_intersections_lanelet(2), get_intersections_lanelet(1)},
+                  Direction::left),
+              std::make_pair(no_priority, priority_road));
+    EXPECT_THROW(intersections.get_priority_range({}, Direction::left), std::invalid_argument);
+}
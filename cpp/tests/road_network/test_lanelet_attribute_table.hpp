@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../test_envs/test_envs.hpp"
+
+#include "cr_knowledge_extraction/road_network/lanelet_attribute_table.hpp"
+
+#include <gtest/gtest.h>
+
+class LaneletAttributeTableTest : public testing::Test {
+  protected:
+    TestEnvironments test_envs;
+    const knowledge_extraction::road_network::LaneletAttributeTable &interstate_simple =
+        test_envs.interstate_simple->get_lanelet_attributes();
+
+    // Two generated intersections with traffic signs, see TestEnvironments::generate_intersections_xml for the IDs
+    std::shared_ptr<World> intersections_world =
+        TestEnvironments::load_world(TestEnvironments::generate_intersections_xml(2));
+    const knowledge_extraction::road_network::LaneletAttributeTable intersections{
+        intersections_world->getRoadNetwork()};
+
+    static std::shared_ptr<Lanelet> find_lanelet(const std::shared_ptr<World> &world, size_t lanelet_id) {
+        for (const auto &lanelet : world->getRoadNetwork()->getLaneletNetwork()) {
+            if (lanelet->getId() == lanelet_id) {
+                return lanelet;
+            }
+        }
+        throw std::invalid_argument("Unknown lanelet " + std::to_string(lanelet_id));
+    }
+
+    std::shared_ptr<Lanelet> get_lanelet(size_t lanelet_id) const {
+        return find_lanelet(test_envs.interstate_simple->get_world(), lanelet_id);
+    }
+
+    std::shared_ptr<Lanelet> get_intersections_lanelet(size_t lanelet_id) const {
+        return find_lanelet(intersections_world, lanelet_id);
+    }
+
+    knowledge_extraction::road_network::LaneletAttributes get_attributes(size_t lanelet_id) const {
+        return interstate_simple.get_attributes(get_lanelet(lanelet_id));
+    }
+};
@@ -0,0 +1,141 @@
+#include "test_anytime.hpp"
+
+#include "cr_knowledge_extraction/anytime.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+using knowledge_extraction::ExtractionCost;
+using knowledge_extraction::ExtractionInterface;
+using knowledge_extraction::ExtractorKind;
+using knowledge_extraction::KnowledgeKind;
+using knowledge_extraction::Proposition;
+using knowledge_extraction::parallel::Budget;
+using knowledge_extraction::parallel::CancellationToken;
+
+namespace {
+const std::unordered_map<time_step_t, std::vector<std::string>> relevant_propositions{
+    {0, {"InFrontOf(100)", "InSameLane(102)", "OnMainCarriageway"}},
+    {1, {"InFrontOf(100)", "InSameLane(103)"}},
+    {3, {"KeepsSafeDistancePrec(101)", "OnMainCarriageway"}},
+};
+
+// The order in which the anytime extraction schedules its units of work
+auto schedule_key(ExtractorKind kind, Proposition prop, time_step_t time_step) {
+    return std::tuple{knowledge_extraction::anytime::estimate_cost(prop, kind), time_step, kind, prop};
+}
+
+bool contains(const std::vector<std::string> &propositions, const std::string &prop) {
+    return std::ranges::find(propositions, prop) != propositions.end();
+}
+
+bool contains(const std::vector<std::pair<std::string, std::string>> &relationships,
+              const std::pair<std::string, std::string> &relationship) {
+    return std::ranges::find(relationships, relationship) != relationships.end();
+}
+} // namespace
+
+TEST_F(AnytimeTest, EstimateCost) {
+    EXPECT_EQ(knowledge_extraction::anytime::estimate_cost(Proposition::ON_MAIN_CARRIAGEWAY, ExtractorKind::KLEENE),
+              ExtractionCost::CHEAP);
+    EXPECT_EQ(knowledge_extraction::anytime::estimate_cost(Proposition::IN_FRONT_OF, ExtractorKind::KLEENE),
+              ExtractionCost::MODERATE);
+    EXPECT_EQ(knowledge_extraction::anytime::estimate_cost(Proposition::ON_INCOMING_LEFT_OF, ExtractorKind::KLEENE),
+              ExtractionCost::EXPENSIVE);
+    EXPECT_EQ(knowledge_extraction::anytime::estimate_cost(Proposition::IN_INTERSECTION_CONFLICT_AREA,
+                                                           ExtractorKind::RELATIONSHIP),
+              ExtractionCost::EXPENSIVE);
+}
+
+TEST_F(AnytimeTest, UnlimitedBudgetIsComplete) {
+    auto result = extraction_interface.extract_all_anytime(relevant_propositions, Budget{});
+    EXPECT_TRUE(result.report.complete);
+    EXPECT_TRUE(result.report.skipped.empty());
+    EXPECT_GT(result.report.num_completed, 0);
+
+    auto expected = extraction_interface.extract_all_compact(relevant_propositions);
+    EXPECT_EQ(result.knowledge.size(), expected.size());
+    EXPECT_EQ(result.knowledge.get_time_steps(), expected.get_time_steps());
+}
+
+TEST_F(AnytimeTest, CancelledBeforeStart) {
+    auto token = std::make_shared<CancellationToken>();
+    token->cancel();
+    auto result = extraction_interface.extract_all_anytime(relevant_propositions, Budget{std::nullopt, token});
+    EXPECT_FALSE(result.report.complete);
+    EXPECT_EQ(result.report.num_completed, 0);
+    EXPECT_EQ(result.knowledge.size(), 0);
+    ASSERT_FALSE(result.report.skipped.empty());
+
+    // Skipped work is reported in schedule order, i.e., cheap extractors and near time steps first
+    EXPECT_EQ(result.report.skipped.front().proposition, Proposition::ON_MAIN_CARRIAGEWAY);
+    EXPECT_EQ(result.report.skipped.front().time_step, 0);
+    EXPECT_TRUE(std::ranges::is_sorted(result.report.skipped, {}, [](const auto &skipped) {
+        return knowledge_extraction::anytime::estimate_cost(skipped.proposition, skipped.kind);
+    }));
+}
+
+TEST_F(AnytimeTest, ExpiredDeadline) {
+    auto result = extraction_interface.extract_all_anytime(relevant_propositions,
+                                                           Budget::from_timeout(Budget::Clock::duration::zero()));
+    EXPECT_FALSE(result.report.complete);
+    EXPECT_EQ(result.knowledge.size(), 0);
+}
+
+TEST_F(AnytimeTest, ExpiringBudgetKeepsCheapestWork) {
+    auto full = extraction_interface.extract_all_anytime(relevant_propositions, Budget{});
+    auto full_knowledge = full.knowledge.render_all();
+    auto num_units = full.report.num_completed;
+
+    // Each attempt uses fresh caches, so the extraction takes about as long as the measured one
+    auto make_interface = [this]() {
+        return ExtractionInterface{test_envs.interstate_simple->get_world(),
+                                   test_envs.interstate_simple->get_ego_ccs(),
+                                   knowledge_extraction::ego_behavior::EgoParameters{}};
+    };
+    auto start = Budget::Clock::now();
+    make_interface().extract_all_anytime(relevant_propositions, Budget{});
+    auto duration = Budget::Clock::now() - start;
+
+    // Deadlines within the measured duration let some attempts stop partway
+    constexpr int num_attempts = 16;
+    auto num_partial = 0;
+    for (int attempt = 1; attempt < num_attempts; ++attempt) {
+        auto result = make_interface().extract_all_anytime(relevant_propositions,
+                                                           Budget::from_timeout(duration * attempt / num_attempts));
+        ASSERT_EQ(result.report.num_completed + result.report.skipped.size(), num_units);
+        if (result.report.complete || result.report.num_completed == 0) {
+            continue;
+        }
+        ++num_partial;
+
+        // A single worker finishes a prefix of the schedule, so all knowledge stems from work before the first skip
+        const auto &first_skipped = result.report.skipped.front();
+        auto first_skipped_key = schedule_key(first_skipped.kind, first_skipped.proposition, first_skipped.time_step);
+        for (const auto &record : result.knowledge.get_records()) {
+            auto kind = record.kind == KnowledgeKind::POSITIVE || record.kind == KnowledgeKind::NEGATIVE
+                            ? ExtractorKind::KLEENE
+                            : ExtractorKind::RELATIONSHIP;
+            EXPECT_LT(schedule_key(kind, record.lhs, record.time_step), first_skipped_key);
+        }
+
+        // The knowledge of completed work is the same as without a budget
+        for (const auto &[time_step, knowledge] : result.knowledge.render_all()) {
+            ASSERT_TRUE(full_knowledge.contains(time_step));
+            const auto &expected = full_knowledge.at(time_step);
+            for (const auto &prop : knowledge.positive_propositions) {
+                EXPECT_TRUE(contains(expected.positive_propositions, prop)) << prop;
+            }
+            for (const auto &prop : knowledge.negative_propositions) {
+                EXPECT_TRUE(contains(expected.negative_propositions, prop)) << prop;
+            }
+            for (const auto &implication : knowledge.implications) {
+                EXPECT_TRUE(contains(expected.implications, implication));
+            }
+            for (const auto &equivalence : knowledge.equivalences) {
+                EXPECT_TRUE(contains(expected.equivalences, equivalence));
+            }
+        }
+    }
+    EXPECT_GT(num_partial, 0);
+}
@@ -1,9 +1,21 @@
 #include "test_envs.hpp"
 
+#include "scenario_generator.hpp"
+
 #include <commonroad_cpp/interfaces/commonroad/input_utils.h>
 
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <random>
+#include <stdexcept>
+
 using knowledge_extraction::ego_behavior::EgoParameters;
 using knowledge_extraction::env_model::EnvironmentModel;
+using knowledge_extraction::scenario_generator::RoadLayout;
+using knowledge_extraction::scenario_generator::ScenarioParameters;
 
 TestEnvironments::TestEnvironments() : interstate_simple(setup_interstate_simple()), two_lanes(setup_two_lanes()) {}
 
@@ -33,3 +45,68 @@ std::shared_ptr<EnvironmentModel> TestEnvironments::setup_two_lanes() {
 
     return std::make_shared<EnvironmentModel>(world, ccs, EgoParameters{}, PredicateParameters{});
 }
+
+// The generated IDs of the first two intersections, the arms are listed counterclockwise starting in the west:
+// Intersection 13 at (0, 0): incoming lanelets 1, 3, 5, 7 in the incoming groups 9, 10, 11, 12, each left of the
+//   next one and 12 left of 9. Outgoing lanelets 2, 4, 6, 8. Straight, right, and left lanelets 14-16, 18-20, 22-24,
+//   26-28. The incoming lanelets have the traffic signs 17 (priority road), 21 (yield), 25 (priority road), 29 (yield).
+// Intersection 40 at (115, 0): incoming lanelets 6, 30, 32, 34 in the incoming groups 36, 37, 38, 39. Outgoing lanelets
+//   5, 31, 33, 35. Straight, right, and left lanelets 41-43, 45-47, 49-51, 53-55. The incoming lanelets have the
+//   traffic signs 44 (priority road), 48 (stop), 52 (priority road), 56 (stop).
+// All lanes are 3.5 m wide, the incoming lanelets end 7.5 m before the center of their intersection.
+std::string TestEnvironments::generate_intersections_xml(size_t num_intersections) {
+    return knowledge_extraction::scenario_generator::generate_commonroad_xml(
+        ScenarioParameters{.layout = RoadLayout::INTERSECTIONS, .num_segments = num_intersections, .num_obstacles = 0});
+}
+
+std::string TestEnvironments::make_obstacle_xml(size_t id, double x, double y, double orientation, double velocity,
+                                                size_t num_time_steps) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(4);
+    auto write_state = [&](size_t time_step) {
+        auto distance = velocity * static_cast<double>(time_step) * 0.1;
+        out << "<time><exact>" << time_step << "</exact></time>"
+            << "<position><point><x>" << x + (distance * std::cos(orientation)) << "</x><y>"
+            << y + (distance * std::sin(orientation)) << "</y></point></position>"
+            << "<orientation><exact>" << orientation << "</exact></orientation>"
+            << "<velocity><exact>" << velocity << "</exact></velocity>"
+            << "<acceleration><exact>0.0</exact></acceleration>\n";
+    };
+    out << "<dynamicObstacle id=\"" << id << "\"><type>car</type>"
+        << "<shape><rectangle><length>4.5</length><width>1.8</width></rectangle></shape>\n<initialState>";
+    write_state(0);
+    out << "</initialState>\n";
+    if (num_time_steps > 1) {
+        out << "<trajectory>\n";
+        for (size_t time_step = 1; time_step < num_time_steps; ++time_step) {
+            out << "<state>";
+            write_state(time_step);
+            out << "</state>\n";
+        }
+        out << "</trajectory>\n";
+    }
+    out << "</dynamicObstacle>\n";
+    return out.str();
+}
+
+std::shared_ptr<World> TestEnvironments::load_world(std::string xml, const std::string &obstacles_xml) {
+    xml.insert(xml.rfind("</commonRoad>"), obstacles_xml);
+
+    // The CommonRoad reader only reads files
+    static size_t file_counter = 0;
+    auto path = std::filesystem::temp_directory_path() /
+                ("cr_knowledge_extraction_test_" + std::to_string(std::random_device{}()) + "_" +
+                 std::to_string(file_counter++) + ".xml");
+    {
+        std::ofstream file{path};
+        file << xml;
+        if (!file) {
+            throw std::runtime_error("Cannot write test scenario to " + path.string());
+        }
+    }
+    auto scenario = InputUtils::getDataFromCommonRoad(path.string());
+    std::filesystem::remove(path);
+
+    return std::make_shared<World>("generated", 0, scenario.roadNetwork, std::vector<std::shared_ptr<Obstacle>>{},
+                                   scenario.obstacles, scenario.timeStepSize);
+}
@@ -14,4 +14,12 @@ struct TestEnvironments {
     static const std::string test_scenario_dir;
     static std::shared_ptr<knowledge_extraction::env_model::EnvironmentModel> setup_interstate_simple();
     static std::shared_ptr<knowledge_extraction::env_model::EnvironmentModel> setup_two_lanes();
+
+    // A chain of generated 4-way intersections without obstacles in CommonRoad XML, see test_envs.cpp for the IDs
+    static std::string generate_intersections_xml(size_t num_intersections);
+    // A car in CommonRoad XML that drives along a straight line with constant velocity, time steps are 0.1 s
+    static std::string make_obstacle_xml(size_t id, double x, double y, double orientation, double velocity,
+                                         size_t num_time_steps);
+    // Load a scenario from CommonRoad XML with additional obstacles from make_obstacle_xml
+    static std::shared_ptr<World> load_world(std::string xml, const std::string &obstacles_xml = "");
 };
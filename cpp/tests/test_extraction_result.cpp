@@ -0,0 +1,41 @@
+#include "test_extraction_result.hpp"
+
+using knowledge_extraction::KnowledgeKind;
+using knowledge_extraction::Proposition;
+
+TEST_F(CompactExtractionResultTest, GroupsRecordsByTimeStep) {
+    EXPECT_EQ(result.size(), 5);
+    EXPECT_EQ(result.get_time_steps(), (std::vector<time_step_t>{0, 1, 3}));
+    EXPECT_TRUE(result.get_records(2).empty());
+    EXPECT_TRUE(result.get_records(100).empty());
+
+    // The order within a time step is preserved
+    auto records = result.get_records(3);
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0].lhs, Proposition::IN_SAME_LANE);
+    EXPECT_EQ(records[1].kind, KnowledgeKind::EQUIVALENCE);
+    EXPECT_EQ(records[2].lhs, Proposition::IN_FRONT_OF);
+}
+
+TEST_F(CompactExtractionResultTest, Render) {
+    auto rendered = result.render(3);
+    EXPECT_EQ(rendered.positive_propositions, (std::vector<std::string>{"InSameLane(7)", "InFrontOf(9)"}));
+    EXPECT_TRUE(rendered.negative_propositions.empty());
+    EXPECT_TRUE(rendered.implications.empty());
+    ASSERT_EQ(rendered.equivalences.size(), 1);
+    EXPECT_EQ(rendered.equivalences[0], std::make_pair(std::string{"InSameLane(7)"}, std::string{"InSameLane(9)"}));
+
+    auto all = result.render_all();
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all.at(0).negative_propositions, std::vector<std::string>{"InIntersection"});
+    ASSERT_EQ(all.at(1).implications.size(), 1);
+    EXPECT_EQ(all.at(1).implications[0].first, "InFrontOf(7)");
+}
+
+TEST_F(CompactExtractionResultTest, Empty) {
+    knowledge_extraction::CompactExtractionResult empty{};
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_TRUE(empty.get_time_steps().empty());
+    EXPECT_TRUE(empty.get_records(0).empty());
+    EXPECT_TRUE(empty.render_all().empty());
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "cr_knowledge_extraction/extraction_result.hpp"
+
+#include <gtest/gtest.h>
+
+class CompactExtractionResultTest : public testing::Test {
+  protected:
+    knowledge_extraction::CompactExtractionResult result{{
+        {3, knowledge_extraction::KnowledgeKind::POSITIVE, knowledge_extraction::Proposition::IN_SAME_LANE, 7},
+        {0, knowledge_extraction::KnowledgeKind::NEGATIVE, knowledge_extraction::Proposition::IN_INTERSECTION,
+         std::nullopt},
+        {3, knowledge_extraction::KnowledgeKind::EQUIVALENCE, knowledge_extraction::Proposition::IN_SAME_LANE, 7,
+         knowledge_extraction::Proposition::IN_SAME_LANE, 9},
+        {3, knowledge_extraction::KnowledgeKind::POSITIVE, knowledge_extraction::Proposition::IN_FRONT_OF, 9},
+        {1, knowledge_extraction::KnowledgeKind::IMPLICATION, knowledge_extraction::Proposition::IN_FRONT_OF, 7,
+         knowledge_extraction::Proposition::IN_FRONT_OF, 9},
+    }};
+};
@@ -0,0 +1,112 @@
+#include "test_extraction_session.hpp"
+
+#include "cr_knowledge_extraction/extraction_session.hpp"
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+
+using knowledge_extraction::ExtractionResult;
+using knowledge_extraction::ExtractionSession;
+
+using testing::Contains;
+using testing::ElementsAre;
+using testing::HasSubstr;
+using testing::IsSupersetOf;
+using testing::Not;
+using testing::Pair;
+
+namespace {
+// The order of knowledge within a time step depends on the order in which relevant propositions were added
+std::unordered_map<time_step_t, ExtractionResult> sorted(std::unordered_map<time_step_t, ExtractionResult> results) {
+    for (auto &[_, result] : results) {
+        std::ranges::sort(result.positive_propositions);
+        std::ranges::sort(result.negative_propositions);
+        std::ranges::sort(result.implications);
+        std::ranges::sort(result.equivalences);
+    }
+    return results;
+}
+
+void expect_equal(const std::unordered_map<time_step_t, ExtractionResult> &actual,
+                  const std::unordered_map<time_step_t, ExtractionResult> &expected) {
+    auto sorted_actual = sorted(actual);
+    auto sorted_expected = sorted(expected);
+    ASSERT_EQ(sorted_actual.size(), sorted_expected.size());
+    for (const auto &[time_step, result] : sorted_expected) {
+        ASSERT_TRUE(sorted_actual.contains(time_step));
+        EXPECT_EQ(sorted_actual.at(time_step).positive_propositions, result.positive_propositions);
+        EXPECT_EQ(sorted_actual.at(time_step).negative_propositions, result.negative_propositions);
+        EXPECT_EQ(sorted_actual.at(time_step).implications, result.implications);
+        EXPECT_EQ(sorted_actual.at(time_step).equivalences, result.equivalences);
+    }
+}
+
+const std::unordered_map<time_step_t, std::vector<std::string>> first_pass{
+    {0, {"InFrontOf(100)", "InFrontOf(101)", "InSameLane(102)", "UnknownProposition"}},
+    {1, {"InFrontOf(100)", "InSameLane(102)", "InSameLane(103)"}},
+    {2, {"KeepsSafeDistancePrec(101)"}},
+};
+
+const std::unordered_map<time_step_t, std::vector<std::string>> second_pass{
+    {0, {"InFrontOf(101)", "InFrontOf(102)", "InSameLane(102)"}},
+    {1, {"InFrontOf(100)", "InSameLane(104)"}},
+    {3, {"InFrontOf(105)"}},
+};
+} // namespace
+
+TEST_F(ExtractionSessionTest, MatchesInterface) {
+    auto session = ExtractionSession{extraction_interface, first_pass};
+    auto result = session.extract_all().render_all();
+    // The ego vehicle starts at rest at the origin, obstacles 100 and 101 are more than 100m behind it
+    ASSERT_TRUE(result.contains(0));
+    EXPECT_THAT(result.at(0).negative_propositions, IsSupersetOf({"InFrontOf(100)", "InFrontOf(101)"}));
+    EXPECT_THAT(result.at(0).positive_propositions, Not(Contains(HasSubstr("InFrontOf"))));
+    EXPECT_THAT(result.at(0).implications, ElementsAre(Pair("InFrontOf(100)", "InFrontOf(101)")));
+    ASSERT_TRUE(result.contains(1));
+    EXPECT_THAT(result.at(1).negative_propositions, Contains("InFrontOf(100)"));
+    EXPECT_TRUE(result.at(1).implications.empty());
+    EXPECT_FALSE(result.contains(3));
+    expect_equal(result, extraction_interface.extract_all(first_pass));
+    expect_equal(session.extract_kleene().render_all(), extraction_interface.extract_kleene(first_pass));
+    expect_equal(session.extract_equivalences().render_all(), extraction_interface.extract_equivalences(first_pass));
+}
+
+TEST_F(ExtractionSessionTest, Update) {
+    auto session = ExtractionSession{extraction_interface, first_pass};
+    session.update(second_pass);
+    auto result = session.extract_all().render_all();
+    ASSERT_TRUE(result.contains(0));
+    EXPECT_THAT(result.at(0).negative_propositions, IsSupersetOf({"InFrontOf(101)", "InFrontOf(102)"}));
+    EXPECT_THAT(result.at(0).negative_propositions, Not(Contains("InFrontOf(100)")));
+    EXPECT_THAT(result.at(0).implications, ElementsAre(Pair("InFrontOf(101)", "InFrontOf(102)")));
+    ASSERT_TRUE(result.contains(1));
+    EXPECT_THAT(result.at(1).negative_propositions, Contains("InFrontOf(100)"));
+    EXPECT_THAT(result.at(1).negative_propositions, Not(Contains(HasSubstr("102"))));
+    EXPECT_THAT(result.at(1).positive_propositions, Not(Contains(HasSubstr("102"))));
+    // All propositions of time step 2 were dropped
+    EXPECT_FALSE(result.contains(2));
+    // Obstacle 105 is more than 40m ahead of the ego vehicle, which cannot move that far within 0.3s
+    ASSERT_TRUE(result.contains(3));
+    EXPECT_THAT(result.at(3).positive_propositions, ElementsAre("InFrontOf(105)"));
+    expect_equal(result, extraction_interface.extract_all(second_pass));
+
+    session.update({});
+    EXPECT_EQ(session.extract_all().size(), 0);
+}
+
+TEST_F(ExtractionSessionTest, FollowsAdvance) {
+    auto session = ExtractionSession{extraction_interface, first_pass};
+    session.extract_all();
+
+    auto new_initial_state = State{5, 10.0, 2.0, 20.0, 0.0, 0.0};
+    extraction_interface.advance(new_initial_state);
+    EXPECT_EQ(extraction_interface.get_initial_time_step(), 5);
+
+    auto ego_params = knowledge_extraction::ego_behavior::EgoParameters{};
+    ego_params.initial_state = new_initial_state;
+    auto fresh_interface = knowledge_extraction::ExtractionInterface{
+        test_envs.interstate_simple->get_world(), test_envs.interstate_simple->get_ego_ccs(), ego_params};
+    expect_equal(session.extract_all().render_all(), fresh_interface.extract_all(first_pass));
+    expect_equal(extraction_interface.extract_all(second_pass), fresh_interface.extract_all(second_pass));
+}
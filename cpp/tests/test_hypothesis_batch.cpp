@@ -0,0 +1,50 @@
+#include "test_hypothesis_batch.hpp"
+
+using knowledge_extraction::ExtractionInterface;
+using knowledge_extraction::ExtractionResult;
+using knowledge_extraction::HypothesisBatch;
+
+namespace {
+const std::unordered_map<time_step_t, std::vector<std::string>> relevant_propositions{
+    {0, {"InFrontOf(100)", "InFrontOf(101)", "InSameLane(102)"}},
+    {1, {"InFrontOf(100)", "InSameLane(102)", "InSameLane(103)"}},
+    {4, {"KeepsSafeDistancePrec(101)", "InFrontOf(102)"}},
+};
+
+void expect_equal(const std::unordered_map<time_step_t, ExtractionResult> &actual,
+                  const std::unordered_map<time_step_t, ExtractionResult> &expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (const auto &[time_step, result] : expected) {
+        ASSERT_TRUE(actual.contains(time_step));
+        EXPECT_EQ(actual.at(time_step).positive_propositions, result.positive_propositions);
+        EXPECT_EQ(actual.at(time_step).negative_propositions, result.negative_propositions);
+        EXPECT_EQ(actual.at(time_step).implications, result.implications);
+        EXPECT_EQ(actual.at(time_step).equivalences, result.equivalences);
+    }
+}
+} // namespace
+
+TEST_F(HypothesisBatchTest, MatchesIndividualExtraction) {
+    auto hypotheses = create_hypotheses();
+    auto batch = HypothesisBatch{test_envs.interstate_simple->get_world(), hypotheses};
+    ASSERT_EQ(batch.size(), hypotheses.size());
+
+    auto results = batch.extract_all(relevant_propositions);
+    ASSERT_EQ(results.size(), hypotheses.size());
+    for (size_t i = 0; i < hypotheses.size(); ++i) {
+        auto extraction_interface = ExtractionInterface{test_envs.interstate_simple->get_world(),
+                                                        hypotheses[i].ego_ccs, hypotheses[i].ego_params};
+        expect_equal(results[i], extraction_interface.extract_all(relevant_propositions));
+    }
+}
+
+TEST_F(HypothesisBatchTest, SharesCaches) {
+    auto batch = HypothesisBatch{test_envs.interstate_simple->get_world(), create_hypotheses(), 2};
+    const auto &first = batch.get_extraction_interface(0).get_env_model();
+    for (size_t i = 1; i < batch.size(); ++i) {
+        const auto &other = batch.get_extraction_interface(i).get_env_model();
+        EXPECT_EQ(other->get_world_cache(), first->get_world_cache());
+        EXPECT_EQ(other->get_ccs_cache(), first->get_ccs_cache());
+        EXPECT_NE(other->get_ego_approximations(), first->get_ego_approximations());
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "cr_knowledge_extraction/hypothesis_batch.hpp"
+#include "test_envs/test_envs.hpp"
+
+#include <gtest/gtest.h>
+
+class HypothesisBatchTest : public testing::Test {
+  protected:
+    TestEnvironments test_envs;
+
+    std::vector<knowledge_extraction::EgoHypothesis> create_hypotheses() const {
+        auto slow = knowledge_extraction::ego_behavior::EgoParameters{};
+        slow.initial_state = State{0, 0.0, 0.0, 10.0, 0.0, 0.0};
+        auto fast = knowledge_extraction::ego_behavior::EgoParameters{};
+        fast.initial_state = State{0, 0.0, 0.0, 30.0, 0.0, 0.0};
+        return {
+            {test_envs.interstate_simple->get_ego_ccs(), slow},
+            {test_envs.interstate_simple->get_ego_ccs(), fast},
+            {test_envs.interstate_simple->get_ego_ccs(), knowledge_extraction::ego_behavior::EgoParameters{}},
+        };
+    }
+};
@@ -0,0 +1,26 @@
+#include "test_relevant_propositions.hpp"
+
+#include "cr_knowledge_extraction/relevant_propositions.hpp"
+
+#include <gmock/gmock.h>
+
+using knowledge_extraction::Proposition;
+
+using testing::UnorderedElementsAre;
+
+TEST_F(RelevantPropositionsTest, UsesFormulaTimeSteps) {
+    // All obstacles of interstate_simple exist from time step 0 to 40
+    auto relevant_propositions = knowledge_extraction::make_relevant_propositions(
+        *test_envs.interstate_simple->get_world(), {Proposition::ON_MAIN_CARRIAGEWAY, Proposition::IN_FRONT_OF}, 38, 5);
+    ASSERT_EQ(relevant_propositions.size(), 5);
+    for (time_step_t time_step = 0; time_step < 3; ++time_step) {
+        ASSERT_TRUE(relevant_propositions.contains(time_step));
+        EXPECT_THAT(relevant_propositions.at(time_step),
+                    UnorderedElementsAre("OnMainCarriageway", "InFrontOf(100)", "InFrontOf(101)", "InFrontOf(102)",
+                                         "InFrontOf(103)", "InFrontOf(104)", "InFrontOf(105)"));
+    }
+    for (time_step_t time_step = 3; time_step < 5; ++time_step) {
+        ASSERT_TRUE(relevant_propositions.contains(time_step));
+        EXPECT_THAT(relevant_propositions.at(time_step), UnorderedElementsAre("OnMainCarriageway"));
+    }
+}
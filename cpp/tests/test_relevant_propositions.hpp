@@ -0,0 +1,10 @@
+#pragma once
+
+#include "test_envs/test_envs.hpp"
+
+#include <gtest/gtest.h>
+
+class RelevantPropositionsTest : public testing::Test {
+  protected:
+    TestEnvironments test_envs;
+};
@@ -0,0 +1,98 @@
+#include "test_scenario_generator.hpp"
+
+#include "cr_knowledge_extraction/extraction_interface.hpp"
+
+#include <commonroad_cpp/obstacle/obstacle.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using knowledge_extraction::ExtractionInterface;
+using knowledge_extraction::scenario_generator::generate_commonroad_xml;
+using knowledge_extraction::scenario_generator::generate_scenario;
+using knowledge_extraction::scenario_generator::RoadLayout;
+
+namespace {
+size_t count_occurrences(const std::string &str, const std::string &pattern) {
+    size_t count = 0;
+    for (auto pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+} // namespace
+
+TEST_F(ScenarioGeneratorTest, Deterministic) {
+    EXPECT_EQ(generate_commonroad_xml(params), generate_commonroad_xml(params));
+
+    auto other_params = params;
+    other_params.seed = 1;
+    EXPECT_NE(generate_commonroad_xml(params), generate_commonroad_xml(other_params));
+}
+
+TEST_F(ScenarioGeneratorTest, Highway) {
+    auto xml = generate_commonroad_xml(params);
+    EXPECT_EQ(count_occurrences(xml, "<lanelet id="), params.num_lanes * params.num_segments);
+    EXPECT_EQ(count_occurrences(xml, "<dynamicObstacle id="), params.num_obstacles);
+    EXPECT_EQ(count_occurrences(xml, "accessRamp"), 0);
+
+    auto scenario = generate_scenario(params);
+    EXPECT_EQ(scenario.world->getRoadNetwork()->getLaneletNetwork().size(), params.num_lanes * params.num_segments);
+    ASSERT_EQ(scenario.world->getObstacles().size(), params.num_obstacles);
+    for (const auto &obstacle : scenario.world->getObstacles()) {
+        EXPECT_TRUE(obstacle->timeStepExists(0));
+    }
+}
+
+TEST_F(ScenarioGeneratorTest, OnRamp) {
+    params.layout = RoadLayout::ON_RAMP;
+    auto xml = generate_commonroad_xml(params);
+    // A single ramp along the first two segments
+    EXPECT_EQ(count_occurrences(xml, "<lanelet id="), (params.num_lanes * params.num_segments) + 2);
+    EXPECT_EQ(count_occurrences(xml, "accessRamp"), 2);
+}
+
+TEST_F(ScenarioGeneratorTest, Intersections) {
+    params.layout = RoadLayout::INTERSECTIONS;
+    auto xml = generate_commonroad_xml(params);
+    EXPECT_EQ(count_occurrences(xml, "<intersection id="), params.num_segments);
+    EXPECT_EQ(count_occurrences(xml, "<incoming id="), 4 * params.num_segments);
+    EXPECT_EQ(count_occurrences(xml, "<trafficSign id="), 4 * params.num_segments);
+    // The intersections in the middle have a stop line on both side roads
+    EXPECT_EQ(count_occurrences(xml, "<stopLine>"), 2);
+
+    // Two lanelets per arm, the arms between intersections are shared, and three turning lanelets per incoming
+    auto num_lanelets = (2 * ((3 * params.num_segments) + 1)) + (12 * params.num_segments);
+    auto scenario = generate_scenario(params);
+    EXPECT_EQ(scenario.world->getRoadNetwork()->getLaneletNetwork().size(), num_lanelets);
+}
+
+TEST_F(ScenarioGeneratorTest, Extraction) {
+    for (auto layout : {RoadLayout::HIGHWAY, RoadLayout::ON_RAMP, RoadLayout::INTERSECTIONS}) {
+        params.layout = layout;
+        auto scenario = generate_scenario(params);
+        ExtractionInterface extraction_interface{scenario.world, scenario.ego_ccs, scenario.ego_params};
+
+        std::vector<std::string> propositions{"OnMainCarriageway", "InIntersection"};
+        for (const auto &obstacle : scenario.world->getObstacles()) {
+            propositions.push_back("InFrontOf(" + std::to_string(obstacle->getId()) + ")");
+            propositions.push_back("InSameLane(" + std::to_string(obstacle->getId()) + ")");
+        }
+        auto result = extraction_interface.extract_all_compact({{0, propositions}});
+        EXPECT_GT(result.size(), 0);
+    }
+}
+
+TEST_F(ScenarioGeneratorTest, InvalidParameters) {
+    auto no_lanes = params;
+    no_lanes.num_lanes = 0;
+    EXPECT_THROW(generate_commonroad_xml(no_lanes), std::invalid_argument);
+
+    auto no_time_steps = params;
+    no_time_steps.num_time_steps = 0;
+    EXPECT_THROW(generate_commonroad_xml(no_time_steps), std::invalid_argument);
+
+    auto short_segments = params;
+    short_segments.segment_length = 1;
+    EXPECT_THROW(generate_scenario(short_segments), std::invalid_argument);
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "scenario_generator.hpp"
+
+#include <gtest/gtest.h>
+
+class ScenarioGeneratorTest : public testing::Test {
+  protected:
+    // Small enough that every test can load and extract the whole scenario
+    knowledge_extraction::scenario_generator::ScenarioParameters params{
+        .num_lanes = 2, .num_segments = 3, .num_obstacles = 5, .num_time_steps = 10};
+};
@@ -0,0 +1,99 @@
+#include "test_statistics.hpp"
+
+#include "cr_knowledge_extraction/statistics.hpp"
+
+#include <algorithm>
+
+using knowledge_extraction::CacheKind;
+using knowledge_extraction::ExtractionPhase;
+using knowledge_extraction::ExtractorKind;
+using knowledge_extraction::Proposition;
+using knowledge_extraction::StatisticsCollector;
+
+namespace {
+const std::unordered_map<time_step_t, std::vector<std::string>> relevant_propositions{
+    {0, {"InFrontOf(100)", "InSameLane(102)", "OnMainCarriageway"}},
+    {1, {"InFrontOf(100)", "InSameLane(103)"}},
+    {3, {"KeepsSafeDistancePrec(101)", "OnMainCarriageway"}},
+};
+} // namespace
+
+TEST_F(StatisticsTest, DisabledByDefault) {
+    EXPECT_FALSE(extraction_interface.is_statistics_enabled());
+    extraction_interface.extract_all_compact(relevant_propositions);
+
+    auto statistics = extraction_interface.get_statistics();
+    EXPECT_TRUE(statistics.extractors.empty());
+    EXPECT_TRUE(statistics.phases.empty());
+    EXPECT_EQ(statistics.num_overlapping_lanelet_queries, 0);
+    EXPECT_EQ(statistics.num_lane_constructions, 0);
+    for (const auto &cache : statistics.caches) {
+        EXPECT_EQ(cache.hits + cache.misses, 0);
+    }
+}
+
+TEST_F(StatisticsTest, CollectsExtractionStatistics) {
+    extraction_interface.set_statistics_enabled(true);
+    auto result = extraction_interface.extract_all_compact(relevant_propositions);
+    auto statistics = extraction_interface.get_statistics();
+
+    auto in_front_of = std::ranges::find_if(statistics.extractors, [](const auto &extractor) {
+        return extractor.kind == ExtractorKind::KLEENE && extractor.proposition == Proposition::IN_FRONT_OF;
+    });
+    ASSERT_NE(in_front_of, statistics.extractors.end());
+    EXPECT_GT(in_front_of->num_calls, 0);
+    EXPECT_GT(in_front_of->creation_time, 0);
+
+    // Every piece of knowledge is attributed to exactly one extractor and one phase
+    size_t extractor_decided = 0;
+    for (const auto &extractor : statistics.extractors) {
+        extractor_decided += extractor.num_decided;
+    }
+    size_t phase_decided = 0;
+    for (const auto &phase : statistics.phases) {
+        phase_decided += phase.num_decided;
+    }
+    EXPECT_EQ(extractor_decided, result.size());
+    EXPECT_EQ(phase_decided, result.size());
+    EXPECT_TRUE(std::ranges::any_of(statistics.phases,
+                                    [](const auto &phase) { return phase.phase == ExtractionPhase::KLEENE; }));
+    EXPECT_GT(statistics.num_overlapping_lanelet_queries, 0);
+
+    extraction_interface.reset_statistics();
+    EXPECT_TRUE(extraction_interface.get_statistics().extractors.empty());
+}
+
+TEST_F(StatisticsTest, CountsCacheHits) {
+    extraction_interface.set_statistics_enabled(true);
+    extraction_interface.extract_all_compact(relevant_propositions);
+    extraction_interface.reset_statistics();
+
+    // The caches are filled by the first extraction, so the second one does not query the lanelets again
+    extraction_interface.extract_all_compact(relevant_propositions);
+    auto statistics = extraction_interface.get_statistics();
+    EXPECT_EQ(statistics.num_overlapping_lanelet_queries, 0);
+    EXPECT_EQ(statistics.num_lane_constructions, 0);
+    EXPECT_TRUE(std::ranges::any_of(statistics.caches, [](const auto &cache) { return cache.hits > 0; }));
+}
+
+TEST(StatisticsCollectorTest, IgnoresRecordsWhileDisabled) {
+    StatisticsCollector collector;
+    collector.record_cache_access(CacheKind::PRIORITY, false);
+    EXPECT_FALSE(collector.start_timer().has_value());
+
+    collector.set_enabled(true);
+    collector.record_cache_access(CacheKind::PRIORITY, false);
+    collector.record_cache_access(CacheKind::PRIORITY, true);
+    collector.record_extraction(ExtractorKind::KLEENE, Proposition::CUT_IN, collector.start_timer(), 3);
+
+    auto statistics = collector.get_statistics();
+    auto priority =
+        std::ranges::find(statistics.caches, CacheKind::PRIORITY, &knowledge_extraction::CacheStatistics::cache);
+    ASSERT_NE(priority, statistics.caches.end());
+    EXPECT_EQ(priority->hits, 1);
+    EXPECT_EQ(priority->misses, 1);
+    ASSERT_EQ(statistics.extractors.size(), 1);
+    EXPECT_EQ(statistics.extractors.front().proposition, Proposition::CUT_IN);
+    EXPECT_EQ(statistics.extractors.front().num_calls, 1);
+    EXPECT_EQ(statistics.extractors.front().num_decided, 3);
+}
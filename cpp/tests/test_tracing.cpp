@@ -0,0 +1,31 @@
+#include "test_tracing.hpp"
+
+#include "cr_knowledge_extraction/tracing.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace tracing = knowledge_extraction::tracing;
+
+TEST_F(TracingTest, WritesTraceEvents) {
+    auto path = std::filesystem::temp_directory_path() / "cr_knowledge_extraction_trace.json";
+
+    tracing::start();
+    EXPECT_EQ(tracing::is_active(), tracing::is_available());
+    extraction_interface.extract_all_compact({{0, {"InFrontOf(100)", "OnMainCarriageway"}}});
+    if (!tracing::is_available()) {
+        GTEST_SKIP() << "Tracing support is not compiled in";
+    }
+    tracing::stop(path.string());
+    EXPECT_FALSE(tracing::is_active());
+
+    std::ifstream file{path};
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_NE(content.str().find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(content.str().find("ExtractionInterface::extract_kleene"), std::string::npos);
+    EXPECT_NE(content.str().find("KleeneExtractor::extract"), std::string::npos);
+    EXPECT_NE(content.str().find("InFrontOf"), std::string::npos);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "cr_knowledge_extraction/extraction_interface.hpp"
+#include "test_envs/test_envs.hpp"
+
+#include <gtest/gtest.h>
+
+class TracingTest : public testing::Test {
+  protected:
+    TestEnvironments test_envs;
+    knowledge_extraction::ExtractionInterface extraction_interface{test_envs.interstate_simple->get_world(),
+                                                                   test_envs.interstate_simple->get_ego_ccs(),
+                                                                   knowledge_extraction::ego_behavior::EgoParameters{}};
+};
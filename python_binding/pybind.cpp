@@ -1,6 +1,13 @@
 #include "pybind.hpp"
 
+#include "cr_knowledge_extraction/anytime.hpp"
+#include "cr_knowledge_extraction/env_model/cache_file.hpp"
+#include "cr_knowledge_extraction/env_model/shared_world_cache.hpp"
 #include "cr_knowledge_extraction/extraction_interface.hpp"
+#include "cr_knowledge_extraction/extraction_session.hpp"
+#include "cr_knowledge_extraction/hypothesis_batch.hpp"
+#include "cr_knowledge_extraction/statistics.hpp"
+#include "cr_knowledge_extraction/tracing.hpp"
 
 #include <nanobind/eigen/dense.h>
 #include <nanobind/stl/optional.h>
@@ -11,6 +18,8 @@
 #include <nanobind/stl/unordered_map.h>
 #include <nanobind/stl/vector.h>
 
+#include <chrono>
+
 using knowledge_extraction::Proposition;
 using knowledge_extraction::ego_behavior::EgoParameters;
 
@@ -18,6 +27,18 @@ namespace nb = nanobind;
 using namespace nb::literals;
 
 namespace {
+knowledge_extraction::parallel::Budget
+make_budget(std::optional<double> timeout,
+            std::shared_ptr<knowledge_extraction::parallel::CancellationToken> cancellation_token) {
+    std::optional<knowledge_extraction::parallel::Budget::Clock::time_point> deadline;
+    if (timeout.has_value()) {
+        deadline = knowledge_extraction::parallel::Budget::Clock::now() +
+                   std::chrono::duration_cast<knowledge_extraction::parallel::Budget::Clock::duration>(
+                       std::chrono::duration<double>{timeout.value()});
+    }
+    return knowledge_extraction::parallel::Budget{deadline, std::move(cancellation_token)};
+}
+
 std::optional<nb::module_> try_import(const char *name) {
     try {
         return nb::module_::import_(name);
@@ -43,7 +64,12 @@ NB_MODULE(knowledge_extraction_core, module) {
     export_propositions(module);
     export_ego_parameters(module);
     export_extraction_result(module);
+    export_anytime(module);
+    export_statistics(module);
+    export_tracing(module);
     export_extraction_interface(module);
+    export_extraction_session(module);
+    export_hypothesis_batch(module);
 }
 
 void export_extraction_result(const nb::module_ &module) {
@@ -52,13 +78,177 @@ void export_extraction_result(const nb::module_ &module) {
         .def_ro("negative_propositions", &knowledge_extraction::ExtractionResult::negative_propositions)
         .def_ro("implications", &knowledge_extraction::ExtractionResult::implications)
         .def_ro("equivalences", &knowledge_extraction::ExtractionResult::equivalences);
+
+    nb::enum_<knowledge_extraction::KnowledgeKind>(module, "KnowledgeKind")
+        .value("POSITIVE", knowledge_extraction::KnowledgeKind::POSITIVE)
+        .value("NEGATIVE", knowledge_extraction::KnowledgeKind::NEGATIVE)
+        .value("IMPLICATION", knowledge_extraction::KnowledgeKind::IMPLICATION)
+        .value("EQUIVALENCE", knowledge_extraction::KnowledgeKind::EQUIVALENCE);
+
+    nb::class_<knowledge_extraction::KnowledgeRecord>(module, "KnowledgeRecord")
+        .def_ro("time_step", &knowledge_extraction::KnowledgeRecord::time_step)
+        .def_ro("kind", &knowledge_extraction::KnowledgeRecord::kind)
+        .def_ro("lhs", &knowledge_extraction::KnowledgeRecord::lhs)
+        .def_ro("lhs_parameter", &knowledge_extraction::KnowledgeRecord::lhs_parameter)
+        .def_ro("rhs", &knowledge_extraction::KnowledgeRecord::rhs)
+        .def_ro("rhs_parameter", &knowledge_extraction::KnowledgeRecord::rhs_parameter);
+
+    nb::class_<knowledge_extraction::CompactExtractionResult>(module, "CompactExtractionResult")
+        .def("__len__", &knowledge_extraction::CompactExtractionResult::size)
+        .def("get_time_steps", &knowledge_extraction::CompactExtractionResult::get_time_steps)
+        .def(
+            "get_records",
+            [](const knowledge_extraction::CompactExtractionResult &result, time_step_t time_step) {
+                auto records = result.get_records(time_step);
+                return std::vector<knowledge_extraction::KnowledgeRecord>{records.begin(), records.end()};
+            },
+            "time_step"_a)
+        .def("render", &knowledge_extraction::CompactExtractionResult::render, "time_step"_a)
+        .def("render_all", &knowledge_extraction::CompactExtractionResult::render_all);
+}
+
+void export_anytime(const nb::module_ &module) {
+    nb::class_<knowledge_extraction::parallel::CancellationToken>(module, "CancellationToken")
+        .def(nb::init<>())
+        .def("cancel", &knowledge_extraction::parallel::CancellationToken::cancel)
+        .def_prop_ro("is_cancelled", &knowledge_extraction::parallel::CancellationToken::is_cancelled);
+
+    nb::enum_<knowledge_extraction::ExtractorKind>(module, "ExtractorKind")
+        .value("KLEENE", knowledge_extraction::ExtractorKind::KLEENE)
+        .value("RELATIONSHIP", knowledge_extraction::ExtractorKind::RELATIONSHIP);
+
+    nb::class_<knowledge_extraction::SkippedWork>(module, "SkippedWork")
+        .def_ro("kind", &knowledge_extraction::SkippedWork::kind)
+        .def_ro("proposition", &knowledge_extraction::SkippedWork::proposition)
+        .def_ro("time_step", &knowledge_extraction::SkippedWork::time_step);
+
+    nb::class_<knowledge_extraction::AnytimeReport>(module, "AnytimeReport")
+        .def_ro("complete", &knowledge_extraction::AnytimeReport::complete)
+        .def_ro("num_completed", &knowledge_extraction::AnytimeReport::num_completed)
+        .def_ro("skipped", &knowledge_extraction::AnytimeReport::skipped);
+
+    nb::class_<knowledge_extraction::AnytimeExtractionResult>(module, "AnytimeExtractionResult")
+        .def_ro("knowledge", &knowledge_extraction::AnytimeExtractionResult::knowledge)
+        .def_ro("report", &knowledge_extraction::AnytimeExtractionResult::report);
+}
+
+void export_statistics(const nb::module_ &module) {
+    nb::enum_<knowledge_extraction::CacheKind>(module, "CacheKind")
+        .value("OBSTACLE_LANE_IDS", knowledge_extraction::CacheKind::OBSTACLE_LANE_IDS)
+        .value("TURNING_DIRECTIONS", knowledge_extraction::CacheKind::TURNING_DIRECTIONS)
+        .value("PRIORITY", knowledge_extraction::CacheKind::PRIORITY)
+        .value("OBSTACLE_REAR", knowledge_extraction::CacheKind::OBSTACLE_REAR)
+        .value("STOPPING_S", knowledge_extraction::CacheKind::STOPPING_S)
+        .value("REFERENCE_LANE", knowledge_extraction::CacheKind::REFERENCE_LANE);
+
+    nb::enum_<knowledge_extraction::ExtractionPhase>(module, "ExtractionPhase")
+        .value("PRECOMPUTATION", knowledge_extraction::ExtractionPhase::PRECOMPUTATION)
+        .value("KLEENE", knowledge_extraction::ExtractionPhase::KLEENE)
+        .value("RELATIONSHIP", knowledge_extraction::ExtractionPhase::RELATIONSHIP)
+        .value("ANYTIME", knowledge_extraction::ExtractionPhase::ANYTIME);
+
+    nb::class_<knowledge_extraction::ExtractorStatistics>(module, "ExtractorStatistics")
+        .def_ro("kind", &knowledge_extraction::ExtractorStatistics::kind)
+        .def_ro("proposition", &knowledge_extraction::ExtractorStatistics::proposition)
+        .def_ro("num_calls", &knowledge_extraction::ExtractorStatistics::num_calls)
+        .def_ro("creation_time", &knowledge_extraction::ExtractorStatistics::creation_time)
+        .def_ro("extraction_time", &knowledge_extraction::ExtractorStatistics::extraction_time)
+        .def_ro("num_decided", &knowledge_extraction::ExtractorStatistics::num_decided);
+
+    nb::class_<knowledge_extraction::CacheStatistics>(module, "CacheStatistics")
+        .def_ro("cache", &knowledge_extraction::CacheStatistics::cache)
+        .def_ro("hits", &knowledge_extraction::CacheStatistics::hits)
+        .def_ro("misses", &knowledge_extraction::CacheStatistics::misses);
+
+    nb::class_<knowledge_extraction::PhaseStatistics>(module, "PhaseStatistics")
+        .def_ro("phase", &knowledge_extraction::PhaseStatistics::phase)
+        .def_ro("num_runs", &knowledge_extraction::PhaseStatistics::num_runs)
+        .def_ro("wall_time", &knowledge_extraction::PhaseStatistics::wall_time)
+        .def_ro("num_decided", &knowledge_extraction::PhaseStatistics::num_decided);
+
+    nb::class_<knowledge_extraction::ExtractionStatistics>(module, "ExtractionStatistics")
+        .def_ro("extractors", &knowledge_extraction::ExtractionStatistics::extractors)
+        .def_ro("caches", &knowledge_extraction::ExtractionStatistics::caches)
+        .def_ro("phases", &knowledge_extraction::ExtractionStatistics::phases)
+        .def_ro("num_overlapping_lanelet_queries",
+                &knowledge_extraction::ExtractionStatistics::num_overlapping_lanelet_queries)
+        .def_ro("num_lane_constructions", &knowledge_extraction::ExtractionStatistics::num_lane_constructions);
+}
+
+void export_tracing(nb::module_ &module) {
+    module.def("tracing_available", &knowledge_extraction::tracing::is_available);
+    module.def("start_tracing", &knowledge_extraction::tracing::start);
+    module.def("stop_tracing", &knowledge_extraction::tracing::stop, "path"_a);
 }
 
 void export_extraction_interface(const nb::module_ &module) {
+    nb::class_<knowledge_extraction::env_model::SharedWorldCache>(module, "SharedWorldCache")
+        .def_prop_ro("name", &knowledge_extraction::env_model::SharedWorldCache::get_name)
+        .def_prop_ro("scenario_hash", &knowledge_extraction::env_model::SharedWorldCache::get_scenario_hash);
+
     nb::class_<knowledge_extraction::ExtractionInterface>(module, "ExtractionInterface")
-        .def(nb::init<std::shared_ptr<World>, std::shared_ptr<geometry::CurvilinearCoordinateSystem>, EgoParameters>(),
-             "world"_a, "ego_ccs"_a, "ego_params"_a)
+        .def(nb::init<std::shared_ptr<World>, std::shared_ptr<geometry::CurvilinearCoordinateSystem>, EgoParameters,
+                      size_t>(),
+             "world"_a, "ego_ccs"_a, "ego_params"_a, "num_threads"_a = 1)
+        .def(
+            "advance",
+            [](knowledge_extraction::ExtractionInterface &self,
+               const std::tuple<time_step_t, double, double, double, double, double> &new_initial_state) {
+                auto [time_step, p_x, p_y, v, acc, phi] = new_initial_state;
+                self.advance(State{time_step, p_x, p_y, v, acc, phi});
+            },
+            "new_initial_state"_a)
+        .def_prop_ro("initial_time_step", &knowledge_extraction::ExtractionInterface::get_initial_time_step)
+        .def_prop_rw("statistics_enabled", &knowledge_extraction::ExtractionInterface::is_statistics_enabled,
+                     &knowledge_extraction::ExtractionInterface::set_statistics_enabled)
+        .def("get_statistics", &knowledge_extraction::ExtractionInterface::get_statistics)
+        .def("reset_statistics", &knowledge_extraction::ExtractionInterface::reset_statistics)
+        .def_static(
+            "hash_scenario_file",
+            [](const std::string &path) { return knowledge_extraction::env_model::hash_file(path); }, "path"_a)
+        .def(
+            "save_world_cache",
+            [](const knowledge_extraction::ExtractionInterface &self, const std::string &path, uint64_t scenario_hash) {
+                self.get_env_model()->get_world_cache()->save(path, scenario_hash);
+            },
+            "path"_a, "scenario_hash"_a)
+        .def(
+            "load_world_cache",
+            [](const knowledge_extraction::ExtractionInterface &self, const std::string &path, uint64_t scenario_hash) {
+                return self.get_env_model()->get_world_cache()->load(path, scenario_hash);
+            },
+            "path"_a, "scenario_hash"_a)
+        .def("precompute_world_cache",
+             [](const knowledge_extraction::ExtractionInterface &self) {
+                 nb::gil_scoped_release release;
+                 self.get_env_model()->get_world_cache()->precompute();
+             })
+        .def(
+            "publish_world_cache",
+            [](const knowledge_extraction::ExtractionInterface &self, const std::string &name, uint64_t scenario_hash) {
+                return self.get_env_model()->get_world_cache()->publish(name, scenario_hash);
+            },
+            "name"_a, "scenario_hash"_a)
+        .def(
+            "attach_world_cache",
+            [](const knowledge_extraction::ExtractionInterface &self, const std::string &name, uint64_t scenario_hash) {
+                auto shared_cache = knowledge_extraction::env_model::SharedWorldCache::open(name);
+                return self.get_env_model()->get_world_cache()->attach(std::move(shared_cache), scenario_hash);
+            },
+            "name"_a, "scenario_hash"_a)
         .def("extract_all", &knowledge_extraction::ExtractionInterface::extract_all)
+        .def(
+            "extract_all_anytime",
+            [](knowledge_extraction::ExtractionInterface &self,
+               const std::unordered_map<time_step_t, std::vector<std::string>> &relevant_propositions,
+               std::optional<double> timeout,
+               std::shared_ptr<knowledge_extraction::parallel::CancellationToken> cancellation_token) {
+                auto budget = make_budget(timeout, std::move(cancellation_token));
+                // Release the GIL so that other Python threads can cancel the extraction
+                nb::gil_scoped_release release;
+                return self.extract_all_anytime(relevant_propositions, budget);
+            },
+            "relevant_propositions"_a, "timeout"_a = nb::none(), "cancellation_token"_a = nb::none())
         .def("extract_all_but_implications", &knowledge_extraction::ExtractionInterface::extract_all_but_implications)
         .def("extract_kleene", nb::overload_cast<const std::unordered_map<time_step_t, std::vector<std::string>> &>(
                                    &knowledge_extraction::ExtractionInterface::extract_kleene))
@@ -66,7 +256,55 @@ void export_extraction_interface(const nb::module_ &module) {
              nb::overload_cast<const std::unordered_map<time_step_t, std::vector<std::string>> &>(
                  &knowledge_extraction::ExtractionInterface::extract_relationships))
         .def("extract_equivalences", &knowledge_extraction::ExtractionInterface::extract_equivalences)
-        .def("extract_implications", &knowledge_extraction::ExtractionInterface::extract_implications);
+        .def("extract_implications", &knowledge_extraction::ExtractionInterface::extract_implications)
+        .def("extract_all_compact", &knowledge_extraction::ExtractionInterface::extract_all_compact)
+        .def("extract_all_but_implications_compact",
+             &knowledge_extraction::ExtractionInterface::extract_all_but_implications_compact)
+        .def("extract_kleene_compact", &knowledge_extraction::ExtractionInterface::extract_kleene_compact)
+        .def("extract_relationships_compact", &knowledge_extraction::ExtractionInterface::extract_relationships_compact)
+        .def("extract_equivalences_compact", &knowledge_extraction::ExtractionInterface::extract_equivalences_compact)
+        .def("extract_implications_compact", &knowledge_extraction::ExtractionInterface::extract_implications_compact);
+}
+
+void export_extraction_session(const nb::module_ &module) {
+    nb::class_<knowledge_extraction::ExtractionSession>(module, "ExtractionSession")
+        .def(nb::init<knowledge_extraction::ExtractionInterface &,
+                      const std::unordered_map<time_step_t, std::vector<std::string>> &>(),
+             "extraction_interface"_a, "relevant_propositions"_a, nb::keep_alive<1, 2>())
+        .def("update", &knowledge_extraction::ExtractionSession::update, "relevant_propositions"_a)
+        .def("extract_all", &knowledge_extraction::ExtractionSession::extract_all)
+        .def(
+            "extract_all_anytime",
+            [](knowledge_extraction::ExtractionSession &self, std::optional<double> timeout,
+               std::shared_ptr<knowledge_extraction::parallel::CancellationToken> cancellation_token) {
+                auto budget = make_budget(timeout, std::move(cancellation_token));
+                nb::gil_scoped_release release;
+                return self.extract_all_anytime(budget);
+            },
+            "timeout"_a = nb::none(), "cancellation_token"_a = nb::none())
+        .def("extract_all_but_implications", &knowledge_extraction::ExtractionSession::extract_all_but_implications)
+        .def("extract_kleene", &knowledge_extraction::ExtractionSession::extract_kleene)
+        .def("extract_relationships", &knowledge_extraction::ExtractionSession::extract_relationships)
+        .def("extract_equivalences", &knowledge_extraction::ExtractionSession::extract_equivalences)
+        .def("extract_implications", &knowledge_extraction::ExtractionSession::extract_implications);
+}
+
+void export_hypothesis_batch(const nb::module_ &module) {
+    nb::class_<knowledge_extraction::EgoHypothesis>(module, "EgoHypothesis")
+        .def(nb::init<std::shared_ptr<geometry::CurvilinearCoordinateSystem>, EgoParameters>(), "ego_ccs"_a,
+             "ego_params"_a)
+        .def_rw("ego_ccs", &knowledge_extraction::EgoHypothesis::ego_ccs)
+        .def_rw("ego_params", &knowledge_extraction::EgoHypothesis::ego_params);
+
+    nb::class_<knowledge_extraction::HypothesisBatch>(module, "HypothesisBatch")
+        .def(nb::init<std::shared_ptr<World>, const std::vector<knowledge_extraction::EgoHypothesis> &, size_t>(),
+             "world"_a, "hypotheses"_a, "num_threads"_a = 1)
+        .def("__len__", &knowledge_extraction::HypothesisBatch::size)
+        .def("get_extraction_interface", &knowledge_extraction::HypothesisBatch::get_extraction_interface,
+             "hypothesis"_a, nb::rv_policy::reference_internal)
+        .def("extract_all", &knowledge_extraction::HypothesisBatch::extract_all, "relevant_propositions"_a)
+        .def("extract_all_compact", &knowledge_extraction::HypothesisBatch::extract_all_compact,
+             "relevant_propositions"_a);
 }
 
 void export_propositions(const nb::module_ &module) {
@@ -8,4 +8,14 @@ void export_ego_parameters(const nanobind::module_ &module);
 
 void export_extraction_result(const nanobind::module_ &module);
 
+void export_anytime(const nanobind::module_ &module);
+
+void export_statistics(const nanobind::module_ &module);
+
+void export_tracing(nanobind::module_ &module);
+
 void export_extraction_interface(const nanobind::module_ &module);
+
+void export_extraction_session(const nanobind::module_ &module);
+
+void export_hypothesis_batch(const nanobind::module_ &module);
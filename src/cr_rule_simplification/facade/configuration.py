@@ -52,3 +52,7 @@ class Configuration:
     r"""Initial uncertainty in the longitudinal velocity of the ego vehicle in $\frac{m}{s}$."""
     uncertainty_v_lat: float = 0.01
     r"""Initial uncertainty in the lateral velocity of the ego vehicle in $\frac{m}{s}$."""
+
+    # Knowledge extraction parameters
+    num_threads: int = 1
+    """Number of threads used for knowledge extraction (0 uses one thread per core)."""
@@ -1,4 +1,4 @@
-from typing import Dict
+from typing import Dict, Optional, Tuple
 
 import crcpp
 from commonroad_clcs import pycrccosy
@@ -11,17 +11,92 @@ class KnowledgeExtractor:
     """A class for extracting knowledge from a scenario using the C++ knowledge extraction interface."""
 
     _cpp_extractor: core.ExtractionInterface
+    _session: Optional[core.ExtractionSession]
 
     def __init__(
-        self, world: crcpp.World, ccs: pycrccosy.CurvilinearCoordinateSystem, ego_params: core.EgoParameters
+        self,
+        world: crcpp.World,
+        ccs: pycrccosy.CurvilinearCoordinateSystem,
+        ego_params: core.EgoParameters,
+        num_threads: int = 1,
+        collect_statistics: bool = False,
     ) -> None:
         """Create a new KnowledgeExtractor.
 
         :param world: The C++ world object corresponding to the CommonRoad scenario.
         :param ccs: The curvilinear coordinate system.
         :param ego_params: The configuration parameters of the ego vehicle.
+        :param num_threads: The number of threads used for extraction (0 uses one thread per core).
+        :param collect_statistics: Whether to collect runtime statistics of the extraction.
         """
-        self._cpp_extractor = core.ExtractionInterface(world, ccs, ego_params)
+        self._cpp_extractor = core.ExtractionInterface(world, ccs, ego_params, num_threads)
+        self._cpp_extractor.statistics_enabled = collect_statistics
+        self._session = None
+
+    def get_statistics(self, reset: bool = False) -> core.ExtractionStatistics:
+        """Get the runtime statistics of the extraction.
+
+        Statistics are only collected if enabled on creation.
+
+        :param reset: Whether to reset the statistics afterwards, so the next call only covers later extractions.
+        :return: The statistics per extractor, cache, and phase.
+        """
+        statistics = self._cpp_extractor.get_statistics()
+        if reset:
+            self._cpp_extractor.reset_statistics()
+        return statistics
+
+    def load_world_cache(self, path: str, scenario_hash: int) -> bool:
+        """Load the ego-independent results of earlier processes on the same scenario, e.g. turning directions.
+
+        :param path: The path of the cache file.
+        :param scenario_hash: The hash of the scenario file, see core.ExtractionInterface.hash_scenario_file.
+        :return: Whether results were loaded, False if the file is missing, corrupt, or of another scenario.
+        """
+        return self._cpp_extractor.load_world_cache(path, scenario_hash)
+
+    def save_world_cache(self, path: str, scenario_hash: int) -> None:
+        """Save the ego-independent results computed so far, so that later processes can load them.
+
+        :param path: The path of the cache file.
+        :param scenario_hash: The hash of the scenario file, see core.ExtractionInterface.hash_scenario_file.
+        """
+        self._cpp_extractor.save_world_cache(path, scenario_hash)
+
+    def publish_world_cache(self, name: str, scenario_hash: int, precompute: bool = True) -> core.SharedWorldCache:
+        """Publish the ego-independent results in shared memory for worker processes on the same scenario.
+
+        Workers attach with attach_world_cache, so that they neither recompute nor copy these results.
+
+        :param name: The name of the shared memory segment, must not contain slashes.
+        :param scenario_hash: The hash of the scenario file, see core.ExtractionInterface.hash_scenario_file.
+        :param precompute: Whether to compute the results for all obstacles and time steps before publishing.
+        :return: The segment, which is removed once the returned object is garbage collected.
+        """
+        if precompute:
+            self._cpp_extractor.precompute_world_cache()
+        return self._cpp_extractor.publish_world_cache(name, scenario_hash)
+
+    def attach_world_cache(self, name: str, scenario_hash: int) -> bool:
+        """Look up ego-independent results in a shared memory segment published by another process.
+
+        Must be called before the first extraction.
+
+        :param name: The name of the shared memory segment.
+        :param scenario_hash: The hash of the scenario file, see core.ExtractionInterface.hash_scenario_file.
+        :return: Whether the segment is used, False if it belongs to another scenario.
+        """
+        return self._cpp_extractor.attach_world_cache(name, scenario_hash)
+
+    def advance(self, initial_state: Tuple[int, float, float, float, float, float]) -> None:
+        """Move the ego vehicle to a new initial state for the next planning cycle.
+
+        Knowledge that does not depend on the ego vehicle stays cached, so replanning on the same world only recomputes
+        the behavior approximation of the ego vehicle.
+
+        :param initial_state: The new initial state as (time_step, x, y, velocity, acceleration, orientation).
+        """
+        self._cpp_extractor.advance(initial_state)
 
     def extract_kleene(self, formula: Formula, planning_horizon: int) -> KnowledgeSequence:
         """Extract Kleene knowledge from the scenario.
@@ -32,8 +107,7 @@ class KnowledgeExtractor:
         :param planning_horizon: The planning horizon.
         :return: The extracted Kleene knowledge.
         """
-        relevant_aps = formula.relevant_aps(planning_horizon)
-        extraction_results = self._cpp_extractor.extract_kleene(relevant_aps)
+        extraction_results = self._update_session(formula, planning_horizon).extract_kleene().render_all()
         return self._convert_extraction_results_to_knowledge_sequence(extraction_results)
 
     def extract_relationships(self, formula: Formula, planning_horizon: int) -> KnowledgeSequence:
@@ -45,10 +119,65 @@ class KnowledgeExtractor:
         :param planning_horizon: The planning horizon.
         :return: The extracted relationship knowledge.
         """
-        relevant_aps = formula.relevant_aps(planning_horizon)
-        extraction_results = self._cpp_extractor.extract_relationships(relevant_aps)
+        extraction_results = self._update_session(formula, planning_horizon).extract_relationships().render_all()
         return self._convert_extraction_results_to_knowledge_sequence(extraction_results)
 
+    def extract_all_anytime(
+        self,
+        formula: Formula,
+        planning_horizon: int,
+        timeout: Optional[float] = None,
+        cancellation_token: Optional[core.CancellationToken] = None,
+    ) -> Tuple[KnowledgeSequence, core.AnytimeReport]:
+        """Extract as much Kleene and relationship knowledge as possible within a time budget.
+
+        Cheap extractors and near time steps are extracted first. The knowledge is sound but may be incomplete if the
+        budget runs out, the report lists the skipped work.
+
+        :param formula: The formula for which to extract knowledge.
+        :param planning_horizon: The planning horizon.
+        :param timeout: The available time in seconds or None for no time limit.
+        :param cancellation_token: A token to cancel the extraction from another thread.
+        :return: The extracted knowledge and the report of the extraction.
+        """
+        result = self._update_session(formula, planning_horizon).extract_all_anytime(timeout, cancellation_token)
+        return self._convert_extraction_results_to_knowledge_sequence(result.knowledge.render_all()), result.report
+
+    def extract_kleene_compact(self, formula: Formula, planning_horizon: int) -> core.CompactExtractionResult:
+        """Extract Kleene knowledge from the scenario without converting it to strings.
+
+        :param formula: The formula for which to extract knowledge.
+        :param planning_horizon: The planning horizon.
+        :return: The extracted Kleene knowledge as records of propositions and obstacle IDs.
+        """
+        return self._update_session(formula, planning_horizon).extract_kleene()
+
+    def extract_relationships_compact(self, formula: Formula, planning_horizon: int) -> core.CompactExtractionResult:
+        """Extract relationship knowledge from the scenario without converting it to strings.
+
+        :param formula: The formula for which to extract knowledge.
+        :param planning_horizon: The planning horizon.
+        :return: The extracted relationship knowledge as records of propositions and obstacle IDs.
+        """
+        return self._update_session(formula, planning_horizon).extract_relationships()
+
+    def _update_session(self, formula: Formula, planning_horizon: int) -> core.ExtractionSession:
+        """Make the relevant propositions of the formula the relevant propositions of the extraction session.
+
+        The session is kept across calls, so propositions that were already relevant for the previous formula are not
+        parsed again.
+
+        :param formula: The formula for which to extract knowledge.
+        :param planning_horizon: The planning horizon.
+        :return: The updated session.
+        """
+        relevant_aps = formula.relevant_aps(planning_horizon)
+        if self._session is None:
+            self._session = core.ExtractionSession(self._cpp_extractor, relevant_aps)
+        else:
+            self._session.update(relevant_aps)
+        return self._session
+
     @staticmethod
     def _convert_extraction_results_to_knowledge_sequence(
         extraction_results: Dict[int, core.ExtractionResult],
@@ -1,4 +1,4 @@
-from typing import Iterable, List
+from typing import Iterable, List, Tuple
 
 import crcpp
 from commonroad_clcs import pycrccosy
@@ -14,15 +14,27 @@ class TrafficRuleSimplifier:
     _knowledge_extractor: KnowledgeExtractor
 
     def __init__(
-        self, world: crcpp.World, ccs: pycrccosy.CurvilinearCoordinateSystem, ego_params: core.EgoParameters
+        self,
+        world: crcpp.World,
+        ccs: pycrccosy.CurvilinearCoordinateSystem,
+        ego_params: core.EgoParameters,
+        num_threads: int = 1,
     ) -> None:
         """Create a new TrafficRuleSimplifier.
 
         :param world: The C++ world object corresponding to the CommonRoad scenario.
         :param ccs: The curvilinear coordinate system.
         :param ego_params: The configuration parameters of the ego vehicle.
+        :param num_threads: The number of threads used for knowledge extraction (0 uses one thread per core).
         """
-        self._knowledge_extractor = KnowledgeExtractor(world, ccs, ego_params)
+        self._knowledge_extractor = KnowledgeExtractor(world, ccs, ego_params, num_threads)
+
+    def advance(self, initial_state: Tuple[int, float, float, float, float, float]) -> None:
+        """Move the ego vehicle to a new initial state for the next planning cycle on the same world.
+
+        :param initial_state: The new initial state as (time_step, x, y, velocity, acceleration, orientation).
+        """
+        self._knowledge_extractor.advance(initial_state)
 
     def simplify(self, rules: Iterable[Formula], planning_horizon: int) -> List[Formula]:
         """Simplify a set of traffic rules.